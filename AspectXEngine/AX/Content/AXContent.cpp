@@ -8,7 +8,7 @@
 #include "AX/IO/AXDirectory.h"
 #include "Importers/AXContentImporter.h"
 
-AXString AXSystem< AXContent >::sSystemName = "Content";
+template<> AXName AXSystem< AXContent >::sSystemName = "Content";
 
 /**
 * Initialise the system, called after settings are loaded
@@ -47,7 +47,7 @@ void AXContent::OnShutdown( )
 /**
 * Attempts to find and return a content manager by name, returns null if it cannot be found
 */
-const AXContentManagerBase* AXContent::FindContentManagerByType( const std::string& name ) const
+const AXContentManagerBase* AXContent::FindContentManagerByType( const AXName& name ) const
 {
 	auto it( mContentManagers.find( name ) );
 
@@ -64,9 +64,17 @@ const AXContentManagerBase* AXContent::FindContentManagerByType( const std::stri
 */
 const AXContentManagerBase* AXContent::FindContentManagerByExtension( const std::string& ext ) const
 {
-	for( auto it : mContentManagers )
+	// Extensions come from arbitrary paths, so look them up without interning, an unknown extension can't be supported
+	const AXName extName( AXName::Find( ext ) );
+
+	if( !extName )
+	{
+		return nullptr;
+	}
+
+	for( auto& it : mContentManagers )
 	{
-		if( it.second->IsExtentionSupported( ext ) )
+		if( it.second->IsExtentionSupported( extName ) )
 		{
 			return it.second;
 		}
@@ -94,7 +102,7 @@ AXAssetHandleBase AXContent::RequestAssetLoad( const std::string& name ) const
 */
 void AXContent::CreateEngineSettings( class AXSettingsFile& settings )
 {
-	mSettings = settings.RegisterNewItem< AXContent::Settings >( AXContent::StaticName( ) );
+	mSettings = settings.RegisterNewItem< AXContent::Settings >( AXContent::StaticName( ).GetString( ) );
 }
 
 /**
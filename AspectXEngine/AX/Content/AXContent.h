@@ -66,7 +66,7 @@ public:
 	/**
 	 * Attempts to find and return a content manager by name, returns null if it cannot be found
 	 */
-	const AXContentManagerBase* FindContentManagerByType( const std::string& name ) const;
+	const AXContentManagerBase* FindContentManagerByType( const AXName& name ) const;
 
 	/**
 	* Attempts to find and return a content manager by supported extension, returns null if it cannot be found
@@ -117,7 +117,7 @@ private:
 	/**
 	 * The content managers currently registered
 	 */
-	std::map< AXString, AXContentManagerBase* > mContentManagers;
+	std::unordered_map< AXName, AXContentManagerBase* > mContentManagers;
 
 	/**
 	 * A settings file for storing content settings in
@@ -148,9 +148,10 @@ void AXContent::RegisterContentManager( )
 
 	if( mContentManagers.find( T::Name( ) ) == mContentManagers.end( ) )
 	{
-		mContentManagers[T::Name( )] = new T( );
-		mContentManagers[T::Name( )]->CreateSettings( mContentSettingsFile );
+		AXContentManagerBase* newManager( new T( ) );
+		mContentManagers[T::Name( )] = newManager;
+		newManager->CreateSettings( mContentSettingsFile );
 
-		AXLOG( "Content", "Registering content manager: %s.", T::Name( ) );
+		AXLOG( "Content", "Registering content manager: %s.", T::Name( ).c_str( ) );
 	}
 }
\ No newline at end of file
@@ -5,16 +5,18 @@
 #include "AX/Utils/AXParent.h"
 #include "AX/Utils/AXBaseObject.h"
 #include "AX/Core/AXLogging.h"
+#include "AX/Core/AXPerfCounters.h"
 #include "AX/IO/AXFile.h"
 
 #include "AX/Utils/AXString.h"
+#include "AX/Utils/AXName.h"
 
 class AXContentImporterBase : public AXParent< AXBaseObject, AXContentImporterBase >
 {
 public:
-	AXContentImporterBase( const AXString& supportedExtention ) : mSupportedExtention( supportedExtention ) { }
+	AXContentImporterBase( const AXName& supportedExtention ) : mSupportedExtention( supportedExtention ) { }
 
-	const AXString& GetSupportedExtention( ) const { return mSupportedExtention; }
+	const AXName& GetSupportedExtention( ) const { return mSupportedExtention; }
 
 	/**
 	 * Call to import the asset specified by path, returns a valid pointer on success or nullptr on fail
@@ -32,7 +34,7 @@ public:
 	virtual AXSettingsFile::SettingsItem* GetSettings( ) { return nullptr; }
 
 private:
-	AXString mSupportedExtention;
+	AXName mSupportedExtention;
 };
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -47,7 +49,7 @@ public:
 	using OutputType = TOutputType;
 
 public:
-	AXContentImporter( ) : AXParent( sSupportedExtention ) {  }
+	AXContentImporter( ) : AXParent< AXContentImporterBase, AXContentImporter< TOutputType > >( sSupportedExtention ) {  }
 
 	/**
 	* Call to import the asset specified by path, returns a valid pointer on success or nullptr on fail
@@ -57,7 +59,7 @@ public:
 		// Validate the asset extension
 		AXString ext( AXFile::GetExtention( assetPath ) );
 
-		if( ext != sSupportedExtention )
+		if( AXName::Find( ext ) != sSupportedExtention )
 		{
 			AXWARN( "Content", "Failed import of file %s. Invalid extention.", ext.c_str() );
 			return nullptr;
@@ -76,7 +78,7 @@ public:
 
 		AXFile::InternalFileBuffer& fileBuffer( file.ReadFileToInternalBuffer( ) );
 
-		if( fileBuffer.mBufferSize <= 0 || !fileBuffer.mBuffer )
+		if( fileBuffer.Size( ) <= 0 || !fileBuffer )
 		{
 			AXWARN( "Content", "Failed import of file %s. Failed to read file contents.", assetPath.c_str( ) );
 			return nullptr;
@@ -90,10 +92,12 @@ public:
 			return nullptr;
 		}
 
+		AXPERF_COUNT( "Content/Assets Loaded", 1 );
+
 		return ret;
 	}
 
-	static const AXString& StaticGetSupportedExtention( ) { return sSupportedExtention; }
+	static const AXName& StaticGetSupportedExtention( ) { return sSupportedExtention; }
 
 protected:
 	/**
@@ -102,5 +106,5 @@ protected:
 	virtual OutputType* ImportAsset( const AXFile::InternalFileBuffer& fileBuffer ) = 0;
 
 protected:
-	static AXString sSupportedExtention;
+	static AXName sSupportedExtention;
 };
\ No newline at end of file
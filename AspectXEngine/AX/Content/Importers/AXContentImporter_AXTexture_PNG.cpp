@@ -3,7 +3,7 @@
 #include "AXContentImporter_AXTexture_PNG.h"
 #include "AXContentImporter.h"
 
-AXString AXContentImporter< AXTexture >::sSupportedExtention = "PNG";
+template<> AXName AXContentImporter< AXTexture >::sSupportedExtention = "PNG";
 
 /**
 * Derived types should implement this function
@@ -18,7 +18,7 @@ AXTexture* AXContentImporter_AXTexture_PNG::ImportAsset( const AXFile::InternalF
 */
 void AXContentImporter_AXTexture_PNG::CreateSettings( class AXSettingsFile& settings )
 {
-	mSettings = settings.RegisterNewItem< AXContentImporter_AXTexture_PNG::Settings >( sSupportedExtention );
+	mSettings = settings.RegisterNewItem< AXContentImporter_AXTexture_PNG::Settings >( sSupportedExtention.GetString( ) );
 }
 
 /**
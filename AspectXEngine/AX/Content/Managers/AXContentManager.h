@@ -7,22 +7,26 @@
 #include "AX/Core/AXLogging.h"
 
 #include "AX/Utils/AXString.h"
-#include <map>
+#include "AX/Utils/AXName.h"
+#include <unordered_map>
+
+template< class TOutputType >
+class AXContentImporter;
 
 class AXContentManagerBase : public AXParent< AXBaseObject, AXContentManagerBase >
 {
 public:
-	AXContentManagerBase( const AXString& name ) : mName( name ) { }
+	AXContentManagerBase( const AXName& name ) : mName( name ) { }
 
 	/**
 	 * Returns true if this content manager can handle the given extention
 	 */
-	bool IsExtentionSupported( const AXString& ext ) { return ( mContentImporters.find( ext ) != mContentImporters.end( ) ); }
+	bool IsExtentionSupported( const AXName& ext ) const { return ( mContentImporters.find( ext ) != mContentImporters.end( ) ); }
 
 	/**
 	 * Return the name of this manager
 	 */
-	const AXString& GetName( ) const { return mName; }
+	const AXName& GetName( ) const { return mName; }
 
 	/**
 	* Override to register a settings object for this manager
@@ -49,12 +53,12 @@ protected:
 	/**
 	 * The name of this content manager
 	 */
-	AXString mName;
+	AXName mName;
 
 	/**
 	 * Holds all the extentions this content manager can support
 	 */
-	std::map< AXString, class AXContentImporterBase* > mContentImporters;
+	std::unordered_map< AXName, class AXContentImporterBase* > mContentImporters;
 };
 
 template< class TAssetType >
@@ -72,21 +76,21 @@ public:
 	template< class TImporter >
 	void RegisterContentImporter( )
 	{
-		static_assert( std::is_base_of< class AXContentImporter< TAssetType >, TImporter >::value, "TImporter must be an importer that supports TAssetType" );
+		static_assert( std::is_base_of< AXContentImporter< TAssetType >, TImporter >::value, "TImporter must be an importer that supports TAssetType" );
 
-		if( IsExtentionSupported( TImporter::StaticGetSupportedExtention( ) ) )
+		if( this->IsExtentionSupported( TImporter::StaticGetSupportedExtention( ) ) )
 		{
 			AXERROR( "Content", "Attempting to register importer for an extention type that already has a registered importer." );
 			return;
 		}
 
 		TImporter* newImporter( new TImporter( ) );
-		InitialiseNewImporter( *newImporter );
-		mContentImporters[TImporter::StaticGetSupportedExtention( )] = newImporter;
+		this->InitialiseNewImporter( *newImporter );
+		this->mContentImporters[TImporter::StaticGetSupportedExtention( )] = newImporter;
 	}
 
-	static const AXString& Name( ) { return sContentManagerName; }
+	static const AXName& Name( ) { return sContentManagerName; }
 
 private:
-	static AXString sContentManagerName;
+	static AXName sContentManagerName;
 };
\ No newline at end of file
@@ -3,7 +3,7 @@
 #include "AXContentManager_Textures.h"
 #include "AX/Content/Importers/AXContentImporter_AXTexture_PNG.h"
 
-AXString AXContentManager< AXTexture >::sContentManagerName = "Textures";
+template<> AXName AXContentManager< AXTexture >::sContentManagerName = "Textures";
 
 /**
 * Constructor
@@ -18,5 +18,5 @@ AXContentManager_Textures::AXContentManager_Textures()
 */
 void AXContentManager_Textures::CreateSettings( class AXSettingsFile& settings )
 {
-	mSettings = settings.RegisterNewItem< AXContentManager_Textures::Settings >( GetName() );
+	mSettings = settings.RegisterNewItem< AXContentManager_Textures::Settings >( GetName( ).GetString( ) );
 }
\ No newline at end of file
@@ -2,11 +2,14 @@
 
 #pragma once
 
-#include <d3d11.h>
-
 #include "AX/Utils/AXParent.h"
 #include "AX/Content/AXAsset.h"
 
+/**
+ * The raw type is only used to tag the asset, so it is declared here rather than pulling D3D into everything that uses textures
+ */
+struct ID3D11Texture2D;
+
 class AXTexture : public AXParent< AXAsset< ID3D11Texture2D >, AXTexture >
 {
 public:
@@ -1,20 +1,81 @@
 // Copyright 2016 Scott Bevin, All Rights Reserved
 
 #include "AXApplication.h"
-#include "AXWindow.h"
 #include "AXLogging.h"
 #include "AXSettings.h"
-#include "AX/Graphics/RenderCore/AXRenderCore.h"
+#include "AXMemoryTracking.h"
+#include "AXLogConsole.h"
+#include "AXProfiler.h"
+#include "AXFrameTimings.h"
+#include "AXPerfCounters.h"
+#include "AXUpdateables.h"
 #include "AX/Graphics/UI/ImGui/AXImGui.h"
 #include "AX/Content/AXContent.h"
-#include "AX/Editor/AXEditor.h"
+#include "AX/IO/AXFile.h"
 #include "AX/Core/Threads/AXThreading.h"
 #include "AX/Core/Threads/AXThreadedTasks.h"
+#include "AX/Utils/AXFrameAllocator.h"
+
+#if defined( AXPLATFORM_WINDOWS )
+#include "AXWindow.h"
+#include "AX/Graphics/RenderCore/AXRenderCore.h"
+#include "AX/Editor/AXEditor.h"
+#endif // #if defined( AXPLATFORM_WINDOWS )
 
 #include <iterator>
 #include <vector>
 #include <chrono>
 #include <thread>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+namespace
+{
+	using FrameClock = std::chrono::high_resolution_clock;
+
+	/**
+	* Calls func on every system for one phase of the frame through the scheduler, rebuilding it first if the systems changed.
+	* Systems that declare themselves thread safe run on the task threads when tasks is set. Each system and the phase as a whole
+	* are timed, and hardware counters are read around each system while they are enabled
+	*/
+	void RunFramePhase( AXSystemScheduler& scheduler, const std::vector< AXSystemBase* >& systems, AXThreadedTasks* tasks, AXFrameTimings* frameTimings, AXFrameTimings::Phase::E phase, const AXSystemScheduler::SystemFunc& func )
+	{
+		AXPROFILE_SCOPE_COUNTERS( AXFrameTimings::Phase::ToString( phase ).c_str( ) );
+
+		if( scheduler.NeedsBuild( systems ) )
+		{
+			scheduler.Build( systems );
+		}
+
+		const bool readCounters( frameTimings && AXHardwareCounters::IsEnabled( ) );
+
+		const FrameClock::time_point phaseStartTime( FrameClock::now( ) );
+
+		scheduler.Run( tasks, func, readCounters );
+
+		const FrameClock::time_point phaseEndTime( FrameClock::now( ) );
+
+		if( frameTimings )
+		{
+			// Systems may have run on different threads, so the phase counters are the sum of the systems' counters
+			AXHardwareCounters::Values phaseCounters;
+			bool hasCounters( readCounters );
+
+			for( uint32_t i( 0 ); i < scheduler.NumSystems( ); ++i )
+			{
+				const AXSystemScheduler::SystemRun& run( scheduler.GetSystemRun( i ) );
+
+				frameTimings->AddSystemTime( phase, i, scheduler.GetSystem( i ).GetName( ), run.mMs, run.mHasCounters ? &run.mCounters : nullptr );
+
+				phaseCounters += run.mCounters;
+				hasCounters = hasCounters && run.mHasCounters;
+			}
+
+			frameTimings->AddPhaseTime( phase, std::chrono::duration< float, std::milli >( phaseEndTime - phaseStartTime ).count( ), hasCounters ? &phaseCounters : nullptr );
+		}
+	}
+}
 
 /**
 * Constructor
@@ -41,6 +102,18 @@ void AXApplication::RunEngine( const SetupParams& prams )
 	if( Startup( prams ) )
 	{
 		RunEngineLoop( );
+
+		if( !mSetupParams.mReportPath.empty( ) )
+		{
+			if( WriteReport( mSetupParams.mReportPath.c_str( ) ) )
+			{
+				AXLOG( "Application", "Wrote report to %s", mSetupParams.mReportPath.c_str( ) );
+			}
+			else
+			{
+				AXERROR( "Application", "Failed to write report to %s", mSetupParams.mReportPath.c_str( ) );
+			}
+		}
 	}
 
 	Shutdown( );
@@ -53,6 +126,14 @@ bool AXApplication::Startup( const SetupParams& prams )
 {
 	AXLOG( "Application", "Starting up engine" );
 
+	mSetupParams = prams;
+	ReadSetupParamsFromCommandLine( mSetupParams );
+
+	if( mSetupParams.mHeadless )
+	{
+		AXLOG( "Application", "Running headless" );
+	}
+
 	CreateDefaultSystems( );
 
 	LoadSettings( );
@@ -81,33 +162,32 @@ void AXApplication::RunEngineLoop( )
 {
 	AXLOG( "Application", "Starting engine loop" );
 
-	Settings& appSettings( GetSettings( ) );
+	AXFrameTimings* frameTimings( AXFrameTimings::GetFrom( *this ) );
+	AXProfiler* profiler( AXProfiler::GetFrom( *this ) );
 	
 	std::chrono::duration<double, std::milli> frameDeltaTime( 0 );
 
+	const FrameClock::time_point loopStartTime( FrameClock::now( ) );
+
 	do 
 	{
+		AXHardwareCounters::Values frameStartCounters;
+		const bool readCounters( frameTimings && AXHardwareCounters::IsEnabled( ) && AXHardwareCounters::Read( frameStartCounters ) );
+
 		auto frameStartTime( std::chrono::high_resolution_clock::now( ) );
 		float dt( ( float )frameDeltaTime.count( ) * 0.001f );
 
-		for( auto it : GetSystems( ) )
 		{
-			it->BeginFrame( );
-		}
+			AXPROFILE_SCOPE_COUNTERS( "Frame" );
 
-		for( auto it : GetSystems( ) )
-		{
-			it->Update( dt );
-		}
+			AXThreadedTasks* tasks( GetSystemTasks( ) );
 
-		for( auto it : GetSystems( ) )
-		{
-			it->Render( );
-		}
+			RunFramePhase( mScheduler, GetSystems( ), tasks, frameTimings, AXFrameTimings::Phase::BeginFrame, [ ]( AXSystemBase& system ) { system.BeginFrame( ); } );
+			RunFramePhase( mScheduler, GetSystems( ), tasks, frameTimings, AXFrameTimings::Phase::Update, [ dt ]( AXSystemBase& system ) { system.Update( dt ); } );
+			RunFramePhase( mScheduler, GetSystems( ), tasks, frameTimings, AXFrameTimings::Phase::Render, [ ]( AXSystemBase& system ) { system.Render( ); } );
+			RunFramePhase( mScheduler, GetSystems( ), tasks, frameTimings, AXFrameTimings::Phase::EndFrame, [ ]( AXSystemBase& system ) { system.EndFrame( ); } );
 
-		for( auto it : GetSystems( ) )
-		{
-			it->EndFrame( );
+			AXFrameAllocator::EndFrame( );
 		}
 
 		//////////////////////////////////////////////////////////////////////////
@@ -117,22 +197,55 @@ void AXApplication::RunEngineLoop( )
 		
 		frameDeltaTime = frameEndTime - frameStartTime;
 
- 		if( appSettings.mMaxFPS > 0 )
+		if( frameTimings )
+		{
+			AXHardwareCounters::Values frameEndCounters;
+
+			if( readCounters && AXHardwareCounters::Read( frameEndCounters ) )
+			{
+				const AXHardwareCounters::Values frameCounters( frameEndCounters - frameStartCounters );
+				frameTimings->AddFrameTime( ( float )frameDeltaTime.count( ), &frameCounters );
+			}
+			else
+			{
+				frameTimings->AddFrameTime( ( float )frameDeltaTime.count( ) );
+			}
+		}
+
+		// Hitches are judged on the frame's work, a frame cap's sleep would make every frame look long
+		if( profiler )
+		{
+			profiler->AddFrameTime( ( float )frameDeltaTime.count( ) );
+		}
+
+ 		const uint32_t maxFPS( GetMaxFPS( ) );
+
+ 		if( maxFPS > 0 )
  		{
- 			std::chrono::duration<double, std::milli>  minFrameTime( 1000.0f / ( double )appSettings.mMaxFPS );
+ 			std::chrono::duration<double, std::milli>  minFrameTime( 1000.0f / ( double )maxFPS );
  
 			if( minFrameTime > frameDeltaTime )
  			{
 				minFrameTime -= frameDeltaTime;
 
+				AXPROFILE_SCOPE( "Frame Cap" );
 				std::this_thread::sleep_for( std::chrono::milliseconds( (long long)minFrameTime.count() ) );
  				frameDeltaTime = minFrameTime;
  			}
  		}
 
+		++mFrameCount;
+
+		if( mSetupParams.mMaxFrames > 0 && mFrameCount >= mSetupParams.mMaxFrames )
+		{
+			Quit( );
+		}
+
 	} while ( !mQuitEngine );
 
-	AXLOG( "Application", "Finished engine loop" );
+	mLoopSeconds = std::chrono::duration< double >( FrameClock::now( ) - loopStartTime ).count( );
+
+	AXLOG( "Application", "Finished engine loop after %u frames", mFrameCount );
 }
 
 /**
@@ -143,6 +256,9 @@ void AXApplication::Shutdown( )
 	AXLOG( "Application", "Shutting down engine" );
 
 	ShutdownAllSystems( );
+
+	// Nothing should read files from here on, hand the idle file buffers back rather than holding them until exit
+	AXFile::GetBufferPool( ).Trim( );
 }
 
 
@@ -165,6 +281,8 @@ void AXApplication::LoadSettings( )
 		}
 
 		settings->GetEngineSettingsFile( ).Load( );
+
+		AXFrameAllocator::SetBlockSize( ( size_t )mAppSettings->mFrameScratchSizeKB.Val( ) * 1024 );
 	}
 	else
 	{
@@ -188,6 +306,121 @@ void AXApplication::HandleCommandLine( const AXString& commandLine )
 	}
 }
 
+/**
+* Applies the setup switches found on the command line to params
+*/
+void AXApplication::ReadSetupParamsFromCommandLine( SetupParams& params ) const
+{
+	std::vector<AXString> args;
+	AXUtils::SplitString( params.mCommandLine, ' ', args );
+
+	for( const AXString& arg : args )
+	{
+		if( arg == "-headless" )
+		{
+			params.mHeadless = true;
+		}
+		else if( arg.compare( 0, 8, "-frames=" ) == 0 )
+		{
+			params.mMaxFrames = ( uint32_t )strtoul( arg.c_str( ) + 8, nullptr, 10 );
+		}
+		else if( arg.compare( 0, 5, "-fps=" ) == 0 )
+		{
+			params.mFixedFPS = ( int32_t )strtol( arg.c_str( ) + 5, nullptr, 10 );
+		}
+		else if( arg.compare( 0, 8, "-report=" ) == 0 )
+		{
+			params.mReportPath = arg.substr( 8 );
+		}
+		else if( arg == "-serialsystems" )
+		{
+			params.mSerialSystems = true;
+		}
+	}
+}
+
+/**
+* Returns the tasks system thread safe systems should run on, nullptr to run every system on the main thread
+*/
+AXThreadedTasks* AXApplication::GetSystemTasks( )
+{
+	if( mSetupParams.mSerialSystems || !mAppSettings || !mAppSettings->mParallelSystems.Val( ) )
+	{
+		return nullptr;
+	}
+
+	AXThreadedTasks* tasks( AXThreadedTasks::GetFrom( *this ) );
+	return tasks && tasks->GetState( ) == AXSystemBase::State::Initialized ? tasks : nullptr;
+}
+
+/**
+* Returns the frame rate cap, 0 being uncapped
+*/
+uint32_t AXApplication::GetMaxFPS( ) const
+{
+	if( mSetupParams.mFixedFPS >= 0 )
+	{
+		return ( uint32_t )mSetupParams.mFixedFPS;
+	}
+
+	return mAppSettings ? mAppSettings->mMaxFPS.Val( ) : 0;
+}
+
+/**
+* Writes frame timings and perf counters to a JSON file, returns false on failure
+*/
+bool AXApplication::WriteReport( const char* path )
+{
+	cJSON* jsonRoot( cJSON_CreateObject( ) );
+
+	if( !jsonRoot )
+	{
+		return false;
+	}
+
+	cJSON_AddStringToObject( jsonRoot, "application", mAppSettings ? mAppSettings->mApplicationName->c_str( ) : "" );
+	cJSON_AddBoolToObject( jsonRoot, "headless", mSetupParams.mHeadless );
+	cJSON_AddNumberToObject( jsonRoot, "max_fps", GetMaxFPS( ) );
+	cJSON_AddNumberToObject( jsonRoot, "frames", mFrameCount );
+	cJSON_AddNumberToObject( jsonRoot, "seconds", mLoopSeconds );
+	cJSON_AddBoolToObject( jsonRoot, "hardware_counters", AXHardwareCounters::IsEnabled( ) );
+
+	if( AXFrameTimings* frameTimings = AXFrameTimings::GetFrom( *this ) )
+	{
+		if( cJSON* timingsRoot = cJSON_CreateObject( ) )
+		{
+			cJSON_AddItemToObject( jsonRoot, "frame_timings", timingsRoot );
+			frameTimings->WriteToJSON( *timingsRoot );
+		}
+	}
+
+	if( AXPerfCounters* perfCounters = AXPerfCounters::GetFrom( *this ) )
+	{
+		// Picks up whatever was counted during the last frame
+		perfCounters->TakeSnapshot( );
+		perfCounters->WriteToJSON( *jsonRoot );
+	}
+
+	bool succeeded( false );
+
+	if( char* buffer = cJSON_Print( jsonRoot ) )
+	{
+		if( FILE* file = AXUtils::OpenFile( path, "w" ) )
+		{
+			const size_t length( strlen( buffer ) );
+			succeeded = fwrite( buffer, 1, length, file ) == length;
+
+			fclose( file );
+		}
+
+		free( buffer );
+	}
+
+	cJSON_Delete( jsonRoot );
+
+	return succeeded;
+}
+
 /**
 * Goes through all systems and intiializes them
 */
@@ -253,11 +486,29 @@ void AXApplication::CreateDefaultSystems( )
 	mUpdatablesSystem = CreateSystem< AXUpdateables >( );
 
 	CreateSystem< AXSettings >( );
-	CreateSystem< AXWindow >( );
-	CreateSystem< AXRenderCore >( );
-	CreateSystem< AXImGui >( );
+
+	// Headless runs have nothing to present to, so skip everything that needs a display
+	if( !IsHeadless( ) )
+	{
+#if defined( AXPLATFORM_WINDOWS )
+		CreateSystem< AXWindow >( );
+		CreateSystem< AXRenderCore >( );
+#endif // #if defined( AXPLATFORM_WINDOWS )
+		CreateSystem< AXImGui >( );
+	}
+
+	CreateSystem< AXMemoryTracking >( );
+	CreateSystem< AXProfiler >( );
+	CreateSystem< AXFrameTimings >( );
+	CreateSystem< AXPerfCounters >( );
+	CreateSystem< AXLogConsole >( );
 	CreateSystem< AXContent >( );
-	CreateSystem< AXEditor >( );
+#if defined( AXPLATFORM_WINDOWS )
+	if( !IsHeadless( ) )
+	{
+		CreateSystem< AXEditor >( );
+	}
+#endif // #if defined( AXPLATFORM_WINDOWS )
 	CreateSystem< AXThreading >( );
 	CreateSystem< AXThreadedTasks >( );
 }
\ No newline at end of file
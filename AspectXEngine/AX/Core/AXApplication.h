@@ -5,6 +5,7 @@
 #include "AX/Utils/AXSingleton.h"
 #include "AX/Utils/AXUtils.h"
 #include "AX/Core/AXSystem.h"
+#include "AX/Core/AXSystemScheduler.h"
 #include "AXSettings.h"
 #include "AX/Utils/AXParent.h"
 
@@ -16,6 +17,32 @@ public:
 	struct SetupParams
 	{
 		AXString mCommandLine;
+
+		/**
+		 * Runs without a window, renderer or ImGui, for machines with no display or GPU. Also set by -headless
+		 */
+		bool mHeadless = false;
+
+		/**
+		 * Quits once this many frames have run, 0 runs until Quit is called. Also set by -frames=N
+		 */
+		uint32_t mMaxFrames = 0;
+
+		/**
+		 * Overrides the MaxFps setting when 0 or above, 0 being uncapped. Also set by -fps=N
+		 */
+		int32_t mFixedFPS = -1;
+
+		/**
+		 * Where a JSON report of frame timings and perf counters is written when the engine loop ends, empty for none.
+		 * Also set by -report=path
+		 */
+		AXString mReportPath;
+
+		/**
+		 * Runs every system on the main thread in creation order, ignoring what they declare. Also set by -serialsystems
+		 */
+		bool mSerialSystems = false;
 	};
 
 	class Settings : public AXParent< AXSettingsFile::SettingsItem, Settings >
@@ -26,6 +53,10 @@ public:
 			RegisterProperty( mApplicationName, "Name" );
 
 			RegisterProperty( mMaxFPS, "MaxFps" ).DisplayAsDropDown( { { 0, "Uncapped" }, { 10, "10 fps" }, { 30, "30 fps" }, { 60, "60fps" } } );
+
+			RegisterProperty( mFrameScratchSizeKB, "FrameScratchSizeKB" );
+
+			RegisterProperty( mParallelSystems, "ParallelSystems" );
 		}
 
 	public:
@@ -38,6 +69,16 @@ public:
 		 * The maximum frame rate the application will run at.
 		 */
 		AXProperty< uint8_t > mMaxFPS = 60;			// 0 = Uncapped
+
+		/**
+		 * Size of each thread's per frame scratch memory, grows automatically if a frame overflows it
+		 */
+		AXProperty< uint32_t > mFrameScratchSizeKB = 256;
+
+		/**
+		 * Runs systems that declare themselves thread safe on the task threads, alongside the main thread
+		 */
+		AXProperty< bool > mParallelSystems = true;
 	};
 
 public:
@@ -67,6 +108,21 @@ public:
 	 */
 	Settings& GetSettings( ) { return AXUtils::AssertPtrReturnRef( mAppSettings ); }
 
+	/**
+	 * Returns true if the engine is running without a window, renderer or ImGui
+	 */
+	bool IsHeadless( ) const { return mSetupParams.mHeadless; }
+
+	/**
+	 * Returns the frame rate cap, 0 being uncapped
+	 */
+	uint32_t GetMaxFPS( ) const;
+
+	/**
+	 * Returns the number of frames that have finished
+	 */
+	uint32_t GetFrameCount( ) const { return mFrameCount; }
+
 private:
 	/**
 		* Initializes the engine
@@ -93,6 +149,21 @@ private:
 	 */
 	void HandleCommandLine( const AXString& commandLine );
 
+	/**
+	 * Applies the setup switches found on the command line to params
+	 */
+	void ReadSetupParamsFromCommandLine( SetupParams& params ) const;
+
+	/**
+	 * Returns the tasks system thread safe systems should run on, nullptr to run every system on the main thread
+	 */
+	class AXThreadedTasks* GetSystemTasks( );
+
+	/**
+	 * Writes frame timings and perf counters to a JSON file, returns false on failure
+	 */
+	bool WriteReport( const char* path );
+
 	/**
 	 * Goes through all systems and intiializes them
 	 */
@@ -117,11 +188,27 @@ private:
 	*/
 	bool mQuitEngine = false;
 
+	/**
+	 * The params the engine was started with, after applying the command line
+	 */
+	SetupParams mSetupParams;
+
+	/**
+	 * Frames run so far and how long the engine loop ran for
+	 */
+	uint32_t mFrameCount = 0;
+	double mLoopSeconds = 0.0;
+
 	/**
 	 * Local pointer to the application settings
 	 */
 	Settings* mAppSettings = nullptr;
 
+	/**
+	 * Orders each phase of the frame across the main thread and task threads from what the systems declare
+	 */
+	AXSystemScheduler mScheduler;
+
 	/**
 	 * Maintain a pointer to the update ables system so we can tell it to update
 	 */
@@ -0,0 +1,201 @@
+// Copyright 2016 Scott Bevin, All Rights Reserved
+
+#include "AXBinaryLog.h"
+
+#include <stdio.h>
+
+namespace
+{
+	/**
+	* Appends a single conversion formatted with snprintf
+	*/
+	template< class T >
+	void AppendFormatted( AXString& out, const char* spec, T val )
+	{
+		char buffer[256];
+		const int length( snprintf( buffer, sizeof( buffer ), spec, val ) );
+
+		if( length < 0 )
+		{
+			return;
+		}
+
+		if( ( size_t )length < sizeof( buffer ) )
+		{
+			out.append( buffer, ( size_t )length );
+		}
+		else
+		{
+			const size_t start( out.size( ) );
+			out.resize( start + length + 1 );
+			snprintf( &out[start], length + 1, spec, val );
+			out.resize( start + length );
+		}
+	}
+
+	/**
+	* Writes the length modifier and conversion to the end of a spec
+	*/
+	void SetConversion( char* specTail, const char* conversion ) { memcpy( specTail, conversion, strlen( conversion ) + 1 ); }
+	void SetConversion( char* specTail, char conversion ) { specTail[0] = conversion; specTail[1] = '\0'; }
+
+	bool IsIntegerConversion( char conversion ) { return strchr( "diouxXc", conversion ) != nullptr; }
+	bool IsFloatConversion( char conversion ) { return strchr( "fFeEgGaA", conversion ) != nullptr; }
+}
+
+/**
+* Formats fmt with arguments written by Encode. Each conversion is formatted on its own with the type taken from the
+* encoded argument, so mismatched length modifiers are harmless. Returns false if the arguments ran out or a conversion
+* wasn't understood, out still holds everything formatted up to that point
+*/
+bool AXBinaryLog::FormatMessage( const char* fmt, const uint8_t* args, size_t argsSize, AXString& out )
+{
+	out.clear( );
+
+	const uint8_t* argsEnd( args + argsSize );
+	const char* pos( fmt );
+
+	while( *pos )
+	{
+		const char* nextSpec( strchr( pos, '%' ) );
+
+		if( !nextSpec )
+		{
+			out.append( pos );
+			break;
+		}
+
+		out.append( pos, nextSpec - pos );
+
+		if( nextSpec[1] == '%' )
+		{
+			out.push_back( '%' );
+			pos = nextSpec + 2;
+			continue;
+		}
+
+		// Flags, width and precision are kept, length modifiers are replaced to match the encoded type
+		const char* specEnd( nextSpec + 1 );
+		while( *specEnd && strchr( "-+ #0", *specEnd ) ) { ++specEnd; }
+		while( *specEnd >= '0' && *specEnd <= '9' ) { ++specEnd; }
+
+		if( *specEnd == '.' )
+		{
+			++specEnd;
+			while( *specEnd >= '0' && *specEnd <= '9' ) { ++specEnd; }
+		}
+
+		const char* conversionPos( specEnd );
+		while( *conversionPos && strchr( "hljztL", *conversionPos ) ) { ++conversionPos; }
+
+		const char conversion( *conversionPos );
+		const size_t flagsLength( specEnd - nextSpec );
+
+		if( !conversion || !strchr( "diouxXcfFeEgGaAsp", conversion ) || flagsLength > 24 || args >= argsEnd )
+		{
+			out.append( nextSpec );
+			return false;
+		}
+
+		char spec[32];
+		memcpy( spec, nextSpec, flagsLength );
+		char* specTail( spec + flagsLength );
+
+		const ArgType type( ( ArgType )( *args & 0x0f ) );
+		const uint8_t width( *args >> 4 );
+		++args;
+
+		if( type == ArgType::String )
+		{
+			uint32_t length( 0 );
+
+			if( argsEnd - args < 4 )
+			{
+				return false;
+			}
+
+			memcpy( &length, args, 4 );
+			args += 4;
+
+			if( ( size_t )( argsEnd - args ) < length )
+			{
+				return false;
+			}
+
+			const AXString str( reinterpret_cast< const char* >( args ), length );
+			args += length;
+
+			SetConversion( specTail, "s" );
+			AppendFormatted( out, spec, str.c_str( ) );
+		}
+		else
+		{
+			uint64_t payload( 0 );
+
+			if( argsEnd - args < 8 )
+			{
+				return false;
+			}
+
+			memcpy( &payload, args, 8 );
+			args += 8;
+
+			int64_t signedVal( 0 );
+			double doubleVal( 0.0 );
+			memcpy( &signedVal, &payload, 8 );
+			memcpy( &doubleVal, &payload, 8 );
+
+			// Signed values were sign extended to 64 bits, unsigned conversions should only see the original width
+			const uint64_t unsignedVal( width > 0 && width < 8 ? payload & ( ( 1ull << ( width * 8 ) ) - 1 ) : payload );
+
+			if( conversion == 'c' )
+			{
+				SetConversion( specTail, "c" );
+				AppendFormatted( out, spec, ( int )signedVal );
+			}
+			else if( conversion == 'p' )
+			{
+				SetConversion( specTail, "p" );
+				AppendFormatted( out, spec, ( void* )( uintptr_t )payload );
+			}
+			else if( type == ArgType::Double )
+			{
+				if( IsFloatConversion( conversion ) )
+				{
+					SetConversion( specTail, conversion );
+					AppendFormatted( out, spec, doubleVal );
+				}
+				else
+				{
+					SetConversion( specTail, "g" );
+					AppendFormatted( out, spec, doubleVal );
+				}
+			}
+			else if( IsFloatConversion( conversion ) )
+			{
+				SetConversion( specTail, conversion );
+				AppendFormatted( out, spec, type == ArgType::Int64 ? ( double )signedVal : ( double )payload );
+			}
+			else if( IsIntegerConversion( conversion ) && conversion != 'd' && conversion != 'i' )
+			{
+				const char longConversion[] = { 'l', 'l', conversion, '\0' };
+				SetConversion( specTail, longConversion );
+				AppendFormatted( out, spec, ( unsigned long long )unsignedVal );
+			}
+			else if( type == ArgType::Int64 )
+			{
+				SetConversion( specTail, "lld" );
+				AppendFormatted( out, spec, ( long long )signedVal );
+			}
+			else
+			{
+				SetConversion( specTail, "llu" );
+				AppendFormatted( out, spec, ( unsigned long long )payload );
+			}
+		}
+
+		pos = conversionPos + 1;
+	}
+
+	return true;
+}
\ No newline at end of file
@@ -0,0 +1,196 @@
+// Copyright 2016 Scott Bevin, All Rights Reserved
+
+#pragma once
+
+#include "AX/Utils/AXString.h"
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <type_traits>
+
+/**
+ * Identifies a binary log file, "AXLG"
+ */
+#define AXBINARYLOG_FILE_MAGIC 0x474c5841u
+
+/**
+ * Bumped whenever the binary log file layout changes
+ */
+#define AXBINARYLOG_FILE_VERSION 2u
+
+/**
+ * Encoding of log arguments for deferred formatting, and the binary log file layout. Kept free of engine systems so
+ * offline tools can decode logs with it.
+ *
+ * Arguments are written as a type byte followed by a fixed 8 byte payload, or a 4 byte length and the characters for
+ * strings. The low nibble of the type byte is the ArgType and the high nibble the size in bytes of the original argument,
+ * so a narrow value widened to 8 bytes can be narrowed again. Strings are always copied because the pointer may not
+ * outlive the call.
+ *
+ * A binary log file is the magic and version as uint32s followed by records, each starting with a RecordType byte:
+ *  String:    uint64 id, uint32 length, characters. Defines the text for an id used by later records
+ *  Deferred:  uint8 level, uint64 tag id, uint64 format id, uint64 file id, int32 line, uint32 args size, encoded args
+ *  Formatted: uint8 level, uint64 tag id, uint64 file id, int32 line, uint32 length, characters
+ */
+class AXBinaryLog
+{
+public:
+	enum class ArgType : uint8_t
+	{
+		Int64,
+		UInt64,
+		Double,
+		String,
+		Pointer,
+	};
+
+	enum class RecordType : uint8_t
+	{
+		String,
+		Deferred,
+		Formatted,
+	};
+
+public:
+	/**
+	* Returns the number of bytes Encode will write for the arguments
+	*/
+	template< class... Args >
+	static size_t EncodedSize( const Args&... args );
+
+	/**
+	* Writes the arguments to out, which must hold EncodedSize( args... ) bytes
+	*/
+	template< class... Args >
+	static void Encode( uint8_t* out, const Args&... args );
+
+	/**
+	* Formats fmt with arguments written by Encode. Each conversion is formatted on its own with the type taken from the
+	* encoded argument, so mismatched length modifiers are harmless. Returns false if the arguments ran out or a conversion
+	* wasn't understood, out still holds everything formatted up to that point
+	*/
+	static bool FormatMessage( const char* fmt, const uint8_t* args, size_t argsSize, AXString& out );
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Describes how a log argument type is encoded, unsupported types fall back to formatting at the call site
+ */
+template< class T, class TEnable = void >
+struct AXBinaryLogArgTraits
+{
+	static const bool IsSupported = false;
+};
+
+namespace AXBinaryLogInternal
+{
+	inline uint8_t* WriteFixed( uint8_t* out, AXBinaryLog::ArgType type, size_t width, const void* payload )
+	{
+		*out = ( uint8_t )( ( uint8_t )type | ( width << 4 ) );
+		memcpy( out + 1, payload, 8 );
+		return out + 9;
+	}
+
+	inline uint8_t* WriteString( uint8_t* out, const char* str, uint32_t length )
+	{
+		*out = ( uint8_t )AXBinaryLog::ArgType::String;
+		memcpy( out + 1, &length, 4 );
+		memcpy( out + 5, str, length );
+		return out + 5 + length;
+	}
+
+	template< class T >
+	struct IsCharPointer : std::is_same< typename std::remove_cv< typename std::remove_pointer< T >::type >::type, char > { };
+}
+
+template< class T >
+struct AXBinaryLogArgTraits< T, typename std::enable_if< ( std::is_integral< T >::value && std::is_signed< T >::value ) || std::is_enum< T >::value >::type >
+{
+	static const bool IsSupported = true;
+	static size_t Size( const T& ) { return 9; }
+	static uint8_t* Write( uint8_t* out, const T& val ) { const int64_t payload( ( int64_t )val ); return AXBinaryLogInternal::WriteFixed( out, AXBinaryLog::ArgType::Int64, sizeof( T ), &payload ); }
+};
+
+template< class T >
+struct AXBinaryLogArgTraits< T, typename std::enable_if< std::is_integral< T >::value && !std::is_signed< T >::value >::type >
+{
+	static const bool IsSupported = true;
+	static size_t Size( const T& ) { return 9; }
+	static uint8_t* Write( uint8_t* out, const T& val ) { const uint64_t payload( ( uint64_t )val ); return AXBinaryLogInternal::WriteFixed( out, AXBinaryLog::ArgType::UInt64, sizeof( T ), &payload ); }
+};
+
+template< class T >
+struct AXBinaryLogArgTraits< T, typename std::enable_if< std::is_floating_point< T >::value >::type >
+{
+	static const bool IsSupported = true;
+	static size_t Size( const T& ) { return 9; }
+	static uint8_t* Write( uint8_t* out, const T& val ) { const double payload( ( double )val ); return AXBinaryLogInternal::WriteFixed( out, AXBinaryLog::ArgType::Double, sizeof( payload ), &payload ); }
+};
+
+template< class T >
+struct AXBinaryLogArgTraits< T, typename std::enable_if< std::is_pointer< T >::value && AXBinaryLogInternal::IsCharPointer< T >::value >::type >
+{
+	static const bool IsSupported = true;
+	static const char* Str( const T& val ) { return val ? val : "(null)"; }
+	static size_t Size( const T& val ) { return 5 + strlen( Str( val ) ); }
+	static uint8_t* Write( uint8_t* out, const T& val ) { return AXBinaryLogInternal::WriteString( out, Str( val ), ( uint32_t )strlen( Str( val ) ) ); }
+};
+
+template< class T >
+struct AXBinaryLogArgTraits< T, typename std::enable_if< std::is_pointer< T >::value && !AXBinaryLogInternal::IsCharPointer< T >::value >::type >
+{
+	static const bool IsSupported = true;
+	static size_t Size( const T& ) { return 9; }
+	static uint8_t* Write( uint8_t* out, const T& val ) { const uint64_t payload( ( uint64_t )( uintptr_t )val ); return AXBinaryLogInternal::WriteFixed( out, AXBinaryLog::ArgType::Pointer, sizeof( payload ), &payload ); }
+};
+
+template<>
+struct AXBinaryLogArgTraits< AXString >
+{
+	static const bool IsSupported = true;
+	static size_t Size( const AXString& val ) { return 5 + val.size( ); }
+	static uint8_t* Write( uint8_t* out, const AXString& val ) { return AXBinaryLogInternal::WriteString( out, val.c_str( ), ( uint32_t )val.size( ) ); }
+};
+
+/**
+ * True if every argument type can be encoded
+ */
+template< class... Args >
+struct AXBinaryLogArgsSupported;
+
+template<>
+struct AXBinaryLogArgsSupported<> : std::true_type { };
+
+template< class T, class... Rest >
+struct AXBinaryLogArgsSupported< T, Rest... > : std::integral_constant< bool, AXBinaryLogArgTraits< T >::IsSupported && AXBinaryLogArgsSupported< Rest... >::value > { };
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+* Returns the number of bytes Encode will write for the arguments
+*/
+template< class... Args >
+size_t AXBinaryLog::EncodedSize( const Args&... args )
+{
+	size_t size( 0 );
+
+	using Expand = int[];
+	( void )Expand{ 0, ( size += AXBinaryLogArgTraits< Args >::Size( args ), 0 )... };
+
+	return size;
+}
+
+/**
+* Writes the arguments to out, which must hold EncodedSize( args... ) bytes
+*/
+template< class... Args >
+void AXBinaryLog::Encode( uint8_t* out, const Args&... args )
+{
+	using Expand = int[];
+	( void )Expand{ 0, ( out = AXBinaryLogArgTraits< Args >::Write( out, args ), 0 )... };
+	( void )out;
+}
\ No newline at end of file
@@ -0,0 +1,544 @@
+// Copyright 2016 Scott Bevin, All Rights Reserved
+
+#include "AXFrameTimings.h"
+#include "AX/Core/AXApplication.h"
+#include "AX/Utils/AXUtils.h"
+
+#include <algorithm>
+#include <float.h>
+
+template<> AXName AXSystem< AXFrameTimings >::sSystemName = "Frame Timings";
+
+/**
+* The frame budget used when the frame rate is uncapped, 60 frames a second
+*/
+#define AXFRAMETIMINGS_DEFAULT_BUDGET_MS ( 1000.0f / 60.0f )
+
+/**
+* Clears the window and sets how many samples it keeps
+*/
+void AXFrameTimings::Window::Resize( uint32_t numSamples )
+{
+	mSamples.assign( numSamples, 0.0f );
+	mNext = 0;
+	mCount = 0;
+}
+
+/**
+* Adds a sample, replacing the oldest once full
+*/
+void AXFrameTimings::Window::Add( float ms )
+{
+	if( mSamples.empty( ) )
+	{
+		return;
+	}
+
+	mSamples[mNext] = ms;
+	mNext = ( mNext + 1 ) % ( uint32_t )mSamples.size( );
+	mCount = AXUtils::Min( mCount + 1, ( uint32_t )mSamples.size( ) );
+}
+
+/**
+* Summarises the window, scratch is used to sort a copy of the samples
+*/
+void AXFrameTimings::Window::ComputeStats( Stats& outStats, std::vector< float >& scratch ) const
+{
+	outStats = Stats( );
+
+	if( mCount == 0 )
+	{
+		return;
+	}
+
+	scratch.resize( mCount );
+
+	double total( 0.0 );
+
+	for( uint32_t i( 0 ); i < mCount; ++i )
+	{
+		scratch[i] = At( i );
+		total += scratch[i];
+	}
+
+	std::sort( scratch.begin( ), scratch.end( ) );
+
+	// Nearest rank, so a percentile is always a frame that actually happened
+	auto percentile = [ &scratch ]( uint32_t pct ) { return scratch[( ( size_t )pct * scratch.size( ) + 99 ) / 100 - 1]; };
+
+	outStats.mLast = At( mCount - 1 );
+	outStats.mMean = ( float )( total / mCount );
+	outStats.mP50 = percentile( 50 );
+	outStats.mP95 = percentile( 95 );
+	outStats.mP99 = percentile( 99 );
+	outStats.mMax = scratch.back( );
+}
+
+/**
+* Counts the samples falling in each of outBins.size( ) equal bins between 0 and maxMs, samples above maxMs go in the last
+*/
+void AXFrameTimings::Window::BuildHistogram( float maxMs, std::vector< float >& outBins ) const
+{
+	std::fill( outBins.begin( ), outBins.end( ), 0.0f );
+
+	if( outBins.empty( ) || maxMs <= 0.0f )
+	{
+		return;
+	}
+
+	const float binsPerMs( outBins.size( ) / maxMs );
+
+	for( uint32_t i( 0 ); i < mCount; ++i )
+	{
+		const size_t bin( ( size_t )AXUtils::Max( At( i ) * binsPerMs, 0.0f ) );
+		outBins[AXUtils::Min( bin, outBins.size( ) - 1 )] += 1.0f;
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+* Clears the window and sets how many readings it keeps
+*/
+void AXFrameTimings::CountersWindow::Resize( uint32_t numSamples )
+{
+	mSamples.clear( );
+	mSum = AXHardwareCounters::Values( );
+	mNumSamples = numSamples;
+	mNext = 0;
+	mCount = 0;
+}
+
+/**
+* Adds a reading, replacing the oldest once full
+*/
+void AXFrameTimings::CountersWindow::Add( const AXHardwareCounters::Values& values )
+{
+	if( mNumSamples == 0 )
+	{
+		return;
+	}
+
+	if( mSamples.empty( ) )
+	{
+		mSamples.resize( mNumSamples );
+	}
+
+	if( mCount == mNumSamples )
+	{
+		mSum = mSum - mSamples[mNext];
+	}
+
+	mSamples[mNext] = values;
+	mSum += values;
+
+	mNext = ( mNext + 1 ) % mNumSamples;
+	mCount = AXUtils::Min( mCount + 1, mNumSamples );
+}
+
+/**
+* Returns the mean of every reading in the window
+*/
+AXHardwareCounters::Values AXFrameTimings::CountersWindow::Mean( ) const
+{
+	AXHardwareCounters::Values mean;
+
+	if( mCount > 0 )
+	{
+		for( uint32_t i( 0 ); i < AXHardwareCounters::Counter::MaxCounters; ++i )
+		{
+			mean.mCounts[i] = mSum.mCounts[i] / mCount;
+		}
+	}
+
+	return mean;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+* Initialise the system, called after settings are loaded
+*/
+AXFrameTimings::InitResult AXFrameTimings::OnInitialize( )
+{
+	if( AXImGui* imGui = AXImGui::GetFrom( AXApplication::Get( ) ) )
+	{
+		imGui->RegisterSystemDebugMenuItem( "Window/Frame Timings", std::bind( &AXFrameTimings::ImGuiFrameTimingsWindowCallback, this, std::placeholders::_1 ) );
+	}
+
+	mWindowFrames = AXUtils::Max( mSettings->mWindowFrames.Val( ), ( uint32_t )AXFRAMETIMINGS_MIN_WINDOW_FRAMES );
+
+	mFrame.Resize( mWindowFrames );
+	mFrameCounters.Resize( mWindowFrames );
+
+	for( uint32_t phase( 0 ); phase < Phase::MaxPhases; ++phase )
+	{
+		mPhases[phase].Resize( mWindowFrames );
+		mPhaseCounters[phase].Resize( mWindowFrames );
+	}
+
+	return AXFrameTimings::InitResult::Initialized;
+}
+
+/**
+* Called once a frame to allow systems to update
+*/
+void AXFrameTimings::Update( float dt )
+{
+	RenderImGuiFrameTimingsWindow( );
+}
+
+/**
+* Adds how long a system took in a phase of this frame, systems are identified by their position in the engine's system list.
+* counters is the change in hardware counters over the same time, if they were read
+*/
+void AXFrameTimings::AddSystemTime( Phase::E phase, uint32_t systemIdx, const AXName& systemName, float ms, const AXHardwareCounters::Values* counters )
+{
+	if( systemIdx >= mSystems.size( ) )
+	{
+		const size_t firstNew( mSystems.size( ) );
+		mSystems.resize( systemIdx + 1 );
+
+		for( size_t i( firstNew ); i < mSystems.size( ); ++i )
+		{
+			for( uint32_t systemPhase( 0 ); systemPhase < Phase::MaxPhases; ++systemPhase )
+			{
+				mSystems[i].mPhases[systemPhase].Resize( mWindowFrames );
+				mSystems[i].mPhaseCounters[systemPhase].Resize( mWindowFrames );
+			}
+		}
+	}
+
+	SystemTimings& system( mSystems[systemIdx] );
+	system.mName = systemName;
+	system.mPhases[phase].Add( ms );
+
+	if( counters )
+	{
+		system.mPhaseCounters[phase].Add( *counters );
+	}
+}
+
+/**
+* Adds how long a whole phase of this frame took, and the change in hardware counters if they were read
+*/
+void AXFrameTimings::AddPhaseTime( Phase::E phase, float ms, const AXHardwareCounters::Values* counters )
+{
+	mPhases[phase].Add( ms );
+
+	if( counters )
+	{
+		mPhaseCounters[phase].Add( *counters );
+	}
+}
+
+/**
+* Adds how long this frame took, not counting time spent sleeping to cap the frame rate, and the change in hardware counters
+* if they were read
+*/
+void AXFrameTimings::AddFrameTime( float ms, const AXHardwareCounters::Values* counters )
+{
+	mFrame.Add( ms );
+
+	if( counters )
+	{
+		mFrameCounters.Add( *counters );
+	}
+}
+
+/**
+* Adds stats for the frame, every phase and every system in each phase over the current window to a JSON object, with the
+* mean hardware counters of any that have them
+*/
+void AXFrameTimings::WriteToJSON( cJSON& jsonRoot ) const
+{
+	std::vector< float > scratch;
+
+	cJSON_AddNumberToObject( &jsonRoot, "window_frames", mFrame.Count( ) );
+	cJSON_AddNumberToObject( &jsonRoot, "budget_ms", FrameBudgetMs( ) );
+
+	WriteStatsToJSON( jsonRoot, "frame", mFrame, mFrameCounters, scratch );
+
+	cJSON* phasesRoot( cJSON_CreateObject( ) );
+
+	if( !phasesRoot )
+	{
+		return;
+	}
+
+	cJSON_AddItemToObject( &jsonRoot, "phases", phasesRoot );
+
+	for( uint32_t phase( 0 ); phase < Phase::MaxPhases; ++phase )
+	{
+		WriteStatsToJSON( *phasesRoot, Phase::ToString( ( Phase::E )phase ).c_str( ), mPhases[phase], mPhaseCounters[phase], scratch );
+	}
+
+	cJSON* systemsRoot( cJSON_CreateObject( ) );
+
+	if( !systemsRoot )
+	{
+		return;
+	}
+
+	cJSON_AddItemToObject( &jsonRoot, "systems", systemsRoot );
+
+	for( const SystemTimings& system : mSystems )
+	{
+		if( cJSON* systemRoot = cJSON_CreateObject( ) )
+		{
+			cJSON_AddItemToObject( systemsRoot, system.mName.c_str( ), systemRoot );
+
+			for( uint32_t phase( 0 ); phase < Phase::MaxPhases; ++phase )
+			{
+				WriteStatsToJSON( *systemRoot, Phase::ToString( ( Phase::E )phase ).c_str( ), system.mPhases[phase], system.mPhaseCounters[phase], scratch );
+			}
+		}
+	}
+}
+
+/**
+* Adds a window's stats and mean hardware counters to a JSON object as a child called name
+*/
+void AXFrameTimings::WriteStatsToJSON( cJSON& jsonRoot, const char* name, const Window& window, const CountersWindow& counters, std::vector< float >& scratch )
+{
+	Stats stats;
+	window.ComputeStats( stats, scratch );
+
+	if( cJSON* statsRoot = cJSON_CreateObject( ) )
+	{
+		cJSON_AddNumberToObject( statsRoot, "mean_ms", stats.mMean );
+		cJSON_AddNumberToObject( statsRoot, "p50_ms", stats.mP50 );
+		cJSON_AddNumberToObject( statsRoot, "p95_ms", stats.mP95 );
+		cJSON_AddNumberToObject( statsRoot, "p99_ms", stats.mP99 );
+		cJSON_AddNumberToObject( statsRoot, "max_ms", stats.mMax );
+
+		if( counters.Count( ) > 0 )
+		{
+			if( cJSON* countersRoot = cJSON_CreateObject( ) )
+			{
+				const AXHardwareCounters::Values mean( counters.Mean( ) );
+
+				for( uint32_t i( 0 ); i < AXHardwareCounters::Counter::MaxCounters; ++i )
+				{
+					cJSON_AddNumberToObject( countersRoot, AXHardwareCounters::Counter::ToJSONName( ( AXHardwareCounters::Counter::E )i ), ( double )mean.mCounts[i] );
+				}
+
+				cJSON_AddNumberToObject( countersRoot, "ipc", mean.IPC( ) );
+
+				cJSON_AddItemToObject( statsRoot, "counters", countersRoot );
+			}
+		}
+
+		cJSON_AddItemToObject( &jsonRoot, name, statsRoot );
+	}
+}
+
+/**
+* Override to register a settings object for this system
+*/
+void AXFrameTimings::CreateEngineSettings( class AXSettingsFile& settings )
+{
+	mSettings = settings.RegisterNewItem< AXFrameTimings::Settings >( AXFrameTimings::StaticName( ).GetString( ) );
+}
+
+/**
+* A callback function to draw the frame timings window
+*/
+void AXFrameTimings::ImGuiFrameTimingsWindowCallback( AXImGui::SystemDebugMenuItem& item )
+{
+	ImGui::MenuItem( item.mText.c_str( ), "", &mShouldRenderImGuiFrameTimingsWindow );
+}
+
+/**
+* Renders the IM gui frame timings window
+*/
+void AXFrameTimings::RenderImGuiFrameTimingsWindow( )
+{
+	if( mShouldRenderImGuiFrameTimingsWindow )
+	{
+		if( ImGui::Begin( "Frame Timings", &mShouldRenderImGuiFrameTimingsWindow ) )
+		{
+			const float budgetMs( FrameBudgetMs( ) );
+
+			Stats frameStats;
+			mFrame.ComputeStats( frameStats, mScratch );
+
+			ImGui::Text( "Frame %.2f ms, p50 %.2f, p95 %.2f, p99 %.2f, max %.2f, budget %.2f ms over %u frames",
+				frameStats.mLast, frameStats.mP50, frameStats.mP95, frameStats.mP99, frameStats.mMax, budgetMs, mFrame.Count( ) );
+
+			// Frame times over the window, scaled so the budget sits two thirds of the way up unless a frame went further over
+			mScratch.resize( mFrame.Count( ) );
+
+			for( uint32_t i( 0 ); i < mFrame.Count( ); ++i )
+			{
+				mScratch[i] = mFrame.At( i );
+			}
+
+			const float graphMaxMs( AXUtils::Max( budgetMs * 1.5f, frameStats.mMax ) );
+
+			ImGui::PlotLines( "##FrameTimes", mScratch.data( ), ( int )mScratch.size( ), 0, "Frame ms", 0.0f, graphMaxMs, ImVec2( -1.0f, 60.0f ) );
+
+			// Histogram of whichever row is selected below
+			AXString selectedName;
+			const Window& selectedWindow( GetSelectedWindow( selectedName ) );
+
+			Stats selectedStats;
+			selectedWindow.ComputeStats( selectedStats, mScratch );
+
+			const float histogramMaxMs( AXUtils::Max( selectedStats.mMax, 0.001f ) );
+			mHistogram.resize( AXUtils::Max( mSettings->mHistogramBins.Val( ), ( uint32_t )1 ) );
+			selectedWindow.BuildHistogram( histogramMaxMs, mHistogram );
+
+			const AXString histogramText( AXUtils::FormatString( "%s, 0 - %.2f ms, p50 %.2f p95 %.2f p99 %.2f", selectedName.c_str( ), histogramMaxMs, selectedStats.mP50, selectedStats.mP95, selectedStats.mP99 ) );
+
+			ImGui::PlotHistogram( "##Histogram", mHistogram.data( ), ( int )mHistogram.size( ), 0, histogramText.c_str( ), 0.0f, FLT_MAX, ImVec2( -1.0f, 80.0f ) );
+
+			ImGui::Separator( );
+
+			// Hardware counters are means over the window, shown once any have been read
+			const bool showCounters( mFrameCounters.Count( ) > 0 );
+
+			ImGui::Columns( showCounters ? 10 : 7, "FrameTimings" );
+			ImGui::Text( "Name" ); ImGui::NextColumn( );
+			ImGui::Text( "Last" ); ImGui::NextColumn( );
+			ImGui::Text( "Mean" ); ImGui::NextColumn( );
+			ImGui::Text( "p50" ); ImGui::NextColumn( );
+			ImGui::Text( "p95" ); ImGui::NextColumn( );
+			ImGui::Text( "p99" ); ImGui::NextColumn( );
+			ImGui::Text( "Max" ); ImGui::NextColumn( );
+
+			if( showCounters )
+			{
+				ImGui::Text( "IPC" ); ImGui::NextColumn( );
+				ImGui::Text( "Cache Misses" ); ImGui::NextColumn( );
+				ImGui::Text( "Branch Misses" ); ImGui::NextColumn( );
+			}
+
+			ImGui::Separator( );
+
+			if( RenderStatsRow( "Frame", mFrame, mFrameCounters, showCounters, budgetMs ) )
+			{
+				mSelectedPhase = -1;
+				mSelectedSystem = -1;
+			}
+
+			for( uint32_t phase( 0 ); phase < Phase::MaxPhases; ++phase )
+			{
+				ImGui::PushID( ( int )phase );
+
+				if( RenderStatsRow( Phase::ToString( ( Phase::E )phase ).c_str( ), mPhases[phase], mPhaseCounters[phase], showCounters, budgetMs ) )
+				{
+					mSelectedPhase = ( int32_t )phase;
+					mSelectedSystem = -1;
+				}
+
+				ImGui::Indent( );
+
+				for( uint32_t systemIdx( 0 ); systemIdx < mSystems.size( ); ++systemIdx )
+				{
+					ImGui::PushID( ( int )systemIdx );
+
+					if( RenderStatsRow( mSystems[systemIdx].mName.c_str( ), mSystems[systemIdx].mPhases[phase], mSystems[systemIdx].mPhaseCounters[phase], showCounters, budgetMs ) )
+					{
+						mSelectedPhase = ( int32_t )phase;
+						mSelectedSystem = ( int32_t )systemIdx;
+					}
+
+					ImGui::PopID( );
+				}
+
+				ImGui::Unindent( );
+				ImGui::PopID( );
+			}
+
+			ImGui::Columns( 1 );
+		}
+
+		ImGui::End( );
+	}
+}
+
+/**
+* Renders a row of the stats table, returns true if the row was clicked
+*/
+bool AXFrameTimings::RenderStatsRow( const char* name, const Window& window, const CountersWindow& counters, bool showCounters, float budgetMs )
+{
+	Stats stats;
+	window.ComputeStats( stats, mScratch );
+
+	const bool clicked( ImGui::Selectable( name, false, ImGuiSelectableFlags_SpanAllColumns ) );
+	ImGui::NextColumn( );
+
+	const float values[] = { stats.mLast, stats.mMean, stats.mP50, stats.mP95, stats.mP99, stats.mMax };
+
+	for( float value : values )
+	{
+		if( value > budgetMs )
+		{
+			ImGui::TextColored( ImVec4( 1.0f, 0.3f, 0.3f, 1.0f ), "%.3f", value );
+		}
+		else
+		{
+			ImGui::Text( "%.3f", value );
+		}
+
+		ImGui::NextColumn( );
+	}
+
+	if( showCounters )
+	{
+		if( counters.Count( ) > 0 )
+		{
+			const AXHardwareCounters::Values mean( counters.Mean( ) );
+
+			ImGui::Text( "%.2f", mean.IPC( ) ); ImGui::NextColumn( );
+			ImGui::Text( "%llu", ( unsigned long long )mean.mCounts[AXHardwareCounters::Counter::CacheMisses] ); ImGui::NextColumn( );
+			ImGui::Text( "%llu", ( unsigned long long )mean.mCounts[AXHardwareCounters::Counter::BranchMisses] ); ImGui::NextColumn( );
+		}
+		else
+		{
+			ImGui::NextColumn( );
+			ImGui::NextColumn( );
+			ImGui::NextColumn( );
+		}
+	}
+
+	return clicked;
+}
+
+/**
+* Returns the window of the selected row and its name
+*/
+const AXFrameTimings::Window& AXFrameTimings::GetSelectedWindow( AXString& outName ) const
+{
+	if( mSelectedPhase < 0 || mSelectedPhase >= Phase::MaxPhases )
+	{
+		outName = "Frame";
+		return mFrame;
+	}
+
+	const Phase::E phase( ( Phase::E )mSelectedPhase );
+
+	if( mSelectedSystem < 0 || mSelectedSystem >= ( int32_t )mSystems.size( ) )
+	{
+		outName = Phase::ToString( phase );
+		return mPhases[phase];
+	}
+
+	const SystemTimings& system( mSystems[mSelectedSystem] );
+
+	outName = AXString( system.mName.c_str( ) ) + " " + Phase::ToString( phase );
+	return system.mPhases[phase];
+}
+
+/**
+* Returns the frame budget in milliseconds, from the application's frame rate cap
+*/
+float AXFrameTimings::FrameBudgetMs( ) const
+{
+	const uint32_t maxFPS( AXApplication::Get( ).GetMaxFPS( ) );
+
+	return maxFPS > 0 ? 1000.0f / maxFPS : AXFRAMETIMINGS_DEFAULT_BUDGET_MS;
+}
\ No newline at end of file
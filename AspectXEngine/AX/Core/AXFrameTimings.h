@@ -0,0 +1,281 @@
+// Copyright 2016 Scott Bevin, All Rights Reserved
+
+#pragma once
+
+#include "AX/Core/AXSystem.h"
+#include "AX/Core/AXSettings.h"
+#include "AX/Core/AXHardwareCounters.h"
+#include "AX/Utils/AXParent.h"
+#include "AX/Utils/AXName.h"
+#include "AX/Utils/AXString.h"
+#include "AX/Graphics/UI/ImGui/AXImGui.h"
+
+#include <stdint.h>
+#include <vector>
+
+/**
+ * Fewest frames kept in each rolling window
+ */
+#define AXFRAMETIMINGS_MIN_WINDOW_FRAMES 16
+
+/**
+ * Keeps how long each frame, each phase of the frame and each system within a phase took over a rolling window of frames,
+ * and shows them in a window with percentiles and histograms. Timings are fed by the engine loop, along with hardware counters
+ * while they are enabled
+ */
+class AXFrameTimings : public AXParent< AXSystem< AXFrameTimings >, AXFrameTimings >
+{
+public:
+	class Settings : public AXSettingsFile::SettingsItem
+	{
+	public:
+		/**
+		* Constructor
+		*/
+		Settings( )
+		{
+			RegisterProperty( mWindowFrames, "Window Frames" );
+			RegisterProperty( mHistogramBins, "Histogram Bins" );
+		}
+
+	public:
+		/**
+		 * The number of frames percentiles and histograms are taken over. Applied on initialise
+		 */
+		AXProperty< uint32_t > mWindowFrames = 300;
+
+		/**
+		 * The number of bars in the histograms
+		 */
+		AXProperty< uint32_t > mHistogramBins = 48;
+	};
+
+	struct Phase
+	{
+		enum E
+		{
+			BeginFrame,
+			Update,
+			Render,
+			EndFrame,
+
+			MaxPhases,
+		};
+
+		static const AXString& ToString( E e )
+		{
+			static AXString strings[] = { "BeginFrame", "Update", "Render", "EndFrame" };
+			return strings[e];
+		}
+	};
+
+	/**
+	 * Summary of a rolling window, in milliseconds
+	 */
+	struct Stats
+	{
+		float mLast = 0.0f;
+		float mMean = 0.0f;
+		float mP50 = 0.0f;
+		float mP95 = 0.0f;
+		float mP99 = 0.0f;
+		float mMax = 0.0f;
+	};
+
+	/**
+	 * The most recent samples of a single timing, oldest first once full
+	 */
+	class Window
+	{
+	public:
+		/**
+		 * Clears the window and sets how many samples it keeps
+		 */
+		void Resize( uint32_t numSamples );
+
+		/**
+		 * Adds a sample, replacing the oldest once full
+		 */
+		void Add( float ms );
+
+		/**
+		 * Returns the number of samples in the window
+		 */
+		uint32_t Count( ) const { return mCount; }
+
+		/**
+		 * Returns the sample at idx, 0 being the oldest
+		 */
+		float At( uint32_t idx ) const { return mSamples[( mNext + mSamples.size( ) - mCount + idx ) % mSamples.size( )]; }
+
+		/**
+		 * Summarises the window, scratch is used to sort a copy of the samples
+		 */
+		void ComputeStats( Stats& outStats, std::vector< float >& scratch ) const;
+
+		/**
+		 * Counts the samples falling in each of outBins.size( ) equal bins between 0 and maxMs, samples above maxMs go in the last
+		 */
+		void BuildHistogram( float maxMs, std::vector< float >& outBins ) const;
+
+	private:
+		std::vector< float > mSamples;
+		uint32_t mNext = 0;
+		uint32_t mCount = 0;
+	};
+
+	/**
+	 * The most recent hardware counter readings of a single timing, kept as a running sum so the mean is always at hand. Storage
+	 * is only allocated once the first reading is added
+	 */
+	class CountersWindow
+	{
+	public:
+		/**
+		 * Clears the window and sets how many readings it keeps
+		 */
+		void Resize( uint32_t numSamples );
+
+		/**
+		 * Adds a reading, replacing the oldest once full
+		 */
+		void Add( const AXHardwareCounters::Values& values );
+
+		/**
+		 * Returns the number of readings in the window
+		 */
+		uint32_t Count( ) const { return mCount; }
+
+		/**
+		 * Returns the mean of every reading in the window
+		 */
+		AXHardwareCounters::Values Mean( ) const;
+
+	private:
+		std::vector< AXHardwareCounters::Values > mSamples;
+		AXHardwareCounters::Values mSum;
+		uint32_t mNumSamples = 0;
+		uint32_t mNext = 0;
+		uint32_t mCount = 0;
+	};
+
+public:
+	/**
+	* Initialise the system, called after settings are loaded
+	*/
+	virtual InitResult OnInitialize( ) override;
+
+	/**
+	* Called once a frame to allow systems to update
+	*/
+	virtual void Update( float dt ) override;
+
+	/**
+	 * Adds how long a system took in a phase of this frame, systems are identified by their position in the engine's system list.
+	 * counters is the change in hardware counters over the same time, if they were read
+	 */
+	void AddSystemTime( Phase::E phase, uint32_t systemIdx, const AXName& systemName, float ms, const AXHardwareCounters::Values* counters = nullptr );
+
+	/**
+	 * Adds how long a whole phase of this frame took, and the change in hardware counters if they were read
+	 */
+	void AddPhaseTime( Phase::E phase, float ms, const AXHardwareCounters::Values* counters = nullptr );
+
+	/**
+	 * Adds how long this frame took, not counting time spent sleeping to cap the frame rate, and the change in hardware counters
+	 * if they were read
+	 */
+	void AddFrameTime( float ms, const AXHardwareCounters::Values* counters = nullptr );
+
+	/**
+	 * Returns the window of frame times
+	 */
+	const Window& GetFrameWindow( ) const { return mFrame; }
+
+	/**
+	 * Adds stats for the frame, every phase and every system in each phase over the current window to a JSON object, with the
+	 * mean hardware counters of any that have them
+	 */
+	void WriteToJSON( cJSON& jsonRoot ) const;
+
+protected:
+	/**
+	* Override to register a settings object for this system
+	*/
+	virtual void CreateEngineSettings( class AXSettingsFile& settings ) override;
+
+private:
+	/**
+	 * The timings of one system in each phase
+	 */
+	struct SystemTimings
+	{
+		AXName mName;
+		Window mPhases[Phase::MaxPhases];
+		CountersWindow mPhaseCounters[Phase::MaxPhases];
+	};
+
+	/**
+	* A callback function to draw the frame timings window
+	*/
+	void ImGuiFrameTimingsWindowCallback( AXImGui::SystemDebugMenuItem& item );
+
+	/**
+	* Renders the IM gui frame timings window
+	*/
+	void RenderImGuiFrameTimingsWindow( );
+
+	/**
+	 * Renders a row of the stats table, returns true if the row was clicked
+	 */
+	bool RenderStatsRow( const char* name, const Window& window, const CountersWindow& counters, bool showCounters, float budgetMs );
+
+	/**
+	 * Returns the window of the selected row and its name
+	 */
+	const Window& GetSelectedWindow( AXString& outName ) const;
+
+	/**
+	 * Returns the frame budget in milliseconds, from the application's frame rate cap
+	 */
+	float FrameBudgetMs( ) const;
+
+	/**
+	 * Adds a window's stats and mean hardware counters to a JSON object as a child called name
+	 */
+	static void WriteStatsToJSON( cJSON& jsonRoot, const char* name, const Window& window, const CountersWindow& counters, std::vector< float >& scratch );
+
+private:
+	/**
+	* Pointer to the created settings object
+	*/
+	Settings* mSettings = nullptr;
+
+	/**
+	 * The number of samples every window keeps
+	 */
+	uint32_t mWindowFrames = AXFRAMETIMINGS_MIN_WINDOW_FRAMES;
+
+	Window mFrame;
+	Window mPhases[Phase::MaxPhases];
+	CountersWindow mFrameCounters;
+	CountersWindow mPhaseCounters[Phase::MaxPhases];
+	std::vector< SystemTimings > mSystems;
+
+	/**
+	 * The row whose histogram is shown. No phase selects the frame, a phase and no system selects the whole phase
+	 */
+	int32_t mSelectedPhase = -1;
+	int32_t mSelectedSystem = -1;
+
+	/**
+	 * Reused when computing stats and histograms
+	 */
+	std::vector< float > mScratch;
+	std::vector< float > mHistogram;
+
+	/**
+	* If true the frame timings ImGui window will render
+	*/
+	bool mShouldRenderImGuiFrameTimingsWindow = false;
+};
\ No newline at end of file
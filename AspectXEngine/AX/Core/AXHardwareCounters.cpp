@@ -0,0 +1,169 @@
+// Copyright 2016 Scott Bevin, All Rights Reserved
+
+#include "AXHardwareCounters.h"
+#include "AX/Core/AXLogging.h"
+
+#if defined( AXPLATFORM_LINUX )
+#include <errno.h>
+#include <linux/perf_event.h>
+#include <string.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif // #if defined( AXPLATFORM_LINUX )
+
+/**
+* True while counters should be read
+*/
+AXAtomic< bool > AXHardwareCounters::sEnabled = false;
+
+#if defined( AXPLATFORM_LINUX )
+
+namespace
+{
+	/**
+	* The calling thread's counters, opened as one group led by the first counter that opened so they are all read with a
+	* single system call and are scheduled on and off the CPU together
+	*/
+	struct ThreadCounters
+	{
+		enum class State
+		{
+			Unopened,
+			Open,
+			Failed,
+		};
+
+		State mState = State::Unopened;
+		int mLeaderFd = -1;
+		int mFds[AXHardwareCounters::Counter::MaxCounters] = { -1, -1, -1, -1 };
+
+		/**
+		* Which counter each value in a group read belongs to, in the order they joined the group
+		*/
+		uint32_t mGroupOrder[AXHardwareCounters::Counter::MaxCounters] = { };
+		uint32_t mNumInGroup = 0;
+
+		~ThreadCounters( )
+		{
+			for( int fd : mFds )
+			{
+				if( fd >= 0 )
+				{
+					close( fd );
+				}
+			}
+		}
+
+		bool Open( )
+		{
+			static const uint64_t configs[] =
+			{
+				PERF_COUNT_HW_CPU_CYCLES,
+				PERF_COUNT_HW_INSTRUCTIONS,
+				PERF_COUNT_HW_CACHE_MISSES,
+				PERF_COUNT_HW_BRANCH_MISSES,
+			};
+
+			static_assert( sizeof( configs ) / sizeof( configs[0] ) == AXHardwareCounters::Counter::MaxCounters, "Every counter needs a perf config" );
+
+			int lastErrno( 0 );
+
+			for( uint32_t i( 0 ); i < AXHardwareCounters::Counter::MaxCounters; ++i )
+			{
+				perf_event_attr attr;
+				memset( &attr, 0, sizeof( attr ) );
+				attr.size = sizeof( attr );
+				attr.type = PERF_TYPE_HARDWARE;
+				attr.config = configs[i];
+				attr.read_format = PERF_FORMAT_GROUP;
+				attr.exclude_kernel = 1;
+				attr.exclude_hv = 1;
+
+				const int fd( ( int )syscall( SYS_perf_event_open, &attr, 0, -1, mLeaderFd, 0 ) );
+
+				if( fd < 0 )
+				{
+					// Not every CPU, or virtual machine, has every counter, the ones that are missing read as 0
+					lastErrno = errno;
+					continue;
+				}
+
+				if( mLeaderFd < 0 )
+				{
+					mLeaderFd = fd;
+				}
+
+				mFds[i] = fd;
+				mGroupOrder[mNumInGroup++] = i;
+			}
+
+			if( mLeaderFd < 0 )
+			{
+				AXWARNONCE( "Hardware Counters", "Unable to open hardware counters (%s), check /proc/sys/kernel/perf_event_paranoid", strerror( lastErrno ) );
+
+				mState = State::Failed;
+				return false;
+			}
+
+			mState = State::Open;
+			return true;
+		}
+
+		bool Read( AXHardwareCounters::Values& outValues ) const
+		{
+			uint64_t buffer[1 + AXHardwareCounters::Counter::MaxCounters];
+
+			const ssize_t bytesRead( read( mLeaderFd, buffer, sizeof( buffer ) ) );
+
+			if( bytesRead < ( ssize_t )sizeof( uint64_t ) || buffer[0] != mNumInGroup )
+			{
+				return false;
+			}
+
+			outValues = AXHardwareCounters::Values( );
+
+			for( uint32_t i( 0 ); i < mNumInGroup; ++i )
+			{
+				outValues.mCounts[mGroupOrder[i]] = buffer[1 + i];
+			}
+
+			return true;
+		}
+	};
+
+	static thread_local ThreadCounters tThreadCounters;
+}
+
+#endif // #if defined( AXPLATFORM_LINUX )
+
+/**
+* Returns true if the platform has a way to read hardware counters, the CPU or kernel may still refuse to open them
+*/
+bool AXHardwareCounters::IsSupported( )
+{
+#if defined( AXPLATFORM_LINUX )
+	return true;
+#else
+	return false;
+#endif // #if defined( AXPLATFORM_LINUX )
+}
+
+/**
+* Reads the calling thread's counters, opening them on first use. Returns false if they could not be opened, counters the CPU
+* does not have read as 0
+*/
+bool AXHardwareCounters::Read( Values& outValues )
+{
+#if defined( AXPLATFORM_LINUX )
+	ThreadCounters& counters( tThreadCounters );
+
+	if( counters.mState == ThreadCounters::State::Unopened )
+	{
+		counters.Open( );
+	}
+
+	return counters.mState == ThreadCounters::State::Open && counters.Read( outValues );
+#else
+	return false;
+#endif // #if defined( AXPLATFORM_LINUX )
+}
\ No newline at end of file
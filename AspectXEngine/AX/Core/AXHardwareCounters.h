@@ -0,0 +1,110 @@
+// Copyright 2016 Scott Bevin, All Rights Reserved
+
+#pragma once
+
+#include "AX/Utils/AXThreadingPrimitives.h"
+
+#include <stdint.h>
+
+/**
+ * Reads the CPU's hardware performance counters for the calling thread. Counters are opened per thread the first time a thread
+ * reads them and only count while that thread runs, in user mode. Uses perf_event_open on Linux, on other platforms reads always
+ * fail. Reading costs a system call, so counters are only read while enabled
+ */
+class AXHardwareCounters
+{
+public:
+	struct Counter
+	{
+		enum E
+		{
+			Cycles,
+			Instructions,
+			CacheMisses,
+			BranchMisses,
+
+			MaxCounters,
+		};
+
+		static const char* ToString( E e )
+		{
+			static const char* strings[] = { "Cycles", "Instructions", "Cache Misses", "Branch Misses" };
+			return strings[e];
+		}
+
+		/**
+		 * The name used for the counter in exported JSON
+		 */
+		static const char* ToJSONName( E e )
+		{
+			static const char* strings[] = { "cycles", "instructions", "cache_misses", "branch_misses" };
+			return strings[e];
+		}
+	};
+
+	/**
+	 * A reading of every counter, or the difference between two readings
+	 */
+	struct Values
+	{
+		uint64_t mCounts[Counter::MaxCounters] = { };
+
+		/**
+		 * Returns instructions retired per cycle, 0 if no cycles were counted
+		 */
+		double IPC( ) const
+		{
+			return mCounts[Counter::Cycles] > 0 ? ( double )mCounts[Counter::Instructions] / ( double )mCounts[Counter::Cycles] : 0.0;
+		}
+
+		Values operator - ( const Values& rhs ) const
+		{
+			Values result;
+
+			for( uint32_t i( 0 ); i < Counter::MaxCounters; ++i )
+			{
+				result.mCounts[i] = mCounts[i] >= rhs.mCounts[i] ? mCounts[i] - rhs.mCounts[i] : 0;
+			}
+
+			return result;
+		}
+
+		Values& operator += ( const Values& rhs )
+		{
+			for( uint32_t i( 0 ); i < Counter::MaxCounters; ++i )
+			{
+				mCounts[i] += rhs.mCounts[i];
+			}
+
+			return *this;
+		}
+	};
+
+public:
+	/**
+	 * Returns true if the platform has a way to read hardware counters, the CPU or kernel may still refuse to open them
+	 */
+	static bool IsSupported( );
+
+	/**
+	 * Turns counter reads on or off for every thread
+	 */
+	static void SetEnabled( bool enabled ) { sEnabled.store( enabled && IsSupported( ), std::memory_order_relaxed ); }
+
+	/**
+	 * Returns true while counters should be read
+	 */
+	static bool IsEnabled( ) { return sEnabled.load( std::memory_order_relaxed ); }
+
+	/**
+	 * Reads the calling thread's counters, opening them on first use. Returns false if they could not be opened, counters the CPU
+	 * does not have read as 0
+	 */
+	static bool Read( Values& outValues );
+
+private:
+	/**
+	 * True while counters should be read
+	 */
+	static AXAtomic< bool > sEnabled;
+};
\ No newline at end of file
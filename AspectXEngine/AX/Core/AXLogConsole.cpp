@@ -0,0 +1,529 @@
+// Copyright 2016 Scott Bevin, All Rights Reserved
+
+#include "AXLogConsole.h"
+#include "AX/Core/AXApplication.h"
+
+#include <algorithm>
+
+template<> AXName AXSystem< AXLogConsole >::sSystemName = "LogConsole";
+
+/**
+* The fewest entries the console keeps
+*/
+#define AXLOGCONSOLE_MIN_ENTRIES 1024
+
+/**
+* Compact a sequence list once this many entries have been popped from its front and they are over half of it
+*/
+#define AXLOGCONSOLE_SEQUENCE_LIST_COMPACT_THRESHOLD 1024
+
+/**
+* Initialise the system, called after settings are loaded
+*/
+AXLogConsole::InitResult AXLogConsole::OnInitialize( )
+{
+	const uint32_t maxEntries( mSettings ? mSettings->mMaxEntries.Val( ) : 0 );
+	mEntries.resize( AXUtils::Max( maxEntries, ( uint32_t )AXLOGCONSOLE_MIN_ENTRIES ) );
+
+	mPending = std::make_shared< PendingEntries >( );
+
+	if( AXLogging* logging = AXLogging::GetFrom( AXApplication::Get( ) ) )
+	{
+		logging->RegisterNewListener< Listener >( mPending );
+	}
+
+	if( AXImGui* imGui = AXImGui::GetFrom( AXApplication::Get( ) ) )
+	{
+		imGui->RegisterSystemDebugMenuItem( "Window/Log", std::bind( &AXLogConsole::ImGuiLogWindowCallback, this, std::placeholders::_1 ) );
+	}
+
+	return AXLogConsole::InitResult::Initialized;
+}
+
+/**
+* Shutdown the system
+*/
+void AXLogConsole::OnShutdown( )
+{
+	// The listener is owned by the logging system and may outlive us, stop it collecting
+	if( mPending )
+	{
+		mPending->Lock( );
+		mPending->mClosed = true;
+		mPending->mEntries.clear( );
+		mPending->Unlock( );
+	}
+
+	Clear( );
+}
+
+/**
+* Called once a frame to allow systems to update
+*/
+void AXLogConsole::Update( float dt )
+{
+	if( mPending )
+	{
+		mPending->Lock( );
+		mIncoming.swap( mPending->mEntries );
+		mPending->Unlock( );
+
+		for( AXLogging::LogEntry& logEntry : mIncoming )
+		{
+			AddEntry( logEntry );
+		}
+
+		mIncoming.clear( );
+	}
+
+	RenderImGuiLogWindow( );
+}
+
+/**
+* Override to register a settings object for this system
+*/
+void AXLogConsole::CreateEngineSettings( class AXSettingsFile& settings )
+{
+	mSettings = settings.RegisterNewItem< AXLogConsole::Settings >( AXLogConsole::StaticName( ).GetString( ) );
+}
+
+void AXLogConsole::PendingEntries::Lock( )
+{
+	bool expected( false );
+
+	do
+	{
+		expected = false;
+	} while( !mLocked.compare_exchange_weak( expected, true ) );
+}
+
+/**
+* Override to handle a log entry
+*/
+void AXLogConsole::Listener::Log( const AXLogging::LogEntry& entry )
+{
+	mPending->Lock( );
+
+	if( !mPending->mClosed )
+	{
+		mPending->mEntries.push_back( entry );
+	}
+
+	mPending->Unlock( );
+}
+
+/**
+* Removes every leading occurrence of sequence, which must be the oldest in the list
+*/
+void AXLogConsole::SequenceList::PopFront( uint64_t sequence )
+{
+	while( mHead < mSequences.size( ) && mSequences[mHead] == sequence )
+	{
+		++mHead;
+	}
+
+	if( mHead == mSequences.size( ) )
+	{
+		Clear( );
+	}
+	else if( mHead >= AXLOGCONSOLE_SEQUENCE_LIST_COMPACT_THRESHOLD && mHead * 2 >= mSequences.size( ) )
+	{
+		mSequences.erase( mSequences.begin( ), mSequences.begin( ) + mHead );
+		mHead = 0;
+	}
+}
+
+/**
+* Calls func with each lower case word of text, at most maxWords of them
+*/
+template< class F >
+void AXLogConsole::ForEachWord( const char* text, uint32_t maxWords, F func )
+{
+	AXString word;
+	uint32_t numWords( 0 );
+
+	for( const char* c( text ); numWords < maxWords; ++c )
+	{
+		const bool isUpper( *c >= 'A' && *c <= 'Z' );
+
+		if( isUpper || ( *c >= 'a' && *c <= 'z' ) || ( *c >= '0' && *c <= '9' ) || *c == '_' )
+		{
+			word.push_back( isUpper ? ( char )( *c - 'A' + 'a' ) : *c );
+		}
+		else if( !word.empty( ) )
+		{
+			func( word );
+			word.clear( );
+			++numWords;
+		}
+
+		if( *c == '\0' )
+		{
+			break;
+		}
+	}
+}
+
+/**
+* Returns the key a word is stored under in the word index, the word up to its first digit. Numbers in messages are mostly
+* unique ids and would otherwise each add a key to the index, a search for one is verified against the full message
+*/
+const AXString& AXLogConsole::WordIndexKey( const AXString& word, AXString& scratch )
+{
+	const size_t keyLength( std::min< size_t >( word.find_first_of( "0123456789" ), AXLOGCONSOLE_MAX_INDEXED_WORD_LENGTH ) );
+
+	if( keyLength >= word.size( ) )
+	{
+		return word;
+	}
+
+	scratch.assign( word, 0, keyLength );
+	return scratch;
+}
+
+/**
+* Adds an entry to the ring and the indexes, dropping the oldest entry if the ring is full
+*/
+void AXLogConsole::AddEntry( AXLogging::LogEntry& logEntry )
+{
+	if( mNextSequence - mFirstSequence == mEntries.size( ) )
+	{
+		RemoveOldestEntry( );
+	}
+
+	const uint64_t sequence( mNextSequence++ );
+
+	Entry& entry( EntryAt( sequence ) );
+	entry.mSequence = sequence;
+	entry.mLogLevel = logEntry.mLogLevel;
+	entry.mTag = logEntry.mTag;
+	entry.mFile = logEntry.mFile;
+	entry.mLine = logEntry.mLine;
+	entry.mMessage.swap( logEntry.mMessage );
+
+	mTagIndices[entry.mTag].mEntries[entry.mLogLevel].PushBack( sequence );
+
+	AXString scratch;
+
+	ForEachWord( entry.mMessage.c_str( ), AXLOGCONSOLE_MAX_INDEXED_WORDS, [ this, sequence, &scratch ]( const AXString& word )
+	{
+		const AXString& key( WordIndexKey( word, scratch ) );
+
+		if( !key.empty( ) )
+		{
+			auto it( mWordIndex.find( key ) );
+
+			if( it == mWordIndex.end( ) )
+			{
+				it = mWordIndex.emplace( key, SequenceList( ) ).first;
+				mSortedWords.insert( key );
+			}
+
+			it->second.PushBack( sequence );
+		}
+	} );
+
+	if( IsFiltering( ) && PassesFilter( entry ) )
+	{
+		mFilteredEntries.PushBack( sequence );
+	}
+}
+
+/**
+* Removes the oldest entry from the indexes
+*/
+void AXLogConsole::RemoveOldestEntry( )
+{
+	const uint64_t sequence( mFirstSequence++ );
+	const Entry& entry( EntryAt( sequence ) );
+
+	mTagIndices[entry.mTag].mEntries[entry.mLogLevel].PopFront( sequence );
+
+	AXString scratch;
+
+	ForEachWord( entry.mMessage.c_str( ), AXLOGCONSOLE_MAX_INDEXED_WORDS, [ this, sequence, &scratch ]( const AXString& word )
+	{
+		auto it( mWordIndex.find( WordIndexKey( word, scratch ) ) );
+
+		if( it != mWordIndex.end( ) )
+		{
+			it->second.PopFront( sequence );
+
+			if( it->second.IsEmpty( ) )
+			{
+				mSortedWords.erase( it->first );
+				mWordIndex.erase( it );
+			}
+		}
+	} );
+
+	mFilteredEntries.PopFront( sequence );
+}
+
+/**
+* Returns true if any entries are hidden by the current filter
+*/
+bool AXLogConsole::IsFiltering( ) const
+{
+	if( !mSearchTerms.empty( ) )
+	{
+		return true;
+	}
+
+	for( bool showLevel : mShowLevel )
+	{
+		if( !showLevel )
+		{
+			return true;
+		}
+	}
+
+	for( const auto& tagIndex : mTagIndices )
+	{
+		if( !tagIndex.second.mShow )
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+/**
+* Returns true if the entry passes the current filter
+*/
+bool AXLogConsole::PassesFilter( const Entry& entry ) const
+{
+	if( !mShowLevel[entry.mLogLevel] )
+	{
+		return false;
+	}
+
+	auto tagIt( mTagIndices.find( entry.mTag ) );
+
+	if( tagIt != mTagIndices.end( ) && !tagIt->second.mShow )
+	{
+		return false;
+	}
+
+	if( mSearchTerms.empty( ) )
+	{
+		return true;
+	}
+
+	// Every term must start one of the indexed words of the message, so new entries match exactly as a rebuild would
+	uint64_t matchedTerms( 0 );
+	const uint64_t allTerms( mSearchTerms.size( ) >= 64 ? ~0ull : ( 1ull << mSearchTerms.size( ) ) - 1 );
+
+	ForEachWord( entry.mMessage.c_str( ), AXLOGCONSOLE_MAX_INDEXED_WORDS, [ this, &matchedTerms ]( const AXString& word )
+	{
+		for( size_t i( 0 ); i < mSearchTerms.size( ) && i < 64; ++i )
+		{
+			if( word.compare( 0, mSearchTerms[i].size( ), mSearchTerms[i] ) == 0 )
+			{
+				matchedTerms |= 1ull << i;
+			}
+		}
+	} );
+
+	return matchedTerms == allTerms;
+}
+
+/**
+* Rebuilds the filtered entries after the filter changed, from whichever index gives the fewest candidates
+*/
+void AXLogConsole::RebuildFilteredEntries( )
+{
+	mFilteredEntries.Clear( );
+
+	if( !IsFiltering( ) )
+	{
+		return;
+	}
+
+	std::vector< uint64_t > candidates;
+
+	// The longest key has the fewest words starting with it, so the smallest range of the word index
+	AXString prefix;
+	AXString scratch;
+
+	for( const AXString& term : mSearchTerms )
+	{
+		const AXString& key( WordIndexKey( term, scratch ) );
+
+		if( key.size( ) > prefix.size( ) )
+		{
+			prefix = key;
+		}
+	}
+
+	if( !prefix.empty( ) )
+	{
+		for( auto it( mSortedWords.lower_bound( prefix ) ); it != mSortedWords.end( ) && it->compare( 0, prefix.size( ), prefix ) == 0; ++it )
+		{
+			const SequenceList& wordEntries( mWordIndex[*it] );
+			candidates.insert( candidates.end( ), wordEntries.begin( ), wordEntries.end( ) );
+		}
+	}
+	else
+	{
+		for( const auto& tagIndex : mTagIndices )
+		{
+			for( uint32_t level( 0 ); tagIndex.second.mShow && level < AXLogging::LogLevel::MaxLogLevel; ++level )
+			{
+				if( mShowLevel[level] )
+				{
+					candidates.insert( candidates.end( ), tagIndex.second.mEntries[level].begin( ), tagIndex.second.mEntries[level].end( ) );
+				}
+			}
+		}
+	}
+
+	std::sort( candidates.begin( ), candidates.end( ) );
+	candidates.erase( std::unique( candidates.begin( ), candidates.end( ) ), candidates.end( ) );
+
+	for( uint64_t sequence : candidates )
+	{
+		if( sequence >= mFirstSequence && PassesFilter( EntryAt( sequence ) ) )
+		{
+			mFilteredEntries.PushBack( sequence );
+		}
+	}
+}
+
+/**
+* Removes every entry
+*/
+void AXLogConsole::Clear( )
+{
+	for( auto& tagIndex : mTagIndices )
+	{
+		for( SequenceList& levelEntries : tagIndex.second.mEntries )
+		{
+			levelEntries.Clear( );
+		}
+	}
+
+	mWordIndex.clear( );
+	mSortedWords.clear( );
+	mFilteredEntries.Clear( );
+
+	mFirstSequence = mNextSequence;
+}
+
+/**
+* A callback function to draw the log window
+*/
+void AXLogConsole::ImGuiLogWindowCallback( AXImGui::SystemDebugMenuItem& item )
+{
+	ImGui::MenuItem( item.mText.c_str( ), "", &mShouldRenderImGuiLogWindow );
+}
+
+/**
+* Renders the IM gui log window
+*/
+void AXLogConsole::RenderImGuiLogWindow( )
+{
+	if( mShouldRenderImGuiLogWindow )
+	{
+		if( ImGui::Begin( "Log", &mShouldRenderImGuiLogWindow ) )
+		{
+			bool filterChanged( false );
+
+			for( uint32_t level( 0 ); level < AXLogging::LogLevel::MaxLogLevel; ++level )
+			{
+				filterChanged |= ImGui::Checkbox( AXLogging::LogLevel::ToString( ( AXLogging::LogLevel::E )level ).c_str( ), &mShowLevel[level] );
+				ImGui::SameLine( );
+			}
+
+			if( ImGui::Button( "Tags" ) )
+			{
+				ImGui::OpenPopup( "LogTags" );
+			}
+
+			if( ImGui::BeginPopup( "LogTags" ) )
+			{
+				for( auto& tagIndex : mTagIndices )
+				{
+					filterChanged |= ImGui::Checkbox( tagIndex.first.IsNone( ) ? "(None)" : tagIndex.first.c_str( ), &tagIndex.second.mShow );
+				}
+
+				ImGui::EndPopup( );
+			}
+
+			ImGui::SameLine( );
+
+			ImGui::PushItemWidth( 200.0f );
+
+			if( ImGui::InputText( "Search", mSearchText, sizeof( mSearchText ) ) )
+			{
+				mSearchTerms.clear( );
+				ForEachWord( mSearchText, UINT32_MAX, [ this ]( const AXString& word ) { mSearchTerms.push_back( word ); } );
+
+				filterChanged = true;
+			}
+
+			ImGui::PopItemWidth( );
+
+			ImGui::SameLine( );
+
+			if( ImGui::Button( "Clear" ) )
+			{
+				Clear( );
+			}
+
+			ImGui::SameLine( );
+			ImGui::Checkbox( "Auto Scroll", &mAutoScroll );
+
+			if( filterChanged )
+			{
+				RebuildFilteredEntries( );
+			}
+
+			const bool isFiltering( IsFiltering( ) );
+			const uint64_t numEntries( mNextSequence - mFirstSequence );
+			const uint64_t numRows( isFiltering ? mFilteredEntries.Size( ) : numEntries );
+
+			ImGui::Text( "Showing %llu of %llu entries", ( unsigned long long )numRows, ( unsigned long long )numEntries );
+
+			ImGui::Separator( );
+
+			if( ImGui::BeginChild( "LogEntries", ImVec2( 0.0f, 0.0f ), false, ImGuiWindowFlags_HorizontalScrollbar ) )
+			{
+				static const ImVec4 levelColours[AXLogging::LogLevel::MaxLogLevel] =
+				{
+					ImVec4( 0.85f, 0.85f, 0.85f, 1.0f ),
+					ImVec4( 1.0f, 0.8f, 0.2f, 1.0f ),
+					ImVec4( 1.0f, 0.3f, 0.3f, 1.0f ),
+				};
+
+				// Only the visible rows are ever touched
+				ImGuiListClipper clipper( ( int )numRows );
+
+				while( clipper.Step( ) )
+				{
+					for( int i( clipper.DisplayStart ); i < clipper.DisplayEnd; ++i )
+					{
+						const Entry& entry( EntryAt( isFiltering ? mFilteredEntries[i] : mFirstSequence + i ) );
+
+						ImGui::TextColored( levelColours[entry.mLogLevel], "[%-8s] [%-16s] %s (%s : %d)",
+							AXLogging::LogLevel::ToString( entry.mLogLevel ).c_str( ),
+							entry.mTag.c_str( ),
+							entry.mMessage.c_str( ),
+							entry.mFile,
+							entry.mLine );
+					}
+				}
+
+				if( mAutoScroll && ImGui::GetScrollY( ) >= ImGui::GetScrollMaxY( ) )
+				{
+					ImGui::SetScrollHereY( 1.0f );
+				}
+			}
+
+			ImGui::EndChild( );
+		}
+
+		ImGui::End( );
+	}
+}
\ No newline at end of file
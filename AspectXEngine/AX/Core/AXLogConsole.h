@@ -0,0 +1,262 @@
+// Copyright 2016 Scott Bevin, All Rights Reserved
+
+#pragma once
+
+#include "AX/Core/AXSystem.h"
+#include "AX/Core/AXLogging.h"
+#include "AX/Utils/AXParent.h"
+#include "AX/Utils/AXName.h"
+#include "AX/Utils/AXThreadingPrimitives.h"
+#include "AX/Graphics/UI/ImGui/AXImGui.h"
+
+#include <set>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * Longest word stored in the search index, longer words are indexed by their prefix
+ */
+#define AXLOGCONSOLE_MAX_INDEXED_WORD_LENGTH 32
+
+/**
+ * Most words of a single entry stored in the search index, the rest of the entry is only found by the words before it
+ */
+#define AXLOGCONSOLE_MAX_INDEXED_WORDS 32
+
+/**
+ * An in engine log window. Keeps the most recent entries in a fixed size ring and indexes them by tag, level and word as
+ * they arrive, so changing the filter only visits entries the indexes say could match and rendering only visits the
+ * visible rows
+ */
+class AXLogConsole : public AXParent< AXSystem< AXLogConsole >, AXLogConsole >
+{
+public:
+	class Settings : public AXSettingsFile::SettingsItem
+	{
+	public:
+		/**
+		* Constructor
+		*/
+		Settings( )
+		{
+			RegisterProperty( mMaxEntries, "Max Entries" );
+		}
+
+	public:
+		/**
+		 * The number of entries kept, the oldest are dropped first. Applied on initialise
+		 */
+		AXProperty< uint32_t > mMaxEntries = 65536;
+	};
+
+public:
+	/**
+	* Initialise the system, called after settings are loaded
+	*/
+	virtual InitResult OnInitialize( ) override;
+
+	/**
+	* Shutdown the system
+	*/
+	virtual void OnShutdown( ) override;
+
+	/**
+	* Called once a frame to allow systems to update
+	*/
+	virtual void Update( float dt ) override;
+
+protected:
+	/**
+	* Override to register a settings object for this system
+	*/
+	virtual void CreateEngineSettings( class AXSettingsFile& settings ) override;
+
+private:
+	/**
+	 * Entries handed over by the listener on the logger thread, collected by the console once a frame. Shared so the listener
+	 * can outlive the console
+	 */
+	struct PendingEntries
+	{
+		std::vector< AXLogging::LogEntry > mEntries;
+		AXAtomic< bool > mLocked = false;
+		bool mClosed = false;
+
+		void Lock( );
+		void Unlock( ) { mLocked = false; }
+	};
+
+	/**
+	 * Forwards entries to the console
+	 */
+	class Listener : public AXLogging::AXILogListener
+	{
+	public:
+		Listener( const std::shared_ptr< PendingEntries >& pending ) : mPending( pending ) { }
+
+		virtual void Log( const AXLogging::LogEntry& entry ) override;
+
+	private:
+		std::shared_ptr< PendingEntries > mPending;
+	};
+
+	/**
+	 * An ordered list of entry sequence numbers that is only added to at the back and removed from at the front
+	 */
+	class SequenceList
+	{
+	public:
+		void PushBack( uint64_t sequence ) { mSequences.push_back( sequence ); }
+
+		/**
+		 * Removes every leading occurrence of sequence, which must be the oldest in the list
+		 */
+		void PopFront( uint64_t sequence );
+
+		void Clear( ) { mSequences.clear( ); mHead = 0; }
+
+		size_t Size( ) const { return mSequences.size( ) - mHead; }
+		bool IsEmpty( ) const { return Size( ) == 0; }
+
+		uint64_t operator [] ( size_t idx ) const { return mSequences[mHead + idx]; }
+
+		const uint64_t* begin( ) const { return mSequences.data( ) + mHead; }
+		const uint64_t* end( ) const { return mSequences.data( ) + mSequences.size( ); }
+
+	private:
+		std::vector< uint64_t > mSequences;
+		size_t mHead = 0;
+	};
+
+	struct Entry
+	{
+		uint64_t					mSequence = 0;
+		AXLogging::LogLevel::E		mLogLevel = AXLogging::LogLevel::Info;
+		AXName						mTag;
+		const char*					mFile = "";
+		int							mLine = 0;
+		AXString					mMessage;
+	};
+
+	/**
+	 * The entries of a tag split by level, and whether the tag is shown
+	 */
+	struct TagIndex
+	{
+		SequenceList mEntries[AXLogging::LogLevel::MaxLogLevel];
+		bool mShow = true;
+	};
+
+	/**
+	 * Calls func with each lower case word of text, at most maxWords of them
+	 */
+	template< class F >
+	static void ForEachWord( const char* text, uint32_t maxWords, F func );
+
+	/**
+	 * Returns the key a word is stored under in the word index, the word up to its first digit. Numbers in messages are mostly
+	 * unique ids and would otherwise each add a key to the index, a search for one is verified against the full message
+	 */
+	static const AXString& WordIndexKey( const AXString& word, AXString& scratch );
+
+	/**
+	 * Adds an entry to the ring and the indexes, dropping the oldest entry if the ring is full
+	 */
+	void AddEntry( AXLogging::LogEntry& logEntry );
+
+	/**
+	 * Removes the oldest entry from the indexes
+	 */
+	void RemoveOldestEntry( );
+
+	/**
+	 * Returns true if any entries are hidden by the current filter, otherwise every entry is shown straight from the ring
+	 */
+	bool IsFiltering( ) const;
+
+	/**
+	 * Returns true if the entry passes the current filter
+	 */
+	bool PassesFilter( const Entry& entry ) const;
+
+	/**
+	 * Rebuilds the filtered entries after the filter changed, from whichever index gives the fewest candidates
+	 */
+	void RebuildFilteredEntries( );
+
+	/**
+	 * Removes every entry
+	 */
+	void Clear( );
+
+	Entry& EntryAt( uint64_t sequence ) { return mEntries[sequence % mEntries.size( )]; }
+	const Entry& EntryAt( uint64_t sequence ) const { return mEntries[sequence % mEntries.size( )]; }
+
+	/**
+	* A callback function to draw the log window
+	*/
+	void ImGuiLogWindowCallback( AXImGui::SystemDebugMenuItem& item );
+
+	/**
+	* Renders the IM gui log window
+	*/
+	void RenderImGuiLogWindow( );
+
+private:
+	std::shared_ptr< PendingEntries > mPending;
+
+	/**
+	 * Swapped with the pending entries each frame so neither side reallocates
+	 */
+	std::vector< AXLogging::LogEntry > mIncoming;
+
+	/**
+	 * The ring of entries, an entry lives at its sequence number modulo the size
+	 */
+	std::vector< Entry > mEntries;
+
+	/**
+	 * The sequence number of the oldest live entry and the next entry
+	 */
+	uint64_t mFirstSequence = 0;
+	uint64_t mNextSequence = 0;
+
+	std::unordered_map< AXName, TagIndex > mTagIndices;
+
+	/**
+	 * The entries containing each word
+	 */
+	std::unordered_map< AXString, SequenceList > mWordIndex;
+
+	/**
+	 * The words in the word index in order, so a prefix search is a range. Only changes when a word is first seen or forgotten
+	 */
+	std::set< AXString > mSortedWords;
+
+	/**
+	 * The entries passing the current filter, kept up to date as entries arrive and leave. Empty when not filtering
+	 */
+	SequenceList mFilteredEntries;
+
+	bool mShowLevel[AXLogging::LogLevel::MaxLogLevel] = { true, true, true };
+
+	char mSearchText[256] = { };
+
+	/**
+	 * The lower case words of the search text, an entry must have a word starting with each of them
+	 */
+	std::vector< AXString > mSearchTerms;
+
+	bool mAutoScroll = true;
+
+	/**
+	* If true the log ImGui window will render
+	*/
+	bool mShouldRenderImGuiLogWindow = false;
+
+	/**
+	 * Pointer to our loaded settings
+	 */
+	Settings* mSettings = nullptr;
+};
\ No newline at end of file
@@ -2,11 +2,136 @@
 
 #include "AXLogging.h"
 #include "AXApplication.h"
+#include "AXProfiler.h"
+#include "AX/Utils/AXSPSCRingBuffer.h"
 
+#if defined( AXPLATFORM_WINDOWS )
 #include <windows.h>
-#include <strstream>
+#endif // #if defined( AXPLATFORM_WINDOWS )
 
-AXString AXSystem< AXLogging >::sSystemName = "Logging";
+#include <signal.h>
+#include <exception>
+#include <chrono>
+#include <algorithm>
+
+template<> AXName AXSystem< AXLogging >::sSystemName = "Logging";
+
+/**
+* The largest number of entries delivered before the listeners are flushed and the delivery lock is released
+*/
+#define AXLOGGING_MAX_BATCH_SIZE 256
+
+/**
+* The smallest per thread deferred entry buffer
+*/
+#define AXLOGGING_MIN_THREAD_BUFFER_SIZE 4096
+
+/**
+* The instance flushed by the crash handlers
+*/
+AXLogging* AXLogging::sCrashFlushLogger = nullptr;
+
+/**
+* Copy of the level filter setting, refreshed every frame as the setting can be edited at runtime
+*/
+AXAtomic< uint8_t > AXLogging::sLevelFilter( AXLOG_LEVEL_INFO );
+
+/**
+* Nanoseconds per rate limit token, and the burst tolerance in nanoseconds
+*/
+AXAtomic< int64_t > AXLogging::sRateLimitInterval( 0 );
+AXAtomic< int64_t > AXLogging::sRateLimitTolerance( 0 );
+
+/**
+* Call sites with suppressed entries waiting to be reported
+*/
+AXAtomic< AXLogging::CallSite* > AXLogging::sSuppressedSites( nullptr );
+
+/**
+* Repeats of an entry are reported after this long even if the entry keeps repeating
+*/
+#define AXLOGGING_MAX_REPEAT_REPORT_DELAY_MS 1000
+
+/**
+* Suppressed entries from call sites that have gone quiet are reported this often
+*/
+#define AXLOGGING_SUPPRESSED_REPORT_INTERVAL_MS 1000
+
+/**
+* A thread's deferred entries. The thread writes and whoever holds the delivery lock reads. Owned jointly by the thread
+* and the logger, whichever lets go last deletes it
+*/
+class AXLoggingThreadBuffer
+{
+public:
+	enum State : uint8_t
+	{
+		Live,
+
+		/**
+		 * The thread has exited, the logger deletes the buffer once it is empty
+		 */
+		Retired,
+
+		/**
+		 * The logger has shut down, the thread deletes the buffer when it exits or next logs
+		 */
+		Orphaned,
+	};
+
+	AXLoggingThreadBuffer( AXLogging* logger, size_t capacity )
+		: mRing( capacity )
+		, mLogger( logger )
+	{
+
+	}
+
+	AXSPSCRingBuffer mRing;
+	AXLogging* mLogger;
+	AXAtomic< uint8_t > mState = Live;
+};
+
+namespace
+{
+	/**
+	* Set on the logger thread so entries logged by listeners are queued rather than delivered recursively
+	*/
+	static thread_local bool tIsLoggerThread = false;
+
+	static std::terminate_handler sPreviousTerminateHandler = nullptr;
+
+	/**
+	* The signals flushed on a crash, and whatever handled them before the logger did
+	*/
+	static const int sCrashSignals[ ] = { SIGABRT, SIGSEGV, SIGFPE, SIGILL };
+	static const size_t sNumCrashSignals = sizeof( sCrashSignals ) / sizeof( sCrashSignals[ 0 ] );
+	static void ( *sPreviousSignalHandlers[ sNumCrashSignals ] )( int ) = { };
+
+	/**
+	* Retires the thread's deferred entry buffer when the thread exits
+	*/
+	struct ThreadBufferOwner
+	{
+		~ThreadBufferOwner( )
+		{
+			Release( );
+		}
+
+		void Release( )
+		{
+			if( mBuffer && mBuffer->mState.exchange( AXLoggingThreadBuffer::Retired ) == AXLoggingThreadBuffer::Orphaned )
+			{
+				delete mBuffer;
+			}
+
+			mBuffer = nullptr;
+		}
+
+		AXLoggingThreadBuffer* mBuffer = nullptr;
+	};
+
+	static thread_local ThreadBufferOwner tThreadBuffer;
+}
 
 /**
 * Constructor
@@ -24,17 +149,156 @@ AXLogging::~AXLogging()
 	
 }
 
+/**
+* Initialise the system, called after settings are loaded
+*/
+AXLogging::InitResult AXLogging::OnInitialize( )
+{
+	Update( 0.0f );
+
+	if( mSettings && mSettings->mAsynchronous )
+	{
+		mQueue = new AXMPSCQueue< LogEntry >( AXUtils::Max( mSettings->mQueueSize.Val( ), 16u ) );
+		mStopLoggerThread = false;
+		mLoggerThread = new std::thread( &AXLogging::LoggerThreadFunc, this );
+
+		mDeferredFormatting = mSettings->mDeferredFormatting;
+	}
+
+	if( mSettings && !mSettings->mBinaryLogFile.Val( ).empty( ) )
+	{
+		RegisterNewListener< AXLogListener_BinaryFile >( mSettings->mBinaryLogFile.Val( ).c_str( ) );
+	}
+
+	if( mSettings && !mSettings->mLogFile.Val( ).empty( ) )
+	{
+		AXLogListener_RotatingFile::Params params;
+		params.mPath = mSettings->mLogFile.Val( );
+		params.mMaxFileSize = ( uint64_t )mSettings->mLogFileMaxSizeMB.Val( ) * 1024 * 1024;
+		params.mRotateIntervalSeconds = mSettings->mLogFileRotateMinutes.Val( ) * 60;
+		params.mMaxFiles = mSettings->mLogFileMaxFiles.Val( );
+		params.mFlushIntervalMs = mSettings->mLogFileFlushIntervalMs.Val( );
+
+		RegisterNewListener< AXLogListener_RotatingFile >( params );
+	}
+
+	sCrashFlushLogger = this;
+
+	for( size_t i = 0; i < sNumCrashSignals; ++i )
+	{
+		sPreviousSignalHandlers[ i ] = signal( sCrashSignals[ i ], &AXLogging::CrashSignalHandler );
+	}
+
+	sPreviousTerminateHandler = std::set_terminate( [ ]( )
+	{
+		if( sCrashFlushLogger )
+		{
+			sCrashFlushLogger->FlushFromCrash( );
+		}
+
+		if( sPreviousTerminateHandler )
+		{
+			sPreviousTerminateHandler( );
+		}
+
+		abort( );
+	} );
+
+	return AXLogging::InitResult::Initialized;
+}
+
 /**
 * Shutdown the system
 */
 void AXLogging::OnShutdown( )
 {
+	ReportSuppressed( );
+
+	mDeferredFormatting = false;
+
+	if( mLoggerThread )
+	{
+		mStopLoggerThread = true;
+		WakeLoggerThread( );
+
+		mLoggerThread->join( );
+		delete mLoggerThread;
+		mLoggerThread = nullptr;
+	}
+
+	// Anything logged after the thread stopped is still in the queue
+	LockDelivery( );
+	while( DrainQueue( ) ) { }
+	FlushListeners( );
+	ReleaseThreadBuffers( );
+	UnlockDelivery( );
+
+	sCrashFlushLogger = nullptr;
+	std::set_terminate( sPreviousTerminateHandler );
+
+	for( size_t i = 0; i < sNumCrashSignals; ++i )
+	{
+		signal( sCrashSignals[ i ], sPreviousSignalHandlers[ i ] == SIG_ERR ? SIG_DFL : sPreviousSignalHandlers[ i ] );
+	}
+
+	delete mQueue;
+	mQueue = nullptr;
+
  	for( auto listener : mListeners )
  	{
  		delete listener;
  	}
 	
 	mListeners.clear( );
+	mListenerCount = 0;
+}
+
+/**
+* Called once a frame to allow systems to update
+*/
+void AXLogging::Update( float dt )
+{
+	if( mSettings )
+	{
+		sLevelFilter.store( mSettings->mLogLevelFilter.Val( ), std::memory_order_relaxed );
+
+		const uint32_t perSecond( mSettings->mRateLimitPerSecond );
+		const int64_t interval( perSecond > 0 ? 1000000000ll / perSecond : 0 );
+
+		sRateLimitInterval.store( interval, std::memory_order_relaxed );
+		sRateLimitTolerance.store( interval * ( AXUtils::Max( mSettings->mRateLimitBurst.Val( ), 1u ) - 1 ), std::memory_order_relaxed );
+	}
+
+	const std::chrono::steady_clock::time_point now( std::chrono::steady_clock::now( ) );
+
+	if( now - mLastSuppressedReportTime >= std::chrono::milliseconds( AXLOGGING_SUPPRESSED_REPORT_INTERVAL_MS ) )
+	{
+		mLastSuppressedReportTime = now;
+		ReportSuppressed( );
+	}
+}
+
+/**
+* Blocks until every entry queued so far has been delivered, then flushes the listeners
+*/
+void AXLogging::Flush( )
+{
+	ReportSuppressed( );
+
+	if( AXLogging* logger = AXLogging::Get( ) )
+	{
+		if( tIsLoggerThread )
+		{
+			// Called from a listener, which already holds the delivery lock
+			logger->FlushListeners( );
+			return;
+		}
+
+		logger->LockDelivery( );
+		while( logger->DrainQueue( ) ) { }
+		logger->FlushListeners( );
+		logger->UnlockDelivery( );
+	}
 }
 
 /**
@@ -45,12 +309,571 @@ AXLogging* AXLogging::Get( )
 	return AXLogging::GetFrom( AXApplication::Get( ) );
 }
 
+/**
+* Queues an entry for the logger thread, or delivers it on the calling thread when logging is synchronous
+*/
+void AXLogging::Submit( LogEntry&& entry )
+{
+	if( mQueue && mLoggerThread )
+	{
+		if( mQueue->TryPush( std::move( entry ) ) )
+		{
+			WakeLoggerThread( );
+			return;
+		}
+
+		if( tIsLoggerThread )
+		{
+			// A listener logging while the queue is full, there is nobody else to make space
+			++mDroppedEntries;
+			return;
+		}
+
+		switch( mSettings ? ( OverflowPolicy::E )mSettings->mOverflowPolicy.Val( ) : OverflowPolicy::DrainOnCaller )
+		{
+		case OverflowPolicy::Block:
+			do
+			{
+				WakeLoggerThread( );
+				std::this_thread::yield( );
+			} while( !mQueue->TryPush( std::move( entry ) ) );
+			return;
+
+		case OverflowPolicy::Drop:
+			++mDroppedEntries;
+			return;
+
+		default:
+			break;
+		}
+	}
+
+	// Synchronous delivery, or draining on the caller, everything already queued goes first so order is preserved. A single
+	// DrainQueue only delivers one batch
+	LockDelivery( );
+
+	while( DrainQueue( ) ) { }
+	Deliver( entry );
+	EndListenerBatch( );
+
+	UnlockDelivery( );
+}
+
+/**
+* Reserves space for a deferred entry with argsSize bytes of arguments in the calling thread's buffer, returns nullptr if it is full
+*/
+AXLogging::DeferredHeader* AXLogging::BeginDeferredEntry( size_t argsSize )
+{
+	AXLoggingThreadBuffer* buffer( tThreadBuffer.mBuffer );
+
+	if( !buffer || buffer->mLogger != this || buffer->mState == AXLoggingThreadBuffer::Orphaned )
+	{
+		tThreadBuffer.Release( );
+
+		const size_t capacity( AXUtils::Max( ( size_t )mSettings->mThreadBufferSizeKB.Val( ) * 1024, ( size_t )AXLOGGING_MIN_THREAD_BUFFER_SIZE ) );
+		buffer = new AXLoggingThreadBuffer( this, capacity );
+
+		LockThreadBuffers( );
+		mThreadBuffers.push_back( buffer );
+		UnlockThreadBuffers( );
+
+		tThreadBuffer.mBuffer = buffer;
+	}
+
+	static_assert( sizeof( DeferredHeader ) % 8 == 0, "Deferred entry arguments should stay 8 byte aligned" );
+
+	if( uint8_t* record = buffer->mRing.BeginWrite( sizeof( DeferredHeader ) + argsSize ) )
+	{
+		return reinterpret_cast< DeferredHeader* >( record );
+	}
+
+	WakeLoggerThread( );
+	return nullptr;
+}
+
+/**
+* Publishes the entry reserved by the last BeginDeferredEntry on this thread
+*/
+void AXLogging::EndDeferredEntry( )
+{
+	tThreadBuffer.mBuffer->mRing.EndWrite( );
+	WakeLoggerThread( );
+}
+
+/**
+* Hands up to maxEntries deferred entries from every thread's buffer to the listeners, must hold the delivery lock.
+* Returns the number delivered
+*/
+uint32_t AXLogging::DrainThreadBuffers( uint32_t maxEntries )
+{
+	LockThreadBuffers( );
+	mDrainThreadBuffers = mThreadBuffers;
+	UnlockThreadBuffers( );
+
+	uint32_t numDelivered( 0 );
+
+	for( AXLoggingThreadBuffer* buffer : mDrainThreadBuffers )
+	{
+		size_t size( 0 );
+
+		while( numDelivered < maxEntries )
+		{
+			const uint8_t* record( buffer->mRing.BeginRead( size ) );
+
+			if( !record )
+			{
+				break;
+			}
+
+			DeliverDeferred( *reinterpret_cast< const DeferredHeader* >( record ), record + sizeof( DeferredHeader ), ( uint32_t )( size - sizeof( DeferredHeader ) ) );
+			buffer->mRing.EndRead( );
+
+			++numDelivered;
+		}
+
+		// A retired thread never writes again, so once it is empty it can go
+		if( buffer->mState == AXLoggingThreadBuffer::Retired && buffer->mRing.IsEmpty( ) )
+		{
+			LockThreadBuffers( );
+			mThreadBuffers.erase( std::find( mThreadBuffers.begin( ), mThreadBuffers.end( ), buffer ) );
+			UnlockThreadBuffers( );
+
+			delete buffer;
+		}
+	}
+
+	return numDelivered;
+}
+
+/**
+* Hands a deferred entry to every listener, formatting it once for the listeners that want text. Must hold the delivery lock
+*/
+void AXLogging::DeliverDeferred( const DeferredHeader& header, const uint8_t* args, uint32_t argsSize )
+{
+	if( CollapseRepeat( header.mLogLevel, header.mTag, header.mFile, header.mLine, true, &header.mFormat, sizeof( header.mFormat ), args, argsSize ) )
+	{
+		return;
+	}
+
+	BinaryLogEntry binaryEntry;
+	binaryEntry.mLogLevel = header.mLogLevel;
+	binaryEntry.mTag = header.mTag;
+	binaryEntry.mFormat = header.mFormat;
+	binaryEntry.mFile = header.mFile;
+	binaryEntry.mLine = header.mLine;
+	binaryEntry.mArgs = args;
+	binaryEntry.mArgsSize = argsSize;
+
+	bool formatted( false );
+
+	for( auto listener : mListeners )
+	{
+		if( listener->WantsBinary( ) )
+		{
+			listener->LogBinary( binaryEntry );
+			continue;
+		}
+
+		if( !formatted )
+		{
+			mDeferredTextEntry.mLogLevel = header.mLogLevel;
+			mDeferredTextEntry.mTag = header.mTag;
+			mDeferredTextEntry.mFile = header.mFile;
+			mDeferredTextEntry.mLine = header.mLine;
+			binaryEntry.FormatMessage( mDeferredTextEntry.mMessage );
+
+			formatted = true;
+		}
+
+		listener->Log( mDeferredTextEntry );
+	}
+}
+
+/**
+* Retires every thread's buffer, deleting those whose threads have already exited
+*/
+void AXLogging::ReleaseThreadBuffers( )
+{
+	LockThreadBuffers( );
+
+	for( AXLoggingThreadBuffer* buffer : mThreadBuffers )
+	{
+		if( buffer->mState.exchange( AXLoggingThreadBuffer::Orphaned ) == AXLoggingThreadBuffer::Retired )
+		{
+			delete buffer;
+		}
+	}
+
+	mThreadBuffers.clear( );
+
+	UnlockThreadBuffers( );
+}
+
+/**
+* Hands every queued entry to the listeners, must hold the delivery lock. Returns true if anything was delivered
+*/
+bool AXLogging::DrainQueue( )
+{
+	// Deferred entries are drained first as a full thread buffer falls back to the queue. Across threads the order is only approximate
+	bool delivered( DrainThreadBuffers( AXLOGGING_MAX_BATCH_SIZE ) > 0 );
+	LogEntry entry;
+
+	for( uint32_t i( 0 ); mQueue && i < AXLOGGING_MAX_BATCH_SIZE && mQueue->TryPop( entry ); ++i )
+	{
+		Deliver( entry );
+		delivered = true;
+	}
+
+	if( const uint32_t numDropped = mDroppedEntries.exchange( 0 ) )
+	{
+		LogEntry droppedEntry;
+		droppedEntry.mLogLevel = LogLevel::Warning;
+		droppedEntry.mTag = "Logging";
+		droppedEntry.mFile = __FILE__;
+		droppedEntry.mLine = __LINE__;
+		droppedEntry.mMessage = AXUtils::FormatString( "Dropped %u log entries, the log queue was full.", numDropped );
+
+		Deliver( droppedEntry );
+		delivered = true;
+	}
+
+	return delivered;
+}
+
+/**
+* Hands an entry to every listener unless it repeats the last one, must hold the delivery lock
+*/
+void AXLogging::Deliver( const LogEntry& entry )
+{
+	if( !CollapseRepeat( entry.mLogLevel, entry.mTag, entry.mFile, entry.mLine, false, entry.mMessage.c_str( ), entry.mMessage.size( ) ) )
+	{
+		DeliverToListeners( entry );
+	}
+}
+
+/**
+* Hands an entry to every listener, must hold the delivery lock
+*/
+void AXLogging::DeliverToListeners( const LogEntry& entry )
+{
+	for( auto listener : mListeners )
+	{
+		listener->Log( entry );
+	}
+}
+
+/**
+* Returns true if the entry is identical to the last one delivered and should be skipped. Otherwise reports any
+* pending repeats of the last entry and remembers this one. Must hold the delivery lock
+*/
+bool AXLogging::CollapseRepeat( LogLevel::E level, const AXName& tag, const char* file, int line, bool isDeferred, const void* content, size_t contentSize, const void* extraContent, size_t extraContentSize )
+{
+	if( !mSettings || !mSettings->mCollapseRepeats )
+	{
+		return false;
+	}
+
+	RepeatState& state( mRepeatState );
+
+	const bool isRepeat( state.mFile == file && state.mLine == line && state.mLogLevel == level && state.mTag == tag && state.mIsDeferred == isDeferred &&
+		state.mContent.size( ) == contentSize + extraContentSize &&
+		memcmp( state.mContent.data( ), content, contentSize ) == 0 &&
+		( extraContentSize == 0 || memcmp( state.mContent.data( ) + contentSize, extraContent, extraContentSize ) == 0 ) );
+
+	if( isRepeat )
+	{
+		if( state.mNumRepeats++ == 0 )
+		{
+			state.mFirstRepeatTime = std::chrono::steady_clock::now( );
+		}
+
+		return true;
+	}
+
+	ReportRepeats( );
+
+	state.mLogLevel = level;
+	state.mTag = tag;
+	state.mFile = file;
+	state.mLine = line;
+	state.mIsDeferred = isDeferred;
+	state.mContent.assign( static_cast< const char* >( content ), contentSize );
+	state.mContent.append( static_cast< const char* >( extraContent ), extraContentSize );
+
+	return false;
+}
+
+/**
+* Delivers a summary of the repeats of the last entry, if there were any. Must hold the delivery lock
+*/
+void AXLogging::ReportRepeats( )
+{
+	if( mRepeatState.mNumRepeats == 0 )
+	{
+		return;
+	}
+
+	LogEntry repeatEntry;
+	repeatEntry.mLogLevel = mRepeatState.mLogLevel;
+	repeatEntry.mTag = mRepeatState.mTag;
+	repeatEntry.mFile = mRepeatState.mFile;
+	repeatEntry.mLine = mRepeatState.mLine;
+	repeatEntry.mMessage = AXUtils::FormatString( "Previous message repeated %u times", mRepeatState.mNumRepeats );
+
+	mRepeatState.mNumRepeats = 0;
+
+	DeliverToListeners( repeatEntry );
+}
+
+/**
+* Flushes every listener, must hold the delivery lock
+*/
+void AXLogging::FlushListeners( )
+{
+	ReportRepeats( );
+
+	for( auto listener : mListeners )
+	{
+		listener->Flush( );
+	}
+}
+
+/**
+* Tells every listener a batch has been delivered, must hold the delivery lock
+*/
+void AXLogging::EndListenerBatch( )
+{
+	// Repeats are reported once the run ends, or periodically if it never does
+	if( mRepeatState.mNumRepeats > 0 &&
+		std::chrono::steady_clock::now( ) - mRepeatState.mFirstRepeatTime >= std::chrono::milliseconds( AXLOGGING_MAX_REPEAT_REPORT_DELAY_MS ) )
+	{
+		ReportRepeats( );
+	}
+
+	for( auto listener : mListeners )
+	{
+		listener->OnBatchEnd( );
+	}
+}
+
+/**
+* Wakes the logger thread if it is waiting for entries
+*/
+void AXLogging::WakeLoggerThread( )
+{
+	if( mLoggerThreadWaiting )
+	{
+		mWakeCondition.notify_one( );
+	}
+}
+
+/**
+* Drains the queue in batches until asked to stop
+*/
+void AXLogging::LoggerThreadFunc( )
+{
+	tIsLoggerThread = true;
+
+	AXProfiler::SetThreadName( "Logger" );
+
+	while( true )
+	{
+		const bool stopping( mStopLoggerThread );
+
+		LockDelivery( );
+		const bool delivered( DrainQueue( ) );
+
+		// Also called while idle, so listeners that flush on a timer get the chance to
+		EndListenerBatch( );
+
+		UnlockDelivery( );
+
+		if( !delivered )
+		{
+			if( stopping )
+			{
+				break;
+			}
+
+			// An entry pushed just before the flag is set is picked up by the timeout rather than a notify
+			std::unique_lock< std::mutex > lock( mWakeMutex );
+			mLoggerThreadWaiting = true;
+			mWakeCondition.wait_for( lock, std::chrono::milliseconds( 10 ) );
+			mLoggerThreadWaiting = false;
+		}
+	}
+
+	tIsLoggerThread = false;
+}
+
+void AXLogging::LockDelivery( )
+{
+	bool expected( false );
+
+	do
+	{
+		expected = false;
+	} while( !mDeliveryLocked.compare_exchange_weak( expected, true ) );
+}
+
+bool AXLogging::TryLockDelivery( uint32_t maxSpins )
+{
+	for( uint32_t i( 0 ); i < maxSpins; ++i )
+	{
+		bool expected( false );
+
+		if( mDeliveryLocked.compare_exchange_weak( expected, true ) )
+		{
+			return true;
+		}
+
+		std::this_thread::yield( );
+	}
+
+	return false;
+}
+
+void AXLogging::UnlockDelivery( )
+{
+	mDeliveryLocked = false;
+}
+
+void AXLogging::LockThreadBuffers( )
+{
+	bool expected( false );
+
+	do
+	{
+		expected = false;
+	} while( !mThreadBuffersLocked.compare_exchange_weak( expected, true ) );
+}
+
+void AXLogging::UnlockThreadBuffers( )
+{
+	mThreadBuffersLocked = false;
+}
+
+/**
+* Delivers whatever is queued when the process is about to die, then re-raises the signal to the handler it replaced
+*/
+void AXLogging::CrashSignalHandler( int signal )
+{
+	if( sCrashFlushLogger )
+	{
+		sCrashFlushLogger->FlushFromCrash( );
+	}
+
+	void ( *previous )( int ) = SIG_DFL;
+
+	for( size_t i = 0; i < sNumCrashSignals; ++i )
+	{
+		if( sCrashSignals[ i ] == signal && sPreviousSignalHandlers[ i ] != SIG_ERR )
+		{
+			previous = sPreviousSignalHandlers[ i ];
+		}
+	}
+
+	::signal( signal, previous );
+	raise( signal );
+}
+
+/**
+* Best effort flush on the crashing thread, gives up on the delivery lock rather than deadlocking
+*/
+void AXLogging::FlushFromCrash( )
+{
+	// The crash may have happened inside a listener while the lock was held, in which case delivering again could recurse
+	if( !tIsLoggerThread && TryLockDelivery( 1000 ) )
+	{
+		while( DrainQueue( ) ) { }
+
+		FlushListeners( );
+		UnlockDelivery( );
+	}
+}
+
+/**
+* Takes a token, returns false if the call site is over its rate limit. Called before the arguments are evaluated
+*/
+bool AXLogging::CallSite::Allow( )
+{
+	const int64_t interval( sRateLimitInterval.load( std::memory_order_relaxed ) );
+
+	if( interval == 0 || mLogLevel == LogLevel::Error )
+	{
+		return true;
+	}
+
+	const int64_t tolerance( sRateLimitTolerance.load( std::memory_order_relaxed ) );
+	const int64_t now( std::chrono::duration_cast< std::chrono::nanoseconds >( std::chrono::steady_clock::now( ).time_since_epoch( ) ).count( ) );
+
+	int64_t bucketFullTime( mBucketFullTime.load( std::memory_order_relaxed ) );
+	int64_t newBucketFullTime( 0 );
+
+	do
+	{
+		const int64_t start( AXUtils::Max( bucketFullTime, now ) );
+
+		if( start - now > tolerance )
+		{
+			++mNumSuppressed;
+
+			// Queue the call site so the count is reported even if it never gets another token
+			if( !mQueued.exchange( true ) )
+			{
+				CallSite* head( sSuppressedSites.load( ) );
+
+				do
+				{
+					mNextSuppressed = head;
+				} while( !sSuppressedSites.compare_exchange_weak( head, this ) );
+			}
+
+			return false;
+		}
+
+		newBucketFullTime = start + interval;
+	} while( !mBucketFullTime.compare_exchange_weak( bucketFullTime, newBucketFullTime, std::memory_order_relaxed ) );
+
+	ReportSuppressed( );
+
+	return true;
+}
+
+/**
+* Logs the number of entries suppressed since the last report, if any
+*/
+void AXLogging::CallSite::ReportSuppressed( )
+{
+	if( const uint32_t numSuppressed = mNumSuppressed.exchange( 0 ) )
+	{
+		Log_Internal( mLogLevel, mTag, mFile, mLine, "Suppressed %u messages from this call site, it is over its rate limit", numSuppressed );
+	}
+}
+
+/**
+* Logs the counts of every call site with suppressed entries that haven't been reported yet
+*/
+void AXLogging::ReportSuppressed( )
+{
+	CallSite* site( sSuppressedSites.exchange( nullptr ) );
+
+	while( site )
+	{
+		// Read the link before clearing mQueued, after which the call site may push itself again
+		CallSite* next( site->mNextSuppressed );
+		site->mQueued = false;
+		site->ReportSuppressed( );
+		site = next;
+	}
+}
+
 /**
 * Override to register a settings object for this system
 */
 void AXLogging::CreateEngineSettings( class AXSettingsFile& settings )
 {
-	mSettings = settings.RegisterNewItem< AXLogging::Settings >( AXLogging::StaticName( ) );
+	mSettings = settings.RegisterNewItem< AXLogging::Settings >( AXLogging::StaticName( ).GetString( ) );
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -63,11 +886,347 @@ void AXLogging::CreateEngineSettings( class AXSettingsFile& settings )
 */
 void AXLogListener_ConsoleOutput::Log( const AXLogging::LogEntry& entry )
 {
-	printf( AXUtils::FormatString( "[%-8s] [%-16s] %s (%s : %d) \n",
+	printf( "[%-8s] [%-16s] %s (%s : %d) \n",
 		AXLogging::LogLevel::ToString( entry.mLogLevel ).c_str( ),
 		entry.mTag.c_str( ),
 		entry.mMessage.c_str( ),
-		entry.mFile.c_str( ),
-		entry.mLine ).c_str( ) );
+		entry.mFile,
+		entry.mLine );
+}
+
+/**
+* Override to flush any buffered output, called when the log is flushed and by default after every batch of entries
+*/
+void AXLogListener_ConsoleOutput::Flush( )
+{
 	fflush( stdout );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+* Constructor, opens the file for writing, replacing any existing file
+*/
+AXLogListener_BinaryFile::AXLogListener_BinaryFile( const char* path )
+{
+	mFile = AXUtils::OpenFile( path, "wb" );
+
+	if( mFile )
+	{
+		setvbuf( mFile, nullptr, _IOFBF, 1 << 20 );
+
+		WriteValue( ( uint32_t )AXBINARYLOG_FILE_MAGIC );
+		WriteValue( ( uint32_t )AXBINARYLOG_FILE_VERSION );
+	}
+}
+
+/**
+* Destructor
+*/
+AXLogListener_BinaryFile::~AXLogListener_BinaryFile( )
+{
+	if( mFile )
+	{
+		fclose( mFile );
+	}
+}
+
+/**
+* Override to handle a log entry
+*/
+void AXLogListener_BinaryFile::Log( const AXLogging::LogEntry& entry )
+{
+	if( !mFile )
+	{
+		return;
+	}
+
+	const uint64_t tagId( StringId( entry.mTag.c_str( ) ) );
+	const uint64_t fileId( StringId( entry.mFile ) );
+
+	WriteValue( AXBinaryLog::RecordType::Formatted );
+	WriteValue( ( uint8_t )entry.mLogLevel );
+	WriteValue( tagId );
+	WriteValue( fileId );
+	WriteValue( ( int32_t )entry.mLine );
+	WriteValue( ( uint32_t )entry.mMessage.size( ) );
+	Write( entry.mMessage.c_str( ), entry.mMessage.size( ) );
+}
+
+/**
+* Override to handle a deferred log entry
+*/
+void AXLogListener_BinaryFile::LogBinary( const AXLogging::BinaryLogEntry& entry )
+{
+	if( !mFile )
+	{
+		return;
+	}
+
+	const uint64_t tagId( StringId( entry.mTag.c_str( ) ) );
+	const uint64_t formatId( StringId( entry.mFormat ) );
+	const uint64_t fileId( StringId( entry.mFile ) );
+
+	WriteValue( AXBinaryLog::RecordType::Deferred );
+	WriteValue( ( uint8_t )entry.mLogLevel );
+	WriteValue( tagId );
+	WriteValue( formatId );
+	WriteValue( fileId );
+	WriteValue( ( int32_t )entry.mLine );
+	WriteValue( entry.mArgsSize );
+	Write( entry.mArgs, entry.mArgsSize );
+}
+
+/**
+* Override to flush any buffered output, called when the log is flushed and by default after every batch of entries
+*/
+void AXLogListener_BinaryFile::Flush( )
+{
+	if( mFile )
+	{
+		fflush( mFile );
+	}
+}
+
+/**
+* Writes a string definition record the first time a string is seen, then returns its id
+*/
+uint64_t AXLogListener_BinaryFile::StringId( const char* str )
+{
+	const uint64_t id( ( uint64_t )( uintptr_t )str );
+
+	if( mDefinedStrings.insert( str ).second )
+	{
+		const uint32_t length( ( uint32_t )strlen( str ) );
+
+		WriteValue( AXBinaryLog::RecordType::String );
+		WriteValue( id );
+		WriteValue( length );
+		Write( str, length );
+	}
+
+	return id;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+* Constructor, moves any existing log files along and opens a new one
+*/
+AXLogListener_RotatingFile::AXLogListener_RotatingFile( const Params& params )
+	: mParams( params )
+{
+	mParams.mBufferSize = AXUtils::Max( mParams.mBufferSize, ( size_t )4096 );
+	mBuffer = static_cast< char* >( malloc( mParams.mBufferSize ) );
+
+	ShiftFiles( );
+	OpenFile( );
+}
+
+/**
+* Destructor
+*/
+AXLogListener_RotatingFile::~AXLogListener_RotatingFile( )
+{
+	WriteBuffer( );
+
+	if( mFile )
+	{
+		fclose( mFile );
+	}
+
+	free( mBuffer );
+}
+
+/**
+* Override to handle a log entry
+*/
+void AXLogListener_RotatingFile::Log( const AXLogging::LogEntry& entry )
+{
+	if( !mFile )
+	{
+		return;
+	}
+
+	if( mParams.mMaxFileSize > 0 && mFileSize >= mParams.mMaxFileSize )
+	{
+		Rotate( );
+	}
+
+	const size_t remaining( mParams.mBufferSize - mBufferUsed );
+	const int length( FormatEntry( mBuffer + mBufferUsed, remaining, entry ) );
+
+	if( length < 0 )
+	{
+		return;
+	}
+
+	if( ( size_t )length < remaining )
+	{
+		mBufferUsed += length;
+	}
+	else
+	{
+		WriteBuffer( );
+
+		if( ( size_t )length < mParams.mBufferSize )
+		{
+			mBufferUsed = FormatEntry( mBuffer, mParams.mBufferSize, entry );
+		}
+		else
+		{
+			// Larger than the whole buffer, written straight to the file
+			AXString line( length, '\0' );
+			FormatEntry( &line[0], line.size( ) + 1, entry );
+			fwrite( line.c_str( ), 1, line.size( ), mFile );
+		}
+	}
+
+	mFileSize += length;
+
+	if( entry.mLogLevel == AXLogging::LogLevel::Error )
+	{
+		mWritePending = true;
+	}
+}
+
+/**
+* Override to flush any buffered output, called when the log is flushed
+*/
+void AXLogListener_RotatingFile::Flush( )
+{
+	WriteBuffer( );
+
+	if( mFile )
+	{
+		fflush( mFile );
+	}
+}
+
+/**
+* Override to write the buffer out if an error was logged or the flush interval has passed, and to rotate by age
+*/
+void AXLogListener_RotatingFile::OnBatchEnd( )
+{
+	if( !mFile )
+	{
+		return;
+	}
+
+	const Clock::time_point now( Clock::now( ) );
+
+	if( mParams.mRotateIntervalSeconds > 0 && mFileSize > 0 && now - mFileOpenTime >= std::chrono::seconds( mParams.mRotateIntervalSeconds ) )
+	{
+		Rotate( );
+	}
+	else if( mBufferUsed > 0 && ( mWritePending || now - mLastWriteTime >= std::chrono::milliseconds( mParams.mFlushIntervalMs ) ) )
+	{
+		WriteBuffer( );
+	}
+}
+
+/**
+* Formats an entry into out, returns the length it needed in the same way as snprintf
+*/
+int AXLogListener_RotatingFile::FormatEntry( char* out, size_t size, const AXLogging::LogEntry& entry )
+{
+	return snprintf( out, size, "[%-8s] [%-16s] %s (%s : %d) \n",
+		AXLogging::LogLevel::ToString( entry.mLogLevel ).c_str( ),
+		entry.mTag.c_str( ),
+		entry.mMessage.c_str( ),
+		entry.mFile,
+		entry.mLine );
+}
+
+/**
+* Writes the buffer to the file
+*/
+void AXLogListener_RotatingFile::WriteBuffer( )
+{
+	if( mFile && mBufferUsed > 0 )
+	{
+		AXPROFILE_SCOPE( "File Write" );
+		fwrite( mBuffer, 1, mBufferUsed, mFile );
+	}
+
+	mBufferUsed = 0;
+	mWritePending = false;
+	mLastWriteTime = Clock::now( );
+}
+
+/**
+* Closes the current file, moves the existing files along and opens a new one
+*/
+void AXLogListener_RotatingFile::Rotate( )
+{
+	WriteBuffer( );
+
+	if( mFile )
+	{
+		fclose( mFile );
+		mFile = nullptr;
+	}
+
+	ShiftFiles( );
+	OpenFile( );
+}
+
+/**
+* Renames every existing file to the next index, removing the oldest
+*/
+void AXLogListener_RotatingFile::ShiftFiles( ) const
+{
+	if( mParams.mMaxFiles <= 1 )
+	{
+		return;
+	}
+
+	// Failures are expected here as most of the files won't exist yet
+	remove( RotatedPath( mParams.mMaxFiles - 1 ).c_str( ) );
+
+	for( uint32_t i( mParams.mMaxFiles - 1 ); i > 0; --i )
+	{
+		rename( RotatedPath( i - 1 ).c_str( ), RotatedPath( i ).c_str( ) );
+	}
+}
+
+/**
+* Opens a new current file
+*/
+void AXLogListener_RotatingFile::OpenFile( )
+{
+	mFile = AXUtils::OpenFile( mParams.mPath.c_str( ), "w" );
+
+	if( mFile )
+	{
+		// Everything is buffered by the listener, so stdio's buffer would only add a copy
+		setvbuf( mFile, nullptr, _IONBF, 0 );
+	}
+
+	mFileSize = 0;
+	mFileOpenTime = Clock::now( );
+	mLastWriteTime = mFileOpenTime;
+}
+
+/**
+* Returns the path of the file at a rotation index, 0 being the current file
+*/
+AXString AXLogListener_RotatingFile::RotatedPath( uint32_t idx ) const
+{
+	if( idx == 0 )
+	{
+		return mParams.mPath;
+	}
+
+	const size_t lastSeparator( mParams.mPath.find_last_of( "/\\" ) );
+	size_t extension( mParams.mPath.find_last_of( '.' ) );
+
+	if( extension == AXString::npos || ( lastSeparator != AXString::npos && extension < lastSeparator ) )
+	{
+		extension = mParams.mPath.size( );
+	}
+
+	return AXUtils::FormatString( "%s.%u%s", mParams.mPath.substr( 0, extension ).c_str( ), idx, mParams.mPath.c_str( ) + extension );
 }
\ No newline at end of file
@@ -4,13 +4,85 @@
 
 #include <stdio.h>
 #include <list>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
 #include "AX/Utils/AXString.h"
+#include "AX/Utils/AXName.h"
 
 #include "AX/Utils/AXUtils.h"
 #include "AX/Core/AXSystem.h"
 #include "AXSettings.h"
 #include "AX/Utils/AXParent.h"
 #include "AX/Utils/AXInterface.h"
+#include "AX/Utils/AXMPSCQueue.h"
+#include "AX/Utils/AXThreadingPrimitives.h"
+#include "AX/Core/AXBinaryLog.h"
+
+#include <vector>
+#include <unordered_set>
+
+/**
+ * Log levels usable from the preprocessor, must match AXLogging::LogLevel. AXLOG_LEVEL_NONE strips every level
+ */
+#define AXLOG_LEVEL_INFO 0
+#define AXLOG_LEVEL_WARNING 1
+#define AXLOG_LEVEL_ERROR 2
+#define AXLOG_LEVEL_NONE 3
+
+/**
+ * Calls below this level compile to nothing, their arguments are never evaluated
+ */
+#if !defined( AXLOG_MIN_LEVEL )
+#define AXLOG_MIN_LEVEL AXLOG_LEVEL_INFO
+#endif
+
+/**
+ * Per tag minimum levels, a comma separated list of { "Tag", AXLOG_LEVEL_X } pairs. Calls with a listed tag below its level
+ * compile to nothing, AXLOG_LEVEL_NONE strips the tag entirely. The global AXLOG_MIN_LEVEL still applies
+ */
+#if !defined( AXLOG_TAG_MIN_LEVELS )
+#define AXLOG_TAG_MIN_LEVELS
+#endif
+
+class AXLoggingThreadBuffer;
+
+namespace AXLogCompileTime
+{
+	struct TagLevel
+	{
+		const char* mTag;
+		uint8_t mMinLevel;
+	};
+
+	/**
+	 * The first entry never matches a real tag, it is there so the list is never empty
+	 */
+	constexpr TagLevel sTagMinLevels[] = { { "", AXLOG_LEVEL_INFO }, AXLOG_TAG_MIN_LEVELS };
+
+	constexpr size_t NumTagMinLevels = sizeof( sTagMinLevels ) / sizeof( sTagMinLevels[0] );
+
+	constexpr bool StringsEqual( const char* a, const char* b )
+	{
+		return *a == *b && ( *a == '\0' || StringsEqual( a + 1, b + 1 ) );
+	}
+
+	constexpr uint8_t MinLevelForTag( const char* tag, size_t idx = 1 )
+	{
+		return idx >= NumTagMinLevels ? ( uint8_t )AXLOG_MIN_LEVEL :
+			StringsEqual( sTagMinLevels[idx].mTag, tag ) ? ( sTagMinLevels[idx].mMinLevel > AXLOG_MIN_LEVEL ? sTagMinLevels[idx].mMinLevel : ( uint8_t )AXLOG_MIN_LEVEL ) :
+			MinLevelForTag( tag, idx + 1 );
+	}
+
+	/**
+	 * Returns true if a call with this level and tag is compiled in, tag must be a string literal
+	 */
+	constexpr bool IsCompiledIn( uint8_t level, const char* tag )
+	{
+		return level >= MinLevelForTag( tag );
+	}
+}
 
 class AXLogging : public AXParent< AXSystem< AXLogging >, AXLogging >
 {
@@ -35,23 +107,103 @@ public:
 		}
 	};
 
+	static_assert( LogLevel::Info == AXLOG_LEVEL_INFO && LogLevel::Warning == AXLOG_LEVEL_WARNING && LogLevel::Error == AXLOG_LEVEL_ERROR && LogLevel::MaxLogLevel == AXLOG_LEVEL_NONE,
+		"The preprocessor log levels must match LogLevel" );
+
+	/**
+	 * What a producer does when the asynchronous queue is full
+	 */
+	struct OverflowPolicy
+	{
+		enum E : uint8_t
+		{
+			/**
+			 * Wait for the logger thread to make space
+			 */
+			Block,
+
+			/**
+			 * Discard the entry, the number of dropped entries is reported once the logger catches up
+			 */
+			Drop,
+
+			/**
+			 * Deliver the queued entries and this one on the calling thread, never loses entries or reorders them
+			 */
+			DrainOnCaller,
+
+			MaxOverflowPolicy,
+		};
+
+		static const AXString& ToString( E val )
+		{
+			static AXString strings[MaxOverflowPolicy] = { "Block", "Drop", "Drain On Caller" };
+			return strings[val];
+		}
+	};
 
 	struct LogEntry
 	{
-		LogLevel::E		mLogLevel;
-		AXString		mTag;
+		LogLevel::E		mLogLevel = LogLevel::Info;
+		AXName			mTag;
 		AXString		mMessage;
-		AXString		mFile;
-		int				mLine;
+		const char*		mFile = "";
+		int				mLine = 0;
+	};
+
+	/**
+	 * A log entry whose arguments haven't been formatted yet, only valid for the duration of the LogBinary call
+	 */
+	struct BinaryLogEntry
+	{
+		LogLevel::E		mLogLevel = LogLevel::Info;
+		AXName			mTag;
+		const char*		mFormat = "";
+		const char*		mFile = "";
+		int				mLine = 0;
+		const uint8_t*	mArgs = nullptr;
+		uint32_t		mArgsSize = 0;
+
+		/**
+		 * Formats the message, see AXBinaryLog::FormatMessage
+		 */
+		void FormatMessage( AXString& out ) const { AXBinaryLog::FormatMessage( mFormat, mArgs, mArgsSize, out ); }
 	};
 
 	class AXILogListener : public AXInterface< AXILogListener >
 	{
 	public:
 		/**
-		 * Override to handle a log entry
+		 * Destructor, listeners are deleted by the logging system
+		 */
+		virtual ~AXILogListener( ) { }
+
+		/**
+		 * Override to handle a log entry, always called from one thread at a time
 		 */
 		virtual void Log( const LogEntry& entry ) = 0;
+
+		/**
+		 * Override to return true to receive deferred entries through LogBinary rather than formatted through Log. Entries
+		 * that were formatted at the call site still arrive through Log
+		 */
+		virtual bool WantsBinary( ) const { return false; }
+
+		/**
+		 * Override to handle a deferred log entry, only called if WantsBinary returns true
+		 */
+		virtual void LogBinary( const BinaryLogEntry& entry ) { }
+
+		/**
+		 * Override to flush any buffered output, called when the log is flushed and by default after every batch of entries
+		 */
+		virtual void Flush( ) { }
+
+		/**
+		 * Called after every batch of entries, and periodically while the logger thread is idle. Override to flush on a
+		 * schedule rather than after every batch
+		 */
+		virtual void OnBatchEnd( ) { Flush( ); }
 	};
 
 	class Settings : public AXSettingsFile::SettingsItem
@@ -73,6 +225,41 @@ public:
 			RegisterProperty( mLogLevelFilter, "Log Level" ).DisplayAsDropDown( ddCollection );
 
 			RegisterProperty( mCrashOnError, "Crash On Error" );
+
+			RegisterProperty( mAsynchronous, "Asynchronous" );
+
+			RegisterProperty( mQueueSize, "Queue Size" );
+
+			AXProperty< uint8_t >::MetaType::DropDownOptionsCollection overflowCollection;
+
+			for( uint8_t i( 0 ); i < OverflowPolicy::MaxOverflowPolicy; ++i )
+			{
+				overflowCollection.push_back( AXProperty< uint8_t >::MetaType::DropDownOptionsCollectionEntry( i, OverflowPolicy::ToString( ( OverflowPolicy::E )i ) ) );
+			}
+
+			RegisterProperty( mOverflowPolicy, "Overflow Policy" ).DisplayAsDropDown( overflowCollection );
+
+			RegisterProperty( mDeferredFormatting, "Deferred Formatting" );
+
+			RegisterProperty( mThreadBufferSizeKB, "Thread Buffer Size KB" );
+
+			RegisterProperty( mBinaryLogFile, "Binary Log File" );
+
+			RegisterProperty( mLogFile, "Log File" );
+
+			RegisterProperty( mLogFileMaxSizeMB, "Log File Max Size MB" );
+
+			RegisterProperty( mLogFileRotateMinutes, "Log File Rotate Minutes" );
+
+			RegisterProperty( mLogFileMaxFiles, "Log File Max Files" );
+
+			RegisterProperty( mLogFileFlushIntervalMs, "Log File Flush Interval Ms" );
+
+			RegisterProperty( mRateLimitPerSecond, "Rate Limit Per Second" );
+
+			RegisterProperty( mRateLimitBurst, "Rate Limit Burst" );
+
+			RegisterProperty( mCollapseRepeats, "Collapse Repeats" );
 		}
 
 	public:
@@ -85,6 +272,131 @@ public:
 		 * If true when a AXERROR occurs the game will crash
 		 */
 		AXProperty< bool > mCrashOnError = false;
+
+		/**
+		 * If true entries are delivered to listeners on a dedicated logger thread, applied on initialise
+		 */
+		AXProperty< bool > mAsynchronous = true;
+
+		/**
+		 * The number of entries the asynchronous queue can hold, rounded up to a power of two, applied on initialise
+		 */
+		AXProperty< uint32_t > mQueueSize = 8192;
+
+		/**
+		 * What to do when the asynchronous queue is full, see OverflowPolicy
+		 */
+		AXProperty< uint8_t > mOverflowPolicy = OverflowPolicy::DrainOnCaller;
+
+		/**
+		 * If true and logging is asynchronous, call sites copy their raw arguments into a per thread buffer and formatting is
+		 * left to the logger thread, or skipped entirely for listeners that want binary entries. Applied on initialise
+		 */
+		AXProperty< bool > mDeferredFormatting = false;
+
+		/**
+		 * The size of each thread's deferred entry buffer, calls that don't fit are formatted on the calling thread
+		 */
+		AXProperty< uint32_t > mThreadBufferSizeKB = 256;
+
+		/**
+		 * If set, a binary log listener writing to this path is registered on initialise. Decode it with AXLogDecoder
+		 */
+		AXProperty< AXString > mBinaryLogFile = "";
+
+		/**
+		 * If set, a rotating text log listener writing to this path is registered on initialise
+		 */
+		AXProperty< AXString > mLogFile = "";
+
+		/**
+		 * The log file is rotated once it grows past this size, 0 to never rotate by size
+		 */
+		AXProperty< uint32_t > mLogFileMaxSizeMB = 64;
+
+		/**
+		 * The log file is rotated once it has been open this long, 0 to never rotate by time
+		 */
+		AXProperty< uint32_t > mLogFileRotateMinutes = 0;
+
+		/**
+		 * The number of log files kept, including the current one
+		 */
+		AXProperty< uint32_t > mLogFileMaxFiles = 8;
+
+		/**
+		 * The longest buffered entries wait before being written to the log file, errors are written straight away
+		 */
+		AXProperty< uint32_t > mLogFileFlushIntervalMs = 1000;
+
+		/**
+		 * The sustained number of entries a single call site may log each second, 0 to disable rate limiting. Errors are
+		 * never rate limited. Suppressed entries are counted and reported by the call site's next entry, or by the logger
+		 * within a second or on Flush if the call site goes quiet
+		 */
+		AXProperty< uint32_t > mRateLimitPerSecond = 100;
+
+		/**
+		 * The number of entries a single call site may log in a burst before the rate limit applies
+		 */
+		AXProperty< uint32_t > mRateLimitBurst = 500;
+
+		/**
+		 * If true identical consecutive entries are delivered once, followed by a count of the repeats
+		 */
+		AXProperty< bool > mCollapseRepeats = true;
+	};
+
+	/**
+	 * Per call site state used by the log macros, rate limits the call site with a token bucket
+	 */
+	class CallSite
+	{
+	public:
+		/**
+		* Constructor
+		*/
+		CallSite( LogLevel::E level, const char* tag, const char* file, int line ) : mTag( tag ), mFile( file ), mLine( line ), mLogLevel( level ) { }
+
+		/**
+		 * Returns the interned tag of the call site
+		 */
+		const AXName& GetTag( ) const { return mTag; }
+
+		/**
+		 * Takes a token, returns false if the call site is over its rate limit. Called before the arguments are evaluated
+		 */
+		bool Allow( );
+
+		/**
+		 * Logs the number of entries suppressed since the last report, if any
+		 */
+		void ReportSuppressed( );
+
+	private:
+		friend class AXLogging;
+
+		AXName mTag;
+		const char* mFile;
+		int mLine;
+		LogLevel::E mLogLevel;
+
+		/**
+		 * When the bucket will next be full, as steady clock nanoseconds. The bucket is modelled by this alone, an entry is
+		 * allowed while this is less than a burst's worth of time ahead of now
+		 */
+		AXAtomic< int64_t > mBucketFullTime = 0;
+
+		/**
+		 * Entries rejected since the last one allowed
+		 */
+		AXAtomic< uint32_t > mNumSuppressed = 0;
+
+		/**
+		 * Links the call sites with suppressed entries the logger hasn't reported yet, mQueued is set while on the list
+		 */
+		CallSite* mNextSuppressed = nullptr;
+		AXAtomic< bool > mQueued = false;
 	};
 
 public:
@@ -98,22 +410,49 @@ public:
 	*/
 	~AXLogging();
 	
+	/**
+	* Initialise the system, called after settings are loaded
+	*/
+	virtual InitResult OnInitialize( ) override;
+
 	/**
 	* Shutdown the system
 	*/
 	virtual void OnShutdown( ) override;
 
 	/**
-	 * Constructs a log entry and fires it out to the listeners, shouldn't be called directly, should call from the provided macros
+	* Called once a frame to allow systems to update
+	*/
+	virtual void Update( float dt ) override;
+
+	/**
+	 * Returns false if entries of this level are filtered out at runtime. Only reads a cached copy of the level filter,
+	 * so the macros can call it before evaluating any arguments or finding the system
+	 */
+	static bool IsLevelEnabled( LogLevel::E level ) { return level >= sLevelFilter.load( std::memory_order_relaxed ); }
+
+	/**
+	 * Blocks until every entry queued so far has been delivered, then flushes the listeners
+	 */
+	static void Flush( );
+
+	/**
+	 * Logs the counts of every call site with suppressed entries that haven't been reported yet
+	 */
+	static void ReportSuppressed( );
+
+	/**
+	 * Constructs a log entry and fires it out to the listeners, shouldn't be called directly, should call from the provided macros.
+	 * With deferred formatting msg and file are read after the call returns, so both must be string literals
 	 */
 	template<typename ... Args>
-	static void Log_Internal( LogLevel::E level, const char* tag, const char* file, int line, const char* msg, Args ... args );
+	static void Log_Internal( LogLevel::E level, const AXName& tag, const char* file, int line, const char* msg, Args ... args );
 
 	/**
 	 * Registers a new listener to receive logs
 	 */
-	template< class T >
-	void RegisterNewListener( );
+	template< class T, class... CtorArgs >
+	void RegisterNewListener( CtorArgs&&... ctorArgs );
 
 protected:
 	/**
@@ -127,42 +466,307 @@ private:
 	 */
 	static AXLogging* Get( );
 
+	/**
+	 * Queues an entry for the logger thread, or delivers it on the calling thread when logging is synchronous
+	 */
+	void Submit( LogEntry&& entry );
+
+	/**
+	 * Writes a deferred entry to the calling thread's buffer, returns false if it didn't fit and must be formatted instead
+	 */
+	template<typename ... Args>
+	static bool TrySubmitDeferred( AXLogging* logger, LogLevel::E level, const AXName& tag, const char* file, int line, const char* msg, std::true_type, const Args& ... args );
+
+	/**
+	 * Arguments that can't be encoded are always formatted on the calling thread
+	 */
+	template<typename ... Args>
+	static bool TrySubmitDeferred( AXLogging* logger, LogLevel::E level, const AXName& tag, const char* file, int line, const char* msg, std::false_type, const Args& ... args ) { return false; }
+
+	struct DeferredHeader;
+
+	/**
+	 * Reserves space for a deferred entry with argsSize bytes of arguments in the calling thread's buffer, returns nullptr if it is full
+	 */
+	DeferredHeader* BeginDeferredEntry( size_t argsSize );
+
+	/**
+	 * Publishes the entry reserved by the last BeginDeferredEntry on this thread
+	 */
+	void EndDeferredEntry( );
+
+	/**
+	 * Hands up to maxEntries deferred entries from every thread's buffer to the listeners, must hold the delivery lock.
+	 * Returns the number delivered
+	 */
+	uint32_t DrainThreadBuffers( uint32_t maxEntries );
+
+	/**
+	 * Hands a deferred entry to every listener, formatting it once for the listeners that want text. Must hold the delivery lock
+	 */
+	void DeliverDeferred( const DeferredHeader& header, const uint8_t* args, uint32_t argsSize );
+
+	/**
+	 * Retires every thread's buffer, deleting those whose threads have already exited
+	 */
+	void ReleaseThreadBuffers( );
+
+	/**
+	 * Hands every queued entry to the listeners, must hold the delivery lock. Returns true if anything was delivered
+	 */
+	bool DrainQueue( );
+
+	/**
+	 * Hands an entry to every listener unless it repeats the last one, must hold the delivery lock
+	 */
+	void Deliver( const LogEntry& entry );
+
+	/**
+	 * Hands an entry to every listener, must hold the delivery lock
+	 */
+	void DeliverToListeners( const LogEntry& entry );
+
+	/**
+	 * Returns true if the entry is identical to the last one delivered and should be skipped. Otherwise reports any
+	 * pending repeats of the last entry and remembers this one. Must hold the delivery lock
+	 */
+	bool CollapseRepeat( LogLevel::E level, const AXName& tag, const char* file, int line, bool isDeferred, const void* content, size_t contentSize, const void* extraContent = nullptr, size_t extraContentSize = 0 );
+
+	/**
+	 * Delivers a summary of the repeats of the last entry, if there were any. Must hold the delivery lock
+	 */
+	void ReportRepeats( );
+
+	/**
+	 * Flushes every listener, must hold the delivery lock
+	 */
+	void FlushListeners( );
+
+	/**
+	 * Tells every listener a batch has been delivered, must hold the delivery lock
+	 */
+	void EndListenerBatch( );
+
+	/**
+	 * Wakes the logger thread if it is waiting for entries
+	 */
+	void WakeLoggerThread( );
+
+	/**
+	 * Drains the queue in batches until asked to stop
+	 */
+	void LoggerThreadFunc( );
+
+	void LockDelivery( );
+	bool TryLockDelivery( uint32_t maxSpins );
+	void UnlockDelivery( );
+
+	void LockThreadBuffers( );
+	void UnlockThreadBuffers( );
+
+	/**
+	 * Delivers whatever is queued when the process is about to die, then re-raises the signal
+	 */
+	static void CrashSignalHandler( int signal );
+
+	/**
+	 * Best effort flush on the crashing thread, gives up on the delivery lock rather than deadlocking
+	 */
+	void FlushFromCrash( );
+
 private:
 	/**
 	 * The collection of all listeners
 	 */
 	std::list< AXILogListener* > mListeners;
 
+	/**
+	 * Size of mListeners, read by Log_Internal without taking the delivery lock
+	 */
+	AXAtomic< uint32_t > mListenerCount = 0;
+
+	/**
+	 * Entries waiting for the logger thread, nullptr when logging is synchronous
+	 */
+	AXMPSCQueue< LogEntry >* mQueue = nullptr;
+
+	/**
+	 * The thread delivering queued entries to the listeners
+	 */
+	std::thread* mLoggerThread = nullptr;
+
+	/**
+	 * Serialises delivery so listeners only ever see one thread at a time
+	 */
+	AXAtomic< bool > mDeliveryLocked = false;
+
+	AXAtomic< bool > mStopLoggerThread = false;
+	AXAtomic< bool > mLoggerThreadWaiting = false;
+	std::mutex mWakeMutex;
+	std::condition_variable mWakeCondition;
+
+	/**
+	 * True if call sites should write deferred entries, fixed after initialise
+	 */
+	bool mDeferredFormatting = false;
+
+	/**
+	 * Every thread's deferred entry buffer, guarded by mThreadBuffersLocked
+	 */
+	std::vector< AXLoggingThreadBuffer* > mThreadBuffers;
+	AXAtomic< bool > mThreadBuffersLocked = false;
+
+	/**
+	 * Copy of mThreadBuffers taken while draining, so listeners can log without taking the lock. Guarded by the delivery lock
+	 */
+	std::vector< AXLoggingThreadBuffer* > mDrainThreadBuffers;
+
+	/**
+	 * Reused for formatting deferred entries for text listeners, guarded by the delivery lock
+	 */
+	LogEntry mDeferredTextEntry;
+
+	/**
+	 * Entries discarded by the Drop overflow policy since the last report
+	 */
+	AXAtomic< uint32_t > mDroppedEntries = 0;
+
+	/**
+	 * The instance flushed by the crash handlers
+	 */
+	static AXLogging* sCrashFlushLogger;
+
+	/**
+	 * Copy of the level filter setting, refreshed every frame as the setting can be edited at runtime
+	 */
+	static AXAtomic< uint8_t > sLevelFilter;
+
+	/**
+	 * Nanoseconds per rate limit token, and the burst tolerance in nanoseconds. Refreshed every frame, an interval of 0
+	 * disables rate limiting
+	 */
+	static AXAtomic< int64_t > sRateLimitInterval;
+	static AXAtomic< int64_t > sRateLimitTolerance;
+
+	/**
+	 * Head of the list of call sites waiting to report suppressed entries. Only ever emptied as a whole, so pushes
+	 * can't suffer ABA
+	 */
+	static AXAtomic< CallSite* > sSuppressedSites;
+
+	/**
+	 * When Update last reported suppressed entries
+	 */
+	std::chrono::steady_clock::time_point mLastSuppressedReportTime;
+
+	/**
+	 * The last entry delivered, used to collapse identical consecutive entries. Guarded by the delivery lock
+	 */
+	struct RepeatState
+	{
+		LogLevel::E		mLogLevel = LogLevel::Info;
+		AXName			mTag;
+		const char*		mFile = nullptr;
+		int				mLine = 0;
+
+		/**
+		 * The message, or for deferred entries the format pointer followed by the encoded arguments
+		 */
+		AXString		mContent;
+		bool			mIsDeferred = false;
+
+		uint32_t		mNumRepeats = 0;
+		std::chrono::steady_clock::time_point mFirstRepeatTime;
+	};
+
+	RepeatState mRepeatState;
+
 	/**
 	 * Pointer to our loaded settings
 	 */
-	Settings* mSettings;
+	Settings* mSettings = nullptr;
 };
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
+/**
+ * The fixed part of a deferred entry, followed in the thread buffer by the encoded arguments
+ */
+struct AXLogging::DeferredHeader
+{
+	AXName			mTag;
+	const char*		mFormat;
+	const char*		mFile;
+	int32_t			mLine;
+	LogLevel::E		mLogLevel;
+};
+
 /**
 * Registers a new listener to receive logs
 */
-template< class T >
-void AXLogging::RegisterNewListener( )
+template< class T, class... CtorArgs >
+void AXLogging::RegisterNewListener( CtorArgs&&... ctorArgs )
+{
+	T* listener( new T( std::forward< CtorArgs >( ctorArgs )... ) );
+
+	// The logger thread may be delivering already
+	LockDelivery( );
+	mListeners.push_back( listener );
+	++mListenerCount;
+	UnlockDelivery( );
+}
+
+/**
+* Writes a deferred entry to the calling thread's buffer, returns false if it didn't fit and must be formatted instead
+*/
+template<typename ... Args>
+inline bool AXLogging::TrySubmitDeferred( AXLogging* logger, LogLevel::E level, const AXName& tag, const char* file, int line, const char* msg, std::true_type, const Args& ... args )
 {
-	mListeners.push_back( new T( ) );
+	const size_t argsSize( AXBinaryLog::EncodedSize( args ... ) );
+
+	if( DeferredHeader* header = logger->BeginDeferredEntry( argsSize ) )
+	{
+		header->mTag = tag;
+		header->mFormat = msg;
+		header->mFile = file;
+		header->mLine = line;
+		header->mLogLevel = level;
+
+		AXBinaryLog::Encode( reinterpret_cast< uint8_t* >( header + 1 ), args ... );
+
+		logger->EndDeferredEntry( );
+		return true;
+	}
+
+	return false;
 }
 
 /**
-* Constructs a log entry and fires it out to the listeners, shouldn't be called directly, should call from the provided macros
+* Constructs a log entry and fires it out to the listeners, shouldn't be called directly, should call from the provided macros.
+* With deferred formatting msg and file are read after the call returns, so both must be string literals
 */
 template<typename ... Args>
-inline void AXLogging::Log_Internal( LogLevel::E level, const char* tag, const char* file, int line, const char* msg, Args ... args )
+inline void AXLogging::Log_Internal( LogLevel::E level, const AXName& tag, const char* file, int line, const char* msg, Args ... args )
 {
 	if( AXLogging* logger = AXLogging::Get( ) )
 	{
-		if( !logger->mListeners.empty( ) )
+		if( logger->mListenerCount.load( std::memory_order_relaxed ) > 0 )
 		{
 			if( !logger->mSettings || level >= logger->mSettings->mLogLevelFilter.Val() )
 			{
+				if( logger->mDeferredFormatting &&
+					TrySubmitDeferred( logger, level, tag, file, line, msg, std::integral_constant< bool, AXBinaryLogArgsSupported< Args... >::value >( ), args ... ) )
+				{
+					if( logger->mSettings && logger->mSettings->mCrashOnError && level == LogLevel::Error )
+					{
+						Flush( );
+						assert( false );
+					}
+
+					return;
+				}
+
 				LogEntry entry;
 				entry.mLogLevel = level;
 				entry.mFile = file;
@@ -170,13 +774,11 @@ inline void AXLogging::Log_Internal( LogLevel::E level, const char* tag, const c
 				entry.mTag = tag;
 				entry.mMessage = AXUtils::FormatString( msg, args ... );
 
-				for( auto listener : logger->mListeners )
-				{
-					listener->Log( entry );
-				}
+				logger->Submit( std::move( entry ) );
 
 				if( logger->mSettings && logger->mSettings->mCrashOnError && level == LogLevel::Error )
 				{
+					Flush( );
 					assert( false );
 				}
 			}
@@ -187,16 +789,31 @@ inline void AXLogging::Log_Internal( LogLevel::E level, const char* tag, const c
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-#define AXLOG( TAG, STR, ... ) AXLogging::Log_Internal( AXLogging::LogLevel::Info, (TAG), __FILE__, __LINE__, (STR), __VA_ARGS__ )
-#define AXWARN( TAG, STR, ... ) AXLogging::Log_Internal( AXLogging::LogLevel::Warning, (TAG), __FILE__, __LINE__, (STR), __VA_ARGS__ )
-#define AXERROR( TAG, STR, ... ) AXLogging::Log_Internal( AXLogging::LogLevel::Error, (TAG), __FILE__, __LINE__, (STR), __VA_ARGS__ )
+// Tags are interned once per call site, so TAG must be the same string literal every time a call site is hit
+#define AXLOGSITEVARNAME AXJOIN( LogSite, __LINE__ )
+
+// Calls stripped at compile time keep their arguments referenced but never evaluate them, the runtime level and rate limit
+// checks come before the arguments are evaluated too
+#define AXLOG_INTERNAL( LEVEL, TAG, STR, ... ) do{ \
+	if( std::integral_constant< bool, AXLogCompileTime::IsCompiledIn( LEVEL, TAG ) >::value && AXLogging::IsLevelEnabled( LEVEL ) ) \
+	{ \
+		static AXLogging::CallSite AXLOGSITEVARNAME( LEVEL, TAG, __FILE__, __LINE__ ); \
+		if( AXLOGSITEVARNAME.Allow( ) ) \
+		{ \
+			AXLogging::Log_Internal( LEVEL, AXLOGSITEVARNAME.GetTag( ), __FILE__, __LINE__, (STR), ##__VA_ARGS__ ); \
+		} \
+	} } while( false )
+
+#define AXLOG( TAG, STR, ... ) AXLOG_INTERNAL( AXLogging::LogLevel::Info, TAG, STR, ##__VA_ARGS__ )
+#define AXWARN( TAG, STR, ... ) AXLOG_INTERNAL( AXLogging::LogLevel::Warning, TAG, STR, ##__VA_ARGS__ )
+#define AXERROR( TAG, STR, ... ) AXLOG_INTERNAL( AXLogging::LogLevel::Error, TAG, STR, ##__VA_ARGS__ )
 
 #define AXLOGONCEVARNAME AXJOIN( Logged, __LINE__ )
 #define AXLOGONCEVARCHECKVALNAME AXJOIN( BoolFalse, __LINE__ )
 
-#define AXLOGONCE( TAG, STR, ... ) do{ static bool AXLOGONCEVARNAME( false ); if( !AXLOGONCEVARNAME ){ AXLOG( (TAG), (STR), __VA_ARGS__ ); AXLOGONCEVARNAME = true; } } while( false )
-#define AXWARNONCE( TAG, STR, ... ) do{ static bool AXLOGONCEVARNAME( false ); if( !AXLOGONCEVARNAME ){ AXWARN( (TAG), (STR), __VA_ARGS__ ); AXLOGONCEVARNAME = true; } } while( false )
-#define AXERRORONCE( TAG, STR, ... ) do{ static bool AXLOGONCEVARNAME( false ); if( !AXLOGONCEVARNAME ){ AXERROR( (TAG), (STR), __VA_ARGS__ ); AXLOGONCEVARNAME = true; } } while( false )
+#define AXLOGONCE( TAG, STR, ... ) do{ static bool AXLOGONCEVARNAME( false ); if( !AXLOGONCEVARNAME ){ AXLOG( (TAG), (STR), ##__VA_ARGS__ ); AXLOGONCEVARNAME = true; } } while( false )
+#define AXWARNONCE( TAG, STR, ... ) do{ static bool AXLOGONCEVARNAME( false ); if( !AXLOGONCEVARNAME ){ AXWARN( (TAG), (STR), ##__VA_ARGS__ ); AXLOGONCEVARNAME = true; } } while( false )
+#define AXERRORONCE( TAG, STR, ... ) do{ static bool AXLOGONCEVARNAME( false ); if( !AXLOGONCEVARNAME ){ AXERROR( (TAG), (STR), ##__VA_ARGS__ ); AXLOGONCEVARNAME = true; } } while( false )
 
 #define AXLOG_UNIMPLEMENTED_FUNCTION AXERRORONCE( "Unimlemented", "Unimlemented function: %s (%s - %d)", __func__, __FILE__, __LINE__ );
 
@@ -212,4 +829,188 @@ public:
 	* Override to handle a log entry
 	*/
 	virtual void Log( const AXLogging::LogEntry& entry ) override;
+
+	/**
+	* Override to flush any buffered output, called when the log is flushed and by default after every batch of entries
+	*/
+	virtual void Flush( ) override;
+};
+
+/**
+ * Writes every entry to a binary file without formatting it, decode the file with AXLogDecoder. See AXBinaryLog for the layout
+ */
+class AXLogListener_BinaryFile : public AXLogging::AXILogListener
+{
+public:
+	/**
+	* Constructor, opens the file for writing, replacing any existing file
+	*/
+	AXLogListener_BinaryFile( const char* path );
+
+	/**
+	* Destructor
+	*/
+	~AXLogListener_BinaryFile( );
+
+	/**
+	* Override to handle a log entry
+	*/
+	virtual void Log( const AXLogging::LogEntry& entry ) override;
+
+	/**
+	* Override to return true to receive deferred entries through LogBinary
+	*/
+	virtual bool WantsBinary( ) const override { return true; }
+
+	/**
+	* Override to handle a deferred log entry
+	*/
+	virtual void LogBinary( const AXLogging::BinaryLogEntry& entry ) override;
+
+	/**
+	* Override to flush any buffered output, called when the log is flushed and by default after every batch of entries
+	*/
+	virtual void Flush( ) override;
+
+private:
+	/**
+	 * Writes a string definition record the first time a string is seen, then returns its id
+	 */
+	uint64_t StringId( const char* str );
+
+	void Write( const void* data, size_t size ) { fwrite( data, 1, size, mFile ); }
+
+	template< class T >
+	void WriteValue( const T& val ) { Write( &val, sizeof( T ) ); }
+
+private:
+	FILE* mFile = nullptr;
+
+	/**
+	 * Strings already defined in the file. They are static or interned so their address identifies them
+	 */
+	std::unordered_set< const char* > mDefinedStrings;
+};
+
+/**
+ * Writes entries as text to a file through a large buffer and rotates to a new file by size or age. With asynchronous logging
+ * all of the IO happens on the logger thread. The buffer is written out when it fills, when an error is logged, and
+ * otherwise at most once per flush interval, so entries may be lost on a hard crash that skips the crash handlers
+ */
+class AXLogListener_RotatingFile : public AXLogging::AXILogListener
+{
+public:
+	struct Params
+	{
+		/**
+		 * The file currently written to. Older files insert .1, .2 and so on before the extension, .1 being the newest.
+		 * The directory must already exist
+		 */
+		AXString mPath;
+
+		/**
+		 * The size of the in memory buffer
+		 */
+		size_t mBufferSize = 4 * 1024 * 1024;
+
+		/**
+		 * The file is rotated once it grows past this size, 0 to never rotate by size
+		 */
+		uint64_t mMaxFileSize = 64 * 1024 * 1024;
+
+		/**
+		 * The file is rotated once it has been open this long, 0 to never rotate by time
+		 */
+		uint32_t mRotateIntervalSeconds = 0;
+
+		/**
+		 * The number of files kept, including the current one
+		 */
+		uint32_t mMaxFiles = 8;
+
+		/**
+		 * The longest buffered entries wait before being written out
+		 */
+		uint32_t mFlushIntervalMs = 1000;
+	};
+
+public:
+	/**
+	* Constructor, moves any existing log files along and opens a new one
+	*/
+	AXLogListener_RotatingFile( const Params& params );
+
+	/**
+	* Destructor
+	*/
+	~AXLogListener_RotatingFile( );
+
+	/**
+	* Override to handle a log entry
+	*/
+	virtual void Log( const AXLogging::LogEntry& entry ) override;
+
+	/**
+	* Override to flush any buffered output, called when the log is flushed
+	*/
+	virtual void Flush( ) override;
+
+	/**
+	* Override to write the buffer out if an error was logged or the flush interval has passed, and to rotate by age
+	*/
+	virtual void OnBatchEnd( ) override;
+
+private:
+	using Clock = std::chrono::steady_clock;
+
+	/**
+	 * Formats an entry into out, returns the length it needed in the same way as snprintf
+	 */
+	static int FormatEntry( char* out, size_t size, const AXLogging::LogEntry& entry );
+
+	/**
+	 * Writes the buffer to the file
+	 */
+	void WriteBuffer( );
+
+	/**
+	 * Closes the current file, moves the existing files along and opens a new one
+	 */
+	void Rotate( );
+
+	/**
+	 * Renames every existing file to the next index, removing the oldest
+	 */
+	void ShiftFiles( ) const;
+
+	/**
+	 * Opens a new current file
+	 */
+	void OpenFile( );
+
+	/**
+	 * Returns the path of the file at a rotation index, 0 being the current file
+	 */
+	AXString RotatedPath( uint32_t idx ) const;
+
+private:
+	Params mParams;
+
+	FILE* mFile = nullptr;
+
+	char* mBuffer = nullptr;
+	size_t mBufferUsed = 0;
+
+	/**
+	 * Bytes logged to the current file, including those still in the buffer
+	 */
+	uint64_t mFileSize = 0;
+
+	/**
+	 * Set when an error is logged so it is written out at the end of the batch
+	 */
+	bool mWritePending = false;
+
+	Clock::time_point mLastWriteTime;
+	Clock::time_point mFileOpenTime;
 };
\ No newline at end of file
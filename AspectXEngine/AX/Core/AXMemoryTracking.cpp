@@ -0,0 +1,519 @@
+// Copyright 2016 Scott Bevin, All Rights Reserved
+
+#include "AXMemoryTracking.h"
+#include "AX/Core/AXLogging.h"
+#include "AX/Core/AXApplication.h"
+#include "AX/Core/AXPerfCounters.h"
+#include "AX/Utils/AXFrameAllocator.h"
+
+#include <new>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+template<> AXName AXSystem< AXMemoryTracking >::sSystemName = "MemoryTracking";
+
+/**
+* Magic value written into every tracking header, used to catch frees of memory that was not allocated through TrackedAlloc
+*/
+#define AXMEMORY_HEADER_MAGIC 0xA110C8EDu
+
+/**
+* Longest tag name stored, including the terminator
+*/
+#define AXMEMORY_MAX_TAG_NAME 32
+
+namespace
+{
+	/**
+	* Written in front of every tracked allocation, 16 bytes so the returned memory keeps malloc's alignment
+	*/
+	struct AllocationHeader
+	{
+		uint32_t mMagic;
+		AXMemoryTracking::Tag mTag;
+		uint16_t mPadding;
+		uint64_t mSize;
+	};
+
+	static_assert( sizeof( AllocationHeader ) == 16, "Allocation header must stay 16 bytes to preserve alignment" );
+
+	/**
+	* Counters for every tag, each thread writes only to its own set so no cache lines are shared on the allocation path.
+	* Frees are counted on the freeing thread, so a single thread's counters can go negative but the sum over all threads is exact
+	*/
+	struct alignas( AXCACHE_LINE_SIZE ) ThreadCounters
+	{
+		AXAtomic< int64_t > mLiveBytes[AXMEMORY_MAX_TAGS];
+		AXAtomic< int64_t > mLiveAllocations[AXMEMORY_MAX_TAGS];
+		AXAtomic< int64_t > mTotalAllocations[AXMEMORY_MAX_TAGS];
+	};
+
+	/**
+	* One set of counters per AXThreadIndex, plus a shared set for threads without an index that is updated with atomic adds
+	*/
+	static ThreadCounters sThreadCounters[AXThreadIndex::MaxThreads + 1];
+
+	static char sTagNames[AXMEMORY_MAX_TAGS][AXMEMORY_MAX_TAG_NAME] = { "Untagged" };
+	static AXAtomic< uint32_t > sNumTags = 1;
+	static AXAtomic< bool > sTagsLocked = false;
+
+	static thread_local AXMemoryTracking::Tag tTagStack[AXMEMORY_MAX_TAG_DEPTH];
+	static thread_local uint32_t tTagStackDepth = 0;
+
+	/**
+	* Adds to a counter, owned counters are only written by one thread so a plain load and store is enough
+	*/
+	inline void AddToCounter( AXAtomic< int64_t >& counter, int64_t val, bool shared )
+	{
+		if( shared )
+		{
+			counter.fetch_add( val, std::memory_order_relaxed );
+		}
+		else
+		{
+			counter.store( counter.load( std::memory_order_relaxed ) + val, std::memory_order_relaxed );
+		}
+	}
+
+	inline void CountAllocation( AXMemoryTracking::Tag tag, int64_t size, int64_t count )
+	{
+		const uint32_t threadIdx( AXThreadIndex::Current( ) );
+		const bool shared( threadIdx == AXThreadIndex::InvalidIndex );
+
+		ThreadCounters& counters( sThreadCounters[shared ? AXThreadIndex::MaxThreads : threadIdx] );
+
+		AddToCounter( counters.mLiveBytes[tag], size, shared );
+		AddToCounter( counters.mLiveAllocations[tag], count, shared );
+
+		if( count > 0 )
+		{
+			AddToCounter( counters.mTotalAllocations[tag], count, shared );
+
+			AXPERF_COUNT( "Memory/Allocations", count );
+		}
+	}
+}
+
+/**
+* Initialise the system, called after settings are loaded
+*/
+AXMemoryTracking::InitResult AXMemoryTracking::OnInitialize( )
+{
+	if( AXImGui* imGui = AXImGui::GetFrom( AXApplication::Get( ) ) )
+	{
+		imGui->RegisterSystemDebugMenuItem( "Window/Memory", std::bind( &AXMemoryTracking::ImGuiMemoryWindowCallback, this, std::placeholders::_1 ) );
+	}
+
+	if( !IsEnabled( ) )
+	{
+		AXLOG( "Memory", "Memory tracking is disabled, build with AXMEMORY_TRACKING to enable it" );
+	}
+
+	return AXMemoryTracking::InitResult::Initialized;
+}
+
+/**
+* Called once a frame to allow systems to update
+*/
+void AXMemoryTracking::Update( float dt )
+{
+	TagStats stats[AXMEMORY_MAX_TAGS];
+	GatherTagStats( stats );
+
+	int64_t liveBytes( 0 );
+
+	for( uint32_t i( 0 ); i < AXMEMORY_MAX_TAGS; ++i )
+	{
+		stats[i].mPeakBytes = AXUtils::Max( mTagStats[i].mPeakBytes, stats[i].mLiveBytes );
+		mTagStats[i] = stats[i];
+
+		liveBytes += stats[i].mLiveBytes;
+	}
+
+	if( IsEnabled( ) )
+	{
+		AXPERF_GAUGE_SET( "Memory/Live Bytes", liveBytes );
+	}
+
+	RenderImGuiMemoryWindow( );
+}
+
+/**
+* Registers a tag, or returns the existing one with the same name. Names longer than the internal buffer are truncated
+*/
+AXMemoryTracking::Tag AXMemoryTracking::RegisterTag( const char* name )
+{
+	bool expectedLockedFlag = false;
+	do { expectedLockedFlag = false; } while( !sTagsLocked.compare_exchange_weak( expectedLockedFlag, true ) );
+
+	Tag tag( UntaggedTag );
+	bool found( false );
+
+	const uint32_t numTags( sNumTags );
+
+	for( uint32_t i( 0 ); i < numTags && !found; ++i )
+	{
+		if( strncmp( sTagNames[i], name, AXMEMORY_MAX_TAG_NAME - 1 ) == 0 )
+		{
+			tag = static_cast< Tag >( i );
+			found = true;
+		}
+	}
+
+	// Once every tag is used further names are counted as untagged
+	if( !found && numTags < AXMEMORY_MAX_TAGS )
+	{
+		const size_t length( AXUtils::Min( strlen( name ), ( size_t )( AXMEMORY_MAX_TAG_NAME - 1 ) ) );
+		memcpy( sTagNames[numTags], name, length );
+		sTagNames[numTags][length] = '\0';
+
+		tag = static_cast< Tag >( numTags );
+		sNumTags = numTags + 1;
+	}
+
+	sTagsLocked = false;
+
+	return tag;
+}
+
+/**
+* Returns the name a tag was registered with
+*/
+const char* AXMemoryTracking::GetTagName( Tag tag )
+{
+	return tag < sNumTags ? sTagNames[tag] : sTagNames[UntaggedTag];
+}
+
+/**
+* Returns the number of registered tags, including the untagged tag
+*/
+uint32_t AXMemoryTracking::NumTags( )
+{
+	return sNumTags;
+}
+
+/**
+* Pushes a tag onto the calling thread's tag stack, prefer AXMEMORY_SCOPE
+*/
+void AXMemoryTracking::PushTag( Tag tag )
+{
+	if( tTagStackDepth < AXMEMORY_MAX_TAG_DEPTH )
+	{
+		tTagStack[tTagStackDepth] = tag;
+	}
+
+	++tTagStackDepth;
+}
+
+/**
+* Pops the top tag from the calling thread's tag stack, prefer AXMEMORY_SCOPE
+*/
+void AXMemoryTracking::PopTag( )
+{
+	if( tTagStackDepth > 0 )
+	{
+		--tTagStackDepth;
+	}
+}
+
+/**
+* Returns the tag new allocations on the calling thread are attributed to
+*/
+AXMemoryTracking::Tag AXMemoryTracking::CurrentTag( )
+{
+	if( tTagStackDepth == 0 )
+	{
+		return UntaggedTag;
+	}
+
+	return tTagStack[AXUtils::Min( tTagStackDepth, ( uint32_t )AXMEMORY_MAX_TAG_DEPTH ) - 1];
+}
+
+/**
+* Returns true if the engine was built with AXMEMORY_TRACKING
+*/
+bool AXMemoryTracking::IsEnabled( )
+{
+#if defined( AXMEMORY_TRACKING )
+	return true;
+#else
+	return false;
+#endif // #if defined( AXMEMORY_TRACKING )
+}
+
+/**
+* Allocates memory with a tracking header, used by the global operator new when AXMEMORY_TRACKING is defined
+*/
+void* AXMemoryTracking::TrackedAlloc( size_t size )
+{
+	AllocationHeader* header( static_cast< AllocationHeader* >( malloc( sizeof( AllocationHeader ) + size ) ) );
+
+	if( !header )
+	{
+		return nullptr;
+	}
+
+	header->mMagic = AXMEMORY_HEADER_MAGIC;
+	header->mTag = CurrentTag( );
+	header->mPadding = 0;
+	header->mSize = size;
+
+	CountAllocation( header->mTag, ( int64_t )size, 1 );
+
+	return header + 1;
+}
+
+/**
+* Frees memory allocated with TrackedAlloc
+*/
+void AXMemoryTracking::TrackedFree( void* ptr )
+{
+	if( !ptr )
+	{
+		return;
+	}
+
+	AllocationHeader* header( static_cast< AllocationHeader* >( ptr ) - 1 );
+
+	// Can't log or assert here as both may allocate
+	if( header->mMagic != AXMEMORY_HEADER_MAGIC )
+	{
+		abort( );
+	}
+
+	header->mMagic = 0;
+
+	CountAllocation( header->mTag, -( int64_t )header->mSize, -1 );
+
+	free( header );
+}
+
+/**
+* Sums the per thread counters of every tag into outStats, which must hold AXMEMORY_MAX_TAGS entries. Peaks are not filled in
+*/
+void AXMemoryTracking::GatherTagStats( TagStats* outStats )
+{
+	for( uint32_t tag( 0 ); tag < AXMEMORY_MAX_TAGS; ++tag )
+	{
+		outStats[tag] = TagStats( );
+	}
+
+	for( const ThreadCounters& counters : sThreadCounters )
+	{
+		for( uint32_t tag( 0 ); tag < AXMEMORY_MAX_TAGS; ++tag )
+		{
+			outStats[tag].mLiveBytes += counters.mLiveBytes[tag].load( std::memory_order_relaxed );
+			outStats[tag].mLiveAllocations += counters.mLiveAllocations[tag].load( std::memory_order_relaxed );
+			outStats[tag].mTotalAllocations += counters.mTotalAllocations[tag].load( std::memory_order_relaxed );
+		}
+	}
+}
+
+/**
+* A callback function to draw the memory window
+*/
+void AXMemoryTracking::ImGuiMemoryWindowCallback( AXImGui::SystemDebugMenuItem& item )
+{
+	ImGui::MenuItem( item.mText.c_str( ), "", &mShouldRenderImGuiMemoryWindow );
+}
+
+/**
+* Renders the IM gui memory window
+*/
+void AXMemoryTracking::RenderImGuiMemoryWindow( )
+{
+	if( mShouldRenderImGuiMemoryWindow )
+	{
+		if( ImGui::Begin( "Memory", &mShouldRenderImGuiMemoryWindow ) )
+		{
+			const AXFrameAllocator::FrameStats& frameStats( AXFrameAllocator::LastFrameStats( ) );
+
+			ImGui::Text( "Frame scratch: %.1f KB over %u threads, %.1f KB overflow, high water %.1f KB",
+				frameStats.mBytesUsed / 1024.0f, frameStats.mNumThreads, frameStats.mOverflowBytesUsed / 1024.0f, AXFrameAllocator::HighWaterMark( ) / 1024.0f );
+
+			if( !IsEnabled( ) )
+			{
+				ImGui::Text( "Memory tracking is disabled, build with AXMEMORY_TRACKING to enable it" );
+				ImGui::End( );
+				return;
+			}
+
+			if( ImGui::Button( "Take Snapshot" ) )
+			{
+				TakeSnapshot( );
+			}
+
+			if( mHasSnapshot )
+			{
+				ImGui::SameLine( );
+
+				if( ImGui::Button( "Export Diff" ) )
+				{
+					if( ExportSnapshotDiff( "MemorySnapshotDiff.txt" ) )
+					{
+						AXLOG( "Memory", "Exported memory snapshot diff to MemorySnapshotDiff.txt" );
+					}
+					else
+					{
+						AXWARN( "Memory", "Failed to export memory snapshot diff" );
+					}
+				}
+			}
+
+			ImGui::Separator( );
+
+			ImGui::Columns( mHasSnapshot ? 6 : 5, "MemoryTags" );
+			ImGui::Text( "Tag" ); ImGui::NextColumn( );
+			ImGui::Text( "Live KB" ); ImGui::NextColumn( );
+			ImGui::Text( "Peak KB" ); ImGui::NextColumn( );
+			ImGui::Text( "Live Allocs" ); ImGui::NextColumn( );
+			ImGui::Text( "Total Allocs" ); ImGui::NextColumn( );
+
+			if( mHasSnapshot )
+			{
+				ImGui::Text( "Delta KB" ); ImGui::NextColumn( );
+			}
+
+			ImGui::Separator( );
+
+			const uint32_t numTags( NumTags( ) );
+
+			for( uint32_t i( 0 ); i < numTags; ++i )
+			{
+				const TagStats& stats( mTagStats[i] );
+
+				ImGui::Text( "%s", GetTagName( static_cast< Tag >( i ) ) ); ImGui::NextColumn( );
+				ImGui::Text( "%.1f", stats.mLiveBytes / 1024.0f ); ImGui::NextColumn( );
+				ImGui::Text( "%.1f", stats.mPeakBytes / 1024.0f ); ImGui::NextColumn( );
+				ImGui::Text( "%lld", ( long long )stats.mLiveAllocations ); ImGui::NextColumn( );
+				ImGui::Text( "%lld", ( long long )stats.mTotalAllocations ); ImGui::NextColumn( );
+
+				if( mHasSnapshot )
+				{
+					ImGui::Text( "%+.1f", ( stats.mLiveBytes - mSnapshotStats[i].mLiveBytes ) / 1024.0f ); ImGui::NextColumn( );
+				}
+			}
+
+			ImGui::Columns( 1 );
+		}
+
+		ImGui::End( );
+	}
+}
+
+/**
+* Copies the current stats into the snapshot used as the baseline for diffs
+*/
+void AXMemoryTracking::TakeSnapshot( )
+{
+	for( uint32_t i( 0 ); i < AXMEMORY_MAX_TAGS; ++i )
+	{
+		mSnapshotStats[i] = mTagStats[i];
+	}
+
+	mHasSnapshot = true;
+}
+
+/**
+* Writes the difference between the snapshot and the current stats to a text file, returns false on failure
+*/
+bool AXMemoryTracking::ExportSnapshotDiff( const char* path ) const
+{
+	FILE* file( AXUtils::OpenFile( path, "w" ) );
+
+	if( !file )
+	{
+		return false;
+	}
+
+	fprintf( file, "%-32s %16s %16s %16s %12s %12s %12s\n", "Tag", "SnapshotBytes", "CurrentBytes", "DeltaBytes", "SnapAllocs", "CurAllocs", "DeltaAllocs" );
+
+	const uint32_t numTags( NumTags( ) );
+
+	for( uint32_t i( 0 ); i < numTags; ++i )
+	{
+		const TagStats& before( mSnapshotStats[i] );
+		const TagStats& after( mTagStats[i] );
+
+		fprintf( file, "%-32s %16lld %16lld %+16lld %12lld %12lld %+12lld\n",
+			GetTagName( static_cast< Tag >( i ) ),
+			( long long )before.mLiveBytes,
+			( long long )after.mLiveBytes,
+			( long long )( after.mLiveBytes - before.mLiveBytes ),
+			( long long )before.mLiveAllocations,
+			( long long )after.mLiveAllocations,
+			( long long )( after.mLiveAllocations - before.mLiveAllocations ) );
+	}
+
+	fclose( file );
+
+	return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#if defined( AXMEMORY_TRACKING )
+
+void* operator new( size_t size )
+{
+	if( void* ptr = AXMemoryTracking::TrackedAlloc( size ) )
+	{
+		return ptr;
+	}
+
+	throw std::bad_alloc( );
+}
+
+void* operator new[]( size_t size )
+{
+	if( void* ptr = AXMemoryTracking::TrackedAlloc( size ) )
+	{
+		return ptr;
+	}
+
+	throw std::bad_alloc( );
+}
+
+void* operator new( size_t size, const std::nothrow_t& ) noexcept
+{
+	return AXMemoryTracking::TrackedAlloc( size );
+}
+
+void* operator new[]( size_t size, const std::nothrow_t& ) noexcept
+{
+	return AXMemoryTracking::TrackedAlloc( size );
+}
+
+void operator delete( void* ptr ) noexcept
+{
+	AXMemoryTracking::TrackedFree( ptr );
+}
+
+void operator delete[]( void* ptr ) noexcept
+{
+	AXMemoryTracking::TrackedFree( ptr );
+}
+
+void operator delete( void* ptr, size_t ) noexcept
+{
+	AXMemoryTracking::TrackedFree( ptr );
+}
+
+void operator delete[]( void* ptr, size_t ) noexcept
+{
+	AXMemoryTracking::TrackedFree( ptr );
+}
+
+void operator delete( void* ptr, const std::nothrow_t& ) noexcept
+{
+	AXMemoryTracking::TrackedFree( ptr );
+}
+
+void operator delete[]( void* ptr, const std::nothrow_t& ) noexcept
+{
+	AXMemoryTracking::TrackedFree( ptr );
+}
+
+#endif // #if defined( AXMEMORY_TRACKING )
\ No newline at end of file
@@ -0,0 +1,180 @@
+// Copyright 2016 Scott Bevin, All Rights Reserved
+
+#pragma once
+
+#include "AX/Core/AXSystem.h"
+#include "AX/Utils/AXParent.h"
+#include "AX/Utils/AXThreadingPrimitives.h"
+#include "AX/Utils/AXUtils.h"
+#include "AX/Graphics/UI/ImGui/AXImGui.h"
+
+#include <stdint.h>
+
+/**
+ * Maximum number of distinct memory tags, tag 0 is reserved for untagged allocations
+ */
+#define AXMEMORY_MAX_TAGS 128
+
+/**
+ * Maximum depth of the per thread memory tag stack, deeper scopes keep attributing to the deepest tag that fit
+ */
+#define AXMEMORY_MAX_TAG_DEPTH 32
+
+#if defined( AXMEMORY_TRACKING )
+
+/**
+ * Attributes every allocation made by this thread to the named tag until the end of the enclosing scope
+ */
+#define AXMEMORY_SCOPE( NAME ) \
+	static const AXMemoryTracking::Tag AXJOIN( axMemoryTag, __LINE__ )( AXMemoryTracking::RegisterTag( NAME ) ); \
+	AXMemoryTagScope AXJOIN( axMemoryTagScope, __LINE__ )( AXJOIN( axMemoryTag, __LINE__ ) )
+
+/**
+ * Attributes every allocation made by this thread to an already registered tag until the end of the enclosing scope
+ */
+#define AXMEMORY_TAG_SCOPE( TAG ) AXMemoryTagScope AXJOIN( axMemoryTagScope, __LINE__ )( TAG )
+
+#else
+
+#define AXMEMORY_SCOPE( NAME ) do { } while( false )
+#define AXMEMORY_TAG_SCOPE( TAG ) do { } while( false )
+
+#endif // #if defined( AXMEMORY_TRACKING )
+
+class AXMemoryTracking : public AXParent< AXSystem< AXMemoryTracking >, AXMemoryTracking >
+{
+public:
+	using Tag = uint16_t;
+
+	static const Tag UntaggedTag = 0;
+
+	/**
+	 * Totals for a single tag, summed over every thread
+	 */
+	struct TagStats
+	{
+		int64_t mLiveBytes = 0;
+		int64_t mPeakBytes = 0;
+		int64_t mLiveAllocations = 0;
+		int64_t mTotalAllocations = 0;
+	};
+
+public:
+	/**
+	* Initialise the system, called after settings are loaded
+	*/
+	virtual InitResult OnInitialize( ) override;
+
+	/**
+	* Called once a frame to allow systems to update
+	*/
+	virtual void Update( float dt ) override;
+
+	/**
+	 * Registers a tag, or returns the existing one with the same name. Names longer than the internal buffer are truncated
+	 */
+	static Tag RegisterTag( const char* name );
+
+	/**
+	 * Returns the name a tag was registered with
+	 */
+	static const char* GetTagName( Tag tag );
+
+	/**
+	 * Returns the number of registered tags, including the untagged tag
+	 */
+	static uint32_t NumTags( );
+
+	/**
+	 * Pushes a tag onto the calling thread's tag stack, prefer AXMEMORY_SCOPE
+	 */
+	static void PushTag( Tag tag );
+
+	/**
+	 * Pops the top tag from the calling thread's tag stack, prefer AXMEMORY_SCOPE
+	 */
+	static void PopTag( );
+
+	/**
+	 * Returns the tag new allocations on the calling thread are attributed to
+	 */
+	static Tag CurrentTag( );
+
+	/**
+	 * Returns true if the engine was built with AXMEMORY_TRACKING
+	 */
+	static bool IsEnabled( );
+
+	/**
+	 * Allocates memory with a tracking header, used by the global operator new when AXMEMORY_TRACKING is defined
+	 */
+	static void* TrackedAlloc( size_t size );
+
+	/**
+	 * Frees memory allocated with TrackedAlloc
+	 */
+	static void TrackedFree( void* ptr );
+
+	/**
+	 * Sums the per thread counters of every tag into outStats, which must hold AXMEMORY_MAX_TAGS entries. Peaks are not filled in
+	 */
+	static void GatherTagStats( TagStats* outStats );
+
+private:
+	/**
+	* A callback function to draw the memory window
+	*/
+	void ImGuiMemoryWindowCallback( AXImGui::SystemDebugMenuItem& item );
+
+	/**
+	* Renders the IM gui memory window
+	*/
+	void RenderImGuiMemoryWindow( );
+
+	/**
+	 * Copies the current stats into the snapshot used as the baseline for diffs
+	 */
+	void TakeSnapshot( );
+
+	/**
+	 * Writes the difference between the snapshot and the current stats to a text file, returns false on failure
+	 */
+	bool ExportSnapshotDiff( const char* path ) const;
+
+private:
+	/**
+	 * The latest stats for every tag, gathered once a frame. Peaks are sampled at that point so short spikes within a frame are missed
+	 */
+	TagStats mTagStats[AXMEMORY_MAX_TAGS];
+
+	/**
+	 * The stats at the time of the last snapshot
+	 */
+	TagStats mSnapshotStats[AXMEMORY_MAX_TAGS];
+
+	/**
+	 * True once a snapshot has been taken
+	 */
+	bool mHasSnapshot = false;
+
+	/**
+	* If true the memory ImGui window will render
+	*/
+	bool mShouldRenderImGuiMemoryWindow = false;
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Pushes a memory tag for the lifetime of the object
+ */
+class AXMemoryTagScope
+{
+public:
+	AXMemoryTagScope( AXMemoryTracking::Tag tag ) { AXMemoryTracking::PushTag( tag ); }
+	~AXMemoryTagScope( ) { AXMemoryTracking::PopTag( ); }
+
+	AXMemoryTagScope( const AXMemoryTagScope& ) = delete;
+	AXMemoryTagScope& operator = ( const AXMemoryTagScope& ) = delete;
+};
\ No newline at end of file
@@ -0,0 +1,471 @@
+// Copyright 2016 Scott Bevin, All Rights Reserved
+
+#include "AXPerfCounters.h"
+#include "AX/Core/AXLogging.h"
+#include "AX/Core/AXApplication.h"
+
+#include <float.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+template<> AXName AXSystem< AXPerfCounters >::sSystemName = "Perf Counters";
+
+namespace
+{
+	/**
+	* Counter values for a single thread, only the owning thread writes so no cache lines are shared when counting
+	*/
+	struct alignas( AXCACHE_LINE_SIZE ) ThreadCounters
+	{
+		AXAtomic< int64_t > mValues[AXPERFCOUNTERS_MAX_COUNTERS];
+	};
+
+	/**
+	* One set of counters per AXThreadIndex, plus a shared set for threads without an index that is updated with atomic adds
+	*/
+	static ThreadCounters sThreadCounters[AXThreadIndex::MaxThreads + 1];
+
+	/**
+	* Gauges are set rather than accumulated so they can't be sharded, they live in one place
+	*/
+	static AXAtomic< int64_t > sGauges[AXPERFCOUNTERS_MAX_COUNTERS];
+
+	static char sNames[AXPERFCOUNTERS_MAX_COUNTERS][AXPERFCOUNTERS_MAX_NAME] = { };
+	static AXPerfCounters::Kind::E sKinds[AXPERFCOUNTERS_MAX_COUNTERS] = { };
+	static AXAtomic< uint32_t > sNumCounters = 0;
+	static AXAtomic< bool > sRegistryLocked = false;
+
+	/**
+	* Writes a value to a CSV file, quoting it if it holds a separator or a quote
+	*/
+	void WriteCSVString( FILE* file, const char* str )
+	{
+		if( !strpbrk( str, ",\"\n" ) )
+		{
+			fputs( str, file );
+			return;
+		}
+
+		fputc( '"', file );
+
+		for( const char* c( str ); *c != '\0'; ++c )
+		{
+			if( *c == '"' )
+			{
+				fputc( '"', file );
+			}
+
+			fputc( *c, file );
+		}
+
+		fputc( '"', file );
+	}
+}
+
+/**
+* Initialise the system, called after settings are loaded
+*/
+AXPerfCounters::InitResult AXPerfCounters::OnInitialize( )
+{
+	if( AXImGui* imGui = AXImGui::GetFrom( AXApplication::Get( ) ) )
+	{
+		imGui->RegisterSystemDebugMenuItem( "Window/Perf Counters", std::bind( &AXPerfCounters::ImGuiPerfCountersWindowCallback, this, std::placeholders::_1 ) );
+	}
+
+	mHistoryFrames = AXUtils::Max( mSettings->mHistoryFrames.Val( ), ( uint32_t )2 );
+
+	return AXPerfCounters::InitResult::Initialized;
+}
+
+/**
+* Called at the start of every frame
+*/
+void AXPerfCounters::BeginFrame( )
+{
+	TakeSnapshot( );
+}
+
+/**
+* Called once a frame to allow systems to update
+*/
+void AXPerfCounters::Update( float dt )
+{
+	RenderImGuiPerfCountersWindow( );
+}
+
+/**
+* Shutdown the system
+*/
+void AXPerfCounters::OnShutdown( )
+{
+	if( mSettings && mSettings->mDumpOnExit )
+	{
+		TakeSnapshot( );
+		DumpAll( );
+	}
+}
+
+/**
+* Registers a counter or gauge, or returns the existing one with the same name. Returns InvalidId once the registry is full
+*/
+AXPerfCounters::Id AXPerfCounters::Register( const char* name, Kind::E kind )
+{
+	bool expectedLockedFlag = false;
+	do { expectedLockedFlag = false; } while( !sRegistryLocked.compare_exchange_weak( expectedLockedFlag, true ) );
+
+	Id id( InvalidId );
+
+	const uint32_t numCounters( sNumCounters );
+
+	for( uint32_t i( 0 ); i < numCounters && id == InvalidId; ++i )
+	{
+		if( strncmp( sNames[i], name, AXPERFCOUNTERS_MAX_NAME - 1 ) == 0 )
+		{
+			AXASSERT_WARN( sKinds[i] == kind, "Perf counter %s registered as both a counter and a gauge", name );
+			id = static_cast< Id >( i );
+		}
+	}
+
+	if( id == InvalidId && numCounters < AXPERFCOUNTERS_MAX_COUNTERS )
+	{
+		const size_t length( AXUtils::Min( strlen( name ), ( size_t )( AXPERFCOUNTERS_MAX_NAME - 1 ) ) );
+		memcpy( sNames[numCounters], name, length );
+		sNames[numCounters][length] = '\0';
+		sKinds[numCounters] = kind;
+
+		id = static_cast< Id >( numCounters );
+		sNumCounters = numCounters + 1;
+	}
+
+	sRegistryLocked = false;
+
+	return id;
+}
+
+/**
+* Adds to a counter, prefer AXPERF_COUNT
+*/
+void AXPerfCounters::Add( Id id, int64_t val )
+{
+	if( id >= AXPERFCOUNTERS_MAX_COUNTERS )
+	{
+		return;
+	}
+
+	const uint32_t threadIdx( AXThreadIndex::Current( ) );
+
+	if( threadIdx == AXThreadIndex::InvalidIndex )
+	{
+		sThreadCounters[AXThreadIndex::MaxThreads].mValues[id].fetch_add( val, std::memory_order_relaxed );
+	}
+	else
+	{
+		// Only this thread writes its shard, so a plain load and store is enough
+		AXAtomic< int64_t >& counter( sThreadCounters[threadIdx].mValues[id] );
+		counter.store( counter.load( std::memory_order_relaxed ) + val, std::memory_order_relaxed );
+	}
+}
+
+/**
+* Sets a gauge, prefer AXPERF_GAUGE_SET
+*/
+void AXPerfCounters::Set( Id id, int64_t val )
+{
+	if( id < AXPERFCOUNTERS_MAX_COUNTERS )
+	{
+		sGauges[id].store( val, std::memory_order_relaxed );
+	}
+}
+
+/**
+* Adds to a gauge, prefer AXPERF_GAUGE_ADD
+*/
+void AXPerfCounters::AddToGauge( Id id, int64_t val )
+{
+	if( id < AXPERFCOUNTERS_MAX_COUNTERS )
+	{
+		sGauges[id].fetch_add( val, std::memory_order_relaxed );
+	}
+}
+
+/**
+* Returns the current value of a counter or gauge, summing every thread's shard
+*/
+int64_t AXPerfCounters::GatherValue( Id id )
+{
+	if( id >= sNumCounters )
+	{
+		return 0;
+	}
+
+	if( sKinds[id] == Kind::Gauge )
+	{
+		return sGauges[id].load( std::memory_order_relaxed );
+	}
+
+	int64_t total( 0 );
+
+	for( const ThreadCounters& counters : sThreadCounters )
+	{
+		total += counters.mValues[id].load( std::memory_order_relaxed );
+	}
+
+	return total;
+}
+
+/**
+* Returns the name a counter was registered with
+*/
+const char* AXPerfCounters::GetName( Id id )
+{
+	return id < sNumCounters ? sNames[id] : "";
+}
+
+/**
+* Returns whether an id is a counter or a gauge
+*/
+AXPerfCounters::Kind::E AXPerfCounters::GetKind( Id id )
+{
+	return id < sNumCounters ? sKinds[id] : Kind::Counter;
+}
+
+/**
+* Returns the number of registered counters and gauges
+*/
+uint32_t AXPerfCounters::NumCounters( )
+{
+	return sNumCounters;
+}
+
+/**
+* Gathers every counter into the snapshot, called at the start of every frame
+*/
+void AXPerfCounters::TakeSnapshot( )
+{
+	const std::chrono::steady_clock::time_point now( std::chrono::steady_clock::now( ) );
+	const double seconds( mHasSnapshot ? std::chrono::duration< double >( now - mLastSnapshotTime ).count( ) : 0.0 );
+
+	const uint32_t numCounters( NumCounters( ) );
+
+	if( mHistory.size( ) < numCounters )
+	{
+		mHistory.resize( numCounters, std::vector< float >( mHistoryFrames, 0.0f ) );
+	}
+
+	for( uint32_t i( 0 ); i < numCounters; ++i )
+	{
+		Snapshot& snapshot( mSnapshots[i] );
+
+		const int64_t value( GatherValue( static_cast< Id >( i ) ) );
+
+		snapshot.mFrameDelta = value - snapshot.mValue;
+		snapshot.mPerSecond = seconds > 0.0 ? snapshot.mFrameDelta / seconds : 0.0;
+		snapshot.mValue = value;
+
+		if( mHistoryFrames > 0 )
+		{
+			mHistory[i][mHistoryNext] = ( float )( sKinds[i] == Kind::Gauge ? snapshot.mValue : snapshot.mFrameDelta );
+		}
+	}
+
+	if( mHistoryFrames > 0 )
+	{
+		mHistoryNext = ( mHistoryNext + 1 ) % mHistoryFrames;
+		mHistoryCount = AXUtils::Min( mHistoryCount + 1, mHistoryFrames );
+	}
+
+	mLastSnapshotTime = now;
+	mHasSnapshot = true;
+}
+
+/**
+* Adds a "counters" array describing the last snapshot to a JSON object
+*/
+void AXPerfCounters::WriteToJSON( cJSON& jsonRoot ) const
+{
+	cJSON* countersRoot( cJSON_CreateArray( ) );
+
+	if( !countersRoot )
+	{
+		return;
+	}
+
+	cJSON_AddItemToObject( &jsonRoot, "counters", countersRoot );
+
+	const uint32_t numCounters( NumCounters( ) );
+
+	for( uint32_t i( 0 ); i < numCounters; ++i )
+	{
+		if( cJSON* counterRoot = cJSON_CreateObject( ) )
+		{
+			const Snapshot& snapshot( mSnapshots[i] );
+
+			cJSON_AddStringToObject( counterRoot, "name", sNames[i] );
+			cJSON_AddStringToObject( counterRoot, "kind", Kind::ToString( sKinds[i] ) );
+			cJSON_AddNumberToObject( counterRoot, "value", ( double )snapshot.mValue );
+			cJSON_AddNumberToObject( counterRoot, "per_second", snapshot.mPerSecond );
+
+			cJSON_AddItemToArray( countersRoot, counterRoot );
+		}
+	}
+}
+
+/**
+* Writes the last snapshot to a CSV file, returns false on failure
+*/
+bool AXPerfCounters::DumpCSV( const char* path ) const
+{
+	FILE* file( AXUtils::OpenFile( path, "w" ) );
+
+	if( !file )
+	{
+		return false;
+	}
+
+	fprintf( file, "name,kind,value,per_second\n" );
+
+	const uint32_t numCounters( NumCounters( ) );
+
+	for( uint32_t i( 0 ); i < numCounters; ++i )
+	{
+		WriteCSVString( file, sNames[i] );
+		fprintf( file, ",%s,%lld,%.3f\n", Kind::ToString( sKinds[i] ), ( long long )mSnapshots[i].mValue, mSnapshots[i].mPerSecond );
+	}
+
+	const bool succeeded( ferror( file ) == 0 );
+	fclose( file );
+
+	return succeeded;
+}
+
+/**
+* Writes the last snapshot to a JSON file, returns false on failure
+*/
+bool AXPerfCounters::DumpJSON( const char* path ) const
+{
+	cJSON* jsonRoot( cJSON_CreateObject( ) );
+
+	if( !jsonRoot )
+	{
+		return false;
+	}
+
+	WriteToJSON( *jsonRoot );
+
+	bool succeeded( false );
+
+	if( char* buffer = cJSON_Print( jsonRoot ) )
+	{
+		if( FILE* file = AXUtils::OpenFile( path, "w" ) )
+		{
+			const size_t length( strlen( buffer ) );
+			succeeded = fwrite( buffer, 1, length, file ) == length;
+
+			fclose( file );
+		}
+
+		free( buffer );
+	}
+
+	cJSON_Delete( jsonRoot );
+
+	return succeeded;
+}
+
+/**
+* Override to register a settings object for this system
+*/
+void AXPerfCounters::CreateEngineSettings( class AXSettingsFile& settings )
+{
+	mSettings = settings.RegisterNewItem< AXPerfCounters::Settings >( AXPerfCounters::StaticName( ).GetString( ) );
+}
+
+/**
+* A callback function to draw the counters window
+*/
+void AXPerfCounters::ImGuiPerfCountersWindowCallback( AXImGui::SystemDebugMenuItem& item )
+{
+	ImGui::MenuItem( item.mText.c_str( ), "", &mShouldRenderImGuiPerfCountersWindow );
+}
+
+/**
+* Renders the IM gui counters window
+*/
+void AXPerfCounters::RenderImGuiPerfCountersWindow( )
+{
+	if( mShouldRenderImGuiPerfCountersWindow )
+	{
+		if( ImGui::Begin( "Perf Counters", &mShouldRenderImGuiPerfCountersWindow ) )
+		{
+			if( ImGui::Button( "Dump" ) )
+			{
+				DumpAll( );
+			}
+
+			ImGui::SameLine( );
+			ImGui::Text( "%s, %s", mSettings->mCSVFile->c_str( ), mSettings->mJSONFile->c_str( ) );
+
+			ImGui::Separator( );
+
+			ImGui::Columns( 4, "PerfCounters" );
+			ImGui::Text( "Name" ); ImGui::NextColumn( );
+			ImGui::Text( "Value" ); ImGui::NextColumn( );
+			ImGui::Text( "Per Second" ); ImGui::NextColumn( );
+			ImGui::Text( "History" ); ImGui::NextColumn( );
+			ImGui::Separator( );
+
+			const uint32_t numCounters( AXUtils::Min( NumCounters( ), ( uint32_t )mHistory.size( ) ) );
+
+			mScratch.resize( mHistoryCount );
+
+			for( uint32_t i( 0 ); i < numCounters; ++i )
+			{
+				const Snapshot& snapshot( mSnapshots[i] );
+
+				ImGui::Text( "%s", sNames[i] ); ImGui::NextColumn( );
+				ImGui::Text( "%lld", ( long long )snapshot.mValue ); ImGui::NextColumn( );
+
+				if( sKinds[i] == Kind::Counter )
+				{
+					ImGui::Text( "%.1f", snapshot.mPerSecond );
+				}
+
+				ImGui::NextColumn( );
+
+				// Oldest first
+				for( uint32_t frame( 0 ); frame < mHistoryCount; ++frame )
+				{
+					mScratch[frame] = mHistory[i][( mHistoryNext + mHistoryFrames - mHistoryCount + frame ) % mHistoryFrames];
+				}
+
+				ImGui::PushID( ( int )i );
+				ImGui::PlotLines( "##History", mScratch.data( ), ( int )mScratch.size( ), 0, nullptr, FLT_MAX, FLT_MAX, ImVec2( -1.0f, 20.0f ) );
+				ImGui::PopID( );
+				ImGui::NextColumn( );
+			}
+
+			ImGui::Columns( 1 );
+		}
+
+		ImGui::End( );
+	}
+}
+
+/**
+* Writes the last snapshot to both dump files, logging the result
+*/
+void AXPerfCounters::DumpAll( ) const
+{
+	const AXString csvPath( mSettings->mCSVFile.Val( ) );
+	const AXString jsonPath( mSettings->mJSONFile.Val( ) );
+
+	if( DumpCSV( csvPath.c_str( ) ) && DumpJSON( jsonPath.c_str( ) ) )
+	{
+		AXLOG( "Perf Counters", "Wrote perf counters to %s and %s", csvPath.c_str( ), jsonPath.c_str( ) );
+	}
+	else
+	{
+		AXWARN( "Perf Counters", "Failed to write perf counters to %s and %s", csvPath.c_str( ), jsonPath.c_str( ) );
+	}
+}
\ No newline at end of file
@@ -0,0 +1,273 @@
+// Copyright 2016 Scott Bevin, All Rights Reserved
+
+#pragma once
+
+#include "AX/Core/AXSystem.h"
+#include "AX/Core/AXSettings.h"
+#include "AX/Utils/AXParent.h"
+#include "AX/Utils/AXString.h"
+#include "AX/Utils/AXThreadingPrimitives.h"
+#include "AX/Utils/AXUtils.h"
+#include "AX/Graphics/UI/ImGui/AXImGui.h"
+
+#include <chrono>
+#include <stdint.h>
+#include <vector>
+
+/**
+ * Maximum number of distinct counters and gauges, registrations past this are ignored
+ */
+#define AXPERFCOUNTERS_MAX_COUNTERS 256
+
+/**
+ * Longest counter name stored, including the terminator
+ */
+#define AXPERFCOUNTERS_MAX_NAME 48
+
+/**
+ * Adds VAL to the named counter, counters only ever go up and are shown as a total and a rate
+ */
+#define AXPERF_COUNT( NAME, VAL ) \
+	do { \
+		static const AXPerfCounters::Id axPerfCounter( AXPerfCounters::Register( NAME, AXPerfCounters::Kind::Counter ) ); \
+		AXPerfCounters::Add( axPerfCounter, ( int64_t )( VAL ) ); \
+	} while( false )
+
+/**
+ * Sets the named gauge to VAL, gauges hold a level such as a queue depth
+ */
+#define AXPERF_GAUGE_SET( NAME, VAL ) \
+	do { \
+		static const AXPerfCounters::Id axPerfGauge( AXPerfCounters::Register( NAME, AXPerfCounters::Kind::Gauge ) ); \
+		AXPerfCounters::Set( axPerfGauge, ( int64_t )( VAL ) ); \
+	} while( false )
+
+/**
+ * Adds VAL to the named gauge, which may be negative
+ */
+#define AXPERF_GAUGE_ADD( NAME, VAL ) \
+	do { \
+		static const AXPerfCounters::Id axPerfGauge( AXPerfCounters::Register( NAME, AXPerfCounters::Kind::Gauge ) ); \
+		AXPerfCounters::AddToGauge( axPerfGauge, ( int64_t )( VAL ) ); \
+	} while( false )
+
+/**
+ * A registry of named counters and gauges any system can update from any thread. Counters are sharded per thread so updates
+ * never share cache lines, gauges are single relaxed atomics. Values are snapshotted once a frame, shown in a window and can
+ * be dumped to CSV or JSON on demand or on exit
+ */
+class AXPerfCounters : public AXParent< AXSystem< AXPerfCounters >, AXPerfCounters >
+{
+public:
+	using Id = uint16_t;
+
+	static const Id InvalidId = 0xffff;
+
+	struct Kind
+	{
+		enum E
+		{
+			Counter,
+			Gauge,
+		};
+
+		static const char* ToString( E e )
+		{
+			static const char* strings[] = { "Counter", "Gauge" };
+			return strings[e];
+		}
+	};
+
+	class Settings : public AXSettingsFile::SettingsItem
+	{
+	public:
+		/**
+		* Constructor
+		*/
+		Settings( )
+		{
+			RegisterProperty( mHistoryFrames, "History Frames" );
+			RegisterProperty( mDumpOnExit, "Dump On Exit" );
+			RegisterProperty( mCSVFile, "CSV File" );
+			RegisterProperty( mJSONFile, "JSON File" );
+		}
+
+	public:
+		/**
+		 * The number of frames of history graphed for each counter. Applied on initialise
+		 */
+		AXProperty< uint32_t > mHistoryFrames = 120;
+
+		/**
+		 * If true the last snapshot is written to both files when the engine shuts down
+		 */
+		AXProperty< bool > mDumpOnExit = false;
+
+		/**
+		 * Where snapshots are dumped
+		 */
+		AXProperty< AXString > mCSVFile = "PerfCounters.csv";
+		AXProperty< AXString > mJSONFile = "PerfCounters.json";
+	};
+
+	/**
+	 * The value of a counter at the last snapshot
+	 */
+	struct Snapshot
+	{
+		int64_t mValue = 0;
+
+		/**
+		 * How much a counter grew, or a gauge moved, since the previous snapshot
+		 */
+		int64_t mFrameDelta = 0;
+
+		/**
+		 * The frame delta over the time between the snapshots
+		 */
+		double mPerSecond = 0.0;
+	};
+
+public:
+	/**
+	* Initialise the system, called after settings are loaded
+	*/
+	virtual InitResult OnInitialize( ) override;
+
+	/**
+	* Called at the start of every frame
+	*/
+	virtual void BeginFrame( ) override;
+
+	/**
+	* Called once a frame to allow systems to update
+	*/
+	virtual void Update( float dt ) override;
+
+	/**
+	* Shutdown the system
+	*/
+	virtual void OnShutdown( ) override;
+
+	/**
+	 * Registers a counter or gauge, or returns the existing one with the same name. Returns InvalidId once the registry is full
+	 */
+	static Id Register( const char* name, Kind::E kind );
+
+	/**
+	 * Adds to a counter, prefer AXPERF_COUNT
+	 */
+	static void Add( Id id, int64_t val );
+
+	/**
+	 * Sets a gauge, prefer AXPERF_GAUGE_SET
+	 */
+	static void Set( Id id, int64_t val );
+
+	/**
+	 * Adds to a gauge, prefer AXPERF_GAUGE_ADD
+	 */
+	static void AddToGauge( Id id, int64_t val );
+
+	/**
+	 * Returns the current value of a counter or gauge, summing every thread's shard
+	 */
+	static int64_t GatherValue( Id id );
+
+	/**
+	 * Returns the name a counter was registered with
+	 */
+	static const char* GetName( Id id );
+
+	/**
+	 * Returns whether an id is a counter or a gauge
+	 */
+	static Kind::E GetKind( Id id );
+
+	/**
+	 * Returns the number of registered counters and gauges
+	 */
+	static uint32_t NumCounters( );
+
+	/**
+	 * Returns the value of a counter at the last snapshot
+	 */
+	const Snapshot& GetSnapshot( Id id ) const { return mSnapshots[id < AXPERFCOUNTERS_MAX_COUNTERS ? id : 0]; }
+
+	/**
+	 * Gathers every counter into the snapshot, called at the start of every frame
+	 */
+	void TakeSnapshot( );
+
+	/**
+	 * Adds a "counters" array describing the last snapshot to a JSON object
+	 */
+	void WriteToJSON( cJSON& jsonRoot ) const;
+
+	/**
+	 * Writes the last snapshot to a CSV file, returns false on failure
+	 */
+	bool DumpCSV( const char* path ) const;
+
+	/**
+	 * Writes the last snapshot to a JSON file, returns false on failure
+	 */
+	bool DumpJSON( const char* path ) const;
+
+protected:
+	/**
+	* Override to register a settings object for this system
+	*/
+	virtual void CreateEngineSettings( class AXSettingsFile& settings ) override;
+
+private:
+	/**
+	* A callback function to draw the counters window
+	*/
+	void ImGuiPerfCountersWindowCallback( AXImGui::SystemDebugMenuItem& item );
+
+	/**
+	* Renders the IM gui counters window
+	*/
+	void RenderImGuiPerfCountersWindow( );
+
+	/**
+	 * Writes the last snapshot to both dump files, logging the result
+	 */
+	void DumpAll( ) const;
+
+private:
+	/**
+	* Pointer to the created settings object
+	*/
+	Settings* mSettings = nullptr;
+
+	/**
+	 * Every counter at the last snapshot
+	 */
+	Snapshot mSnapshots[AXPERFCOUNTERS_MAX_COUNTERS];
+
+	/**
+	 * When the last snapshot was taken, rates are over the time since
+	 */
+	std::chrono::steady_clock::time_point mLastSnapshotTime;
+	bool mHasSnapshot = false;
+
+	/**
+	 * Frame deltas of counters and values of gauges for the last mHistoryFrames snapshots, one ring per counter sharing a cursor
+	 */
+	std::vector< std::vector< float > > mHistory;
+	uint32_t mHistoryFrames = 0;
+	uint32_t mHistoryNext = 0;
+	uint32_t mHistoryCount = 0;
+
+	/**
+	 * Reused to unroll a history ring for graphing
+	 */
+	std::vector< float > mScratch;
+
+	/**
+	* If true the counters ImGui window will render
+	*/
+	bool mShouldRenderImGuiPerfCountersWindow = false;
+};
\ No newline at end of file
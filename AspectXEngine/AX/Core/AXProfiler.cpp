@@ -0,0 +1,802 @@
+// Copyright 2016 Scott Bevin, All Rights Reserved
+
+#include "AXProfiler.h"
+#include "AX/Core/AXLogging.h"
+#include "AX/Core/AXApplication.h"
+#include "AX/Core/AXPerfCounters.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+
+template<> AXName AXSystem< AXProfiler >::sSystemName = "Profiler";
+
+/**
+* The generation of the running capture, 0 while nothing is being captured
+*/
+AXAtomic< uint32_t > AXProfiler::sCaptureGeneration = 0;
+
+/**
+* True while scopes are recorded into the hitch rings
+*/
+AXAtomic< bool > AXProfiler::sHitchCapturing = false;
+
+namespace
+{
+	/**
+	* A finished scope
+	*/
+	struct ProfileEvent
+	{
+		const char* mName;
+		uint64_t mBeginTicks;
+		uint64_t mEndTicks;
+
+		/**
+		* One past the index of the scope's hardware counters in the thread's counter blocks, 0 if none were read. In a hitch
+		* ring non zero if the counters are in the same slot of the ring's counters
+		*/
+		uint32_t mCountersIdx;
+	};
+
+	/**
+	* The scopes recorded by a single thread. Only the owning thread writes events, publishing them by storing mNumEvents, so
+	* the exporter can read the first mNumEvents events of the generation it is exporting without stopping the thread
+	*/
+	struct alignas( AXCACHE_LINE_SIZE ) ThreadBuffer
+	{
+		ProfileEvent* mBlocks[AXPROFILER_MAX_BLOCKS_PER_THREAD] = { };
+		AXAtomic< uint32_t > mGeneration = 0;
+		AXAtomic< uint32_t > mNumEvents = 0;
+		AXAtomic< uint32_t > mNumDropped = 0;
+		char mName[AXPROFILER_MAX_THREAD_NAME] = { };
+
+		/**
+		* Hardware counters of counted scopes, stored apart so scopes without them cost nothing extra. Only written before the
+		* scope that refers to them is published
+		*/
+		AXHardwareCounters::Values* mCounterBlocks[AXPROFILER_MAX_BLOCKS_PER_THREAD] = { };
+		uint32_t mNumCounters = 0;
+
+		/**
+		* The latest scopes while hitches are captured, allocated the first time the thread records one. Slots are overwritten in
+		* order, mHitchRingWritten counting every scope ever written and publishing each once it is complete
+		*/
+		ProfileEvent* mHitchRing = nullptr;
+		AXHardwareCounters::Values* mHitchRingCounters = nullptr;
+		uint32_t mHitchRingSize = 0;
+		AXAtomic< uint64_t > mHitchRingWritten = 0;
+
+		~ThreadBuffer( )
+		{
+			delete[] mHitchRing;
+			delete[] mHitchRingCounters;
+
+			for( ProfileEvent* block : mBlocks )
+			{
+				delete[] block;
+			}
+
+			for( AXHardwareCounters::Values* block : mCounterBlocks )
+			{
+				delete[] block;
+			}
+		}
+	};
+
+	/**
+	* One buffer per AXThreadIndex, created by the owning thread the first time it records. Threads without an index are not profiled
+	*/
+	struct ThreadBufferTable
+	{
+		AXAtomic< ThreadBuffer* > mBuffers[AXThreadIndex::MaxThreads] = { };
+
+		~ThreadBufferTable( )
+		{
+			for( AXAtomic< ThreadBuffer* >& buffer : mBuffers )
+			{
+				delete buffer.load( );
+			}
+		}
+	};
+
+	static ThreadBufferTable sThreadBuffers;
+	static AXAtomic< uint32_t > sMaxEventsPerThread = AXPROFILER_EVENTS_PER_BLOCK * AXPROFILER_MAX_BLOCKS_PER_THREAD;
+	static AXAtomic< uint32_t > sHitchEventsPerThread = 64 * 1024;
+	static AXAtomic< bool > sThreadNamesLocked = false;
+
+	static thread_local ThreadBuffer* tThreadBuffer = nullptr;
+
+	/**
+	* Returns the calling thread's buffer, creating it on first use. Returns nullptr for threads without an index
+	*/
+	ThreadBuffer* GetThreadBuffer( )
+	{
+		if( !tThreadBuffer )
+		{
+			const uint32_t threadIdx( AXThreadIndex::Current( ) );
+
+			if( threadIdx == AXThreadIndex::InvalidIndex )
+			{
+				return nullptr;
+			}
+
+			tThreadBuffer = new ThreadBuffer( );
+			sThreadBuffers.mBuffers[threadIdx].store( tThreadBuffer, std::memory_order_release );
+		}
+
+		return tThreadBuffer;
+	}
+
+	void LockThreadNames( )
+	{
+		bool expectedLockedFlag = false;
+		do { expectedLockedFlag = false; } while( !sThreadNamesLocked.compare_exchange_weak( expectedLockedFlag, true ) );
+	}
+
+	void UnlockThreadNames( )
+	{
+		sThreadNamesLocked = false;
+	}
+
+	/**
+	* Stores a finished scope in a thread's hitch ring, overwriting the oldest
+	*/
+	void RecordHitchScope( ThreadBuffer& buffer, const char* name, uint64_t beginTicks, uint64_t endTicks, const AXHardwareCounters::Values* counters )
+	{
+		if( !buffer.mHitchRing )
+		{
+			buffer.mHitchRingSize = AXUtils::Max( sHitchEventsPerThread.load( std::memory_order_relaxed ), ( uint32_t )1 );
+			buffer.mHitchRing = new ProfileEvent[buffer.mHitchRingSize];
+		}
+
+		const uint64_t written( buffer.mHitchRingWritten.load( std::memory_order_relaxed ) );
+		const uint32_t slot( ( uint32_t )( written % buffer.mHitchRingSize ) );
+
+		ProfileEvent& event( buffer.mHitchRing[slot] );
+		event.mName = name;
+		event.mBeginTicks = beginTicks;
+		event.mEndTicks = endTicks;
+		event.mCountersIdx = 0;
+
+		if( counters )
+		{
+			if( !buffer.mHitchRingCounters )
+			{
+				buffer.mHitchRingCounters = new AXHardwareCounters::Values[buffer.mHitchRingSize];
+			}
+
+			buffer.mHitchRingCounters[slot] = *counters;
+			event.mCountersIdx = 1;
+		}
+
+		buffer.mHitchRingWritten.store( written + 1, std::memory_order_release );
+	}
+
+	/**
+	* Copies a thread's name, so it can't change part way through being written
+	*/
+	void CopyThreadName( const ThreadBuffer& buffer, char ( &outName )[AXPROFILER_MAX_THREAD_NAME] )
+	{
+		LockThreadNames( );
+		memcpy( outName, buffer.mName, sizeof( outName ) );
+		UnlockThreadNames( );
+	}
+
+	/**
+	* Writes a string as a JSON string literal
+	*/
+	void WriteJSONString( FILE* file, const char* str )
+	{
+		fputc( '"', file );
+
+		for( const char* c( str ); *c != '\0'; ++c )
+		{
+			if( *c == '"' || *c == '\\' )
+			{
+				fputc( '\\', file );
+				fputc( *c, file );
+			}
+			else if( ( unsigned char )*c < 0x20 )
+			{
+				fprintf( file, "\\u%04x", ( unsigned int )( unsigned char )*c );
+			}
+			else
+			{
+				fputc( *c, file );
+			}
+		}
+
+		fputc( '"', file );
+	}
+
+	/**
+	* Writes hardware counters as the args of a trace event
+	*/
+	void WriteCountersJSON( FILE* file, const AXHardwareCounters::Values& counters )
+	{
+		fprintf( file, ",\"args\":{" );
+
+		for( uint32_t i( 0 ); i < AXHardwareCounters::Counter::MaxCounters; ++i )
+		{
+			fprintf( file, "\"%s\":%llu,", AXHardwareCounters::Counter::ToJSONName( ( AXHardwareCounters::Counter::E )i ), ( unsigned long long )counters.mCounts[i] );
+		}
+
+		fprintf( file, "\"ipc\":%.3f}", counters.IPC( ) );
+	}
+
+	/**
+	* Writes the trace event naming a thread
+	*/
+	void WriteThreadNameJSON( FILE* file, uint32_t threadIdx, const char* name, bool firstEvent )
+	{
+		fprintf( file, "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":%u,\"args\":{\"name\":", firstEvent ? "" : ",\n", threadIdx );
+		WriteJSONString( file, name[0] != '\0' ? name : "Unnamed Thread" );
+		fprintf( file, "}}" );
+	}
+
+	/**
+	* Writes a scope as a trace event, times are relative to originTicks. Scopes that began before it are clamped to it
+	*/
+	void WriteScopeJSON( FILE* file, uint32_t threadIdx, const ProfileEvent& event, const AXHardwareCounters::Values* counters, uint64_t originTicks, double microsecondsPerTick )
+	{
+		const uint64_t beginTicks( AXUtils::Max( event.mBeginTicks, originTicks ) );
+		const uint64_t endTicks( AXUtils::Max( event.mEndTicks, beginTicks ) );
+
+		fprintf( file, ",\n{\"name\":" );
+		WriteJSONString( file, event.mName );
+		fprintf( file, ",\"ph\":\"X\",\"pid\":0,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f", threadIdx,
+			( double )( beginTicks - originTicks ) * microsecondsPerTick, ( double )( endTicks - beginTicks ) * microsecondsPerTick );
+
+		if( counters )
+		{
+			WriteCountersJSON( file, *counters );
+		}
+
+		fputc( '}', file );
+	}
+}
+
+/**
+* Override to handle command line arguments, gets called after create settings
+*/
+void AXProfiler::HandleCommandLine( const std::vector< AXString >& args )
+{
+	for( const AXString& arg : args )
+	{
+		if( arg == "-hwcounters" )
+		{
+			mHardwareCountersFromCommandLine = true;
+		}
+		else if( arg == "-capture" )
+		{
+			mCaptureFromCommandLine = true;
+		}
+		else if( arg == "-hitches" )
+		{
+			mHitchCaptureFromCommandLine = true;
+		}
+		else if( arg.compare( 0, 9, "-hitchms=" ) == 0 )
+		{
+			mHitchCaptureFromCommandLine = true;
+			mHitchThresholdMsFromCommandLine = ( int32_t )strtol( arg.c_str( ) + 9, nullptr, 10 );
+		}
+	}
+}
+
+/**
+* Initialise the system, called after settings are loaded
+*/
+AXProfiler::InitResult AXProfiler::OnInitialize( )
+{
+	if( AXImGui* imGui = AXImGui::GetFrom( AXApplication::Get( ) ) )
+	{
+		imGui->RegisterSystemDebugMenuItem( "Profiler/Capture CPU Trace", std::bind( &AXProfiler::ImGuiCaptureMenuCallback, this, std::placeholders::_1 ) );
+		imGui->RegisterSystemDebugMenuItem( "Profiler/Hardware Counters", std::bind( &AXProfiler::ImGuiHardwareCountersMenuCallback, this, std::placeholders::_1 ) );
+		imGui->RegisterSystemDebugMenuItem( "Profiler/Capture Hitches", std::bind( &AXProfiler::ImGuiHitchCaptureMenuCallback, this, std::placeholders::_1 ) );
+	}
+
+	if( !IsEnabled( ) )
+	{
+		AXLOG( "Profiler", "Profiling is disabled, build with AXPROFILING to enable it" );
+	}
+
+	const uint32_t maxEvents( AXUtils::Max( mSettings->mMaxEventsPerThread.Val( ), ( uint32_t )AXPROFILER_EVENTS_PER_BLOCK ) );
+	sMaxEventsPerThread = AXUtils::Min( maxEvents, ( uint32_t )( AXPROFILER_EVENTS_PER_BLOCK * AXPROFILER_MAX_BLOCKS_PER_THREAD ) );
+
+	SetThreadName( "Main Thread" );
+
+	if( mSettings->mHardwareCounters || mHardwareCountersFromCommandLine )
+	{
+		// Try the main thread's counters now, so a machine that can't open them runs without rather than failing every read
+		AXHardwareCounters::Values values;
+		AXHardwareCounters::SetEnabled( AXHardwareCounters::Read( values ) );
+
+		if( !AXHardwareCounters::IsEnabled( ) )
+		{
+			AXWARN( "Profiler", "Hardware counters are unavailable, running without them" );
+		}
+	}
+
+	if( mCaptureFromCommandLine )
+	{
+		BeginCapture( );
+	}
+
+	sHitchEventsPerThread = AXUtils::Max( mSettings->mHitchEventsPerThread.Val( ), ( uint32_t )1 );
+
+	if( mSettings->mHitchCapture || mHitchCaptureFromCommandLine )
+	{
+		SetHitchCapture( true );
+	}
+
+	return AXProfiler::InitResult::Initialized;
+}
+
+/**
+* Called at the start of every frame
+*/
+void AXProfiler::BeginFrame( )
+{
+	if( !IsHitchCapturing( ) )
+	{
+		return;
+	}
+
+	FrameStart frameStart;
+	frameStart.mTicks = Now( );
+	frameStart.mTime = std::chrono::steady_clock::now( );
+
+	const uint32_t ringSize( AXPROFILER_MAX_HITCH_FRAMES + 1 );
+
+	if( mNumFrameStarts > 0 )
+	{
+		// The command line threshold is kept apart from the setting so it isn't saved to the settings file
+		const uint32_t thresholdMs( mHitchThresholdMsFromCommandLine >= 0 ? ( uint32_t )mHitchThresholdMsFromCommandLine : mSettings->mHitchThresholdMs.Val( ) );
+		const float frameMs( mLastFrameMs );
+
+		if( frameMs > ( float )thresholdMs )
+		{
+			AXPERF_COUNT( "Profiler/Hitches", 1 );
+
+			const uint32_t frameIdx( AXApplication::Get( ).GetFrameCount( ) );
+
+			if( mNumHitchTraces < mSettings->mMaxHitchTraces )
+			{
+				const uint32_t numKeptFrames( AXUtils::Min( mSettings->mHitchFrames.Val( ), mNumFrameStarts - 1 ) );
+
+				mHitchBegin = mFrameStarts[( mNextFrameStart + ringSize - 1 - numKeptFrames ) % ringSize];
+				mHitchEnd = frameStart;
+
+				const AXString path( AXUtils::FormatString( "%s_%u.json", mSettings->mHitchTracePrefix->c_str( ), frameIdx ) );
+
+				if( ExportHitchTrace( path.c_str( ) ) )
+				{
+					++mNumHitchTraces;
+					AXWARN( "Profiler", "Frame %u took %.2f ms, wrote it and the %u frames before to %s", frameIdx, frameMs, numKeptFrames, path.c_str( ) );
+				}
+				else
+				{
+					AXWARN( "Profiler", "Frame %u took %.2f ms, failed to write a hitch trace to %s", frameIdx, frameMs, path.c_str( ) );
+				}
+			}
+			else
+			{
+				AXWARNONCE( "Profiler", "Written the most hitch traces allowed, raise Max Hitch Traces to write more" );
+			}
+
+			// Writing the trace took some of this frame, start again from the next one so it isn't mistaken for a hitch
+			mNumFrameStarts = 0;
+			return;
+		}
+	}
+
+	mFrameStarts[mNextFrameStart] = frameStart;
+	mNextFrameStart = ( mNextFrameStart + 1 ) % ringSize;
+	mNumFrameStarts = AXUtils::Min( mNumFrameStarts + 1, ringSize );
+}
+
+/**
+* Called by the engine loop once a frame's work is done with how long it took, not counting the frame cap's sleep
+*/
+void AXProfiler::AddFrameTime( float ms )
+{
+	mLastFrameMs = ms;
+}
+
+/**
+* Shutdown the system
+*/
+void AXProfiler::OnShutdown( )
+{
+	if( IsCapturing( ) )
+	{
+		EndCapture( );
+	}
+}
+
+/**
+* Starts a new capture, discarding the previous one
+*/
+void AXProfiler::BeginCapture( )
+{
+	if( !IsEnabled( ) || IsCapturing( ) )
+	{
+		return;
+	}
+
+	++mLastGeneration;
+
+	mCaptureBeginTime = std::chrono::steady_clock::now( );
+	mCaptureBeginTicks = Now( );
+
+	sCaptureGeneration = mLastGeneration;
+
+	AXLOG( "Profiler", "Started CPU capture" );
+}
+
+/**
+* Stops the running capture and writes it to the trace file
+*/
+void AXProfiler::EndCapture( )
+{
+	if( !IsCapturing( ) )
+	{
+		return;
+	}
+
+	sCaptureGeneration = 0;
+
+	mCaptureEndTicks = Now( );
+	mCaptureEndTime = std::chrono::steady_clock::now( );
+
+	const AXString path( mSettings->mTraceFile.Val( ) );
+
+	if( ExportChromeTrace( path.c_str( ) ) )
+	{
+		AXLOG( "Profiler", "Wrote CPU capture to %s", path.c_str( ) );
+	}
+	else
+	{
+		AXWARN( "Profiler", "Failed to write CPU capture to %s", path.c_str( ) );
+	}
+}
+
+/**
+* Writes the last capture to a Chrome trace JSON file, returns false on failure
+*/
+bool AXProfiler::ExportChromeTrace( const char* path ) const
+{
+	if( mLastGeneration == 0 )
+	{
+		return false;
+	}
+
+	FILE* file( AXUtils::OpenFile( path, "w" ) );
+
+	if( !file )
+	{
+		return false;
+	}
+
+	// Traces run to millions of events, a large buffer keeps the writes from dominating the export
+	setvbuf( file, nullptr, _IOFBF, 1024 * 1024 );
+
+	const double captureMicroseconds( std::chrono::duration< double, std::micro >( mCaptureEndTime - mCaptureBeginTime ).count( ) );
+	const double microsecondsPerTick( mCaptureEndTicks > mCaptureBeginTicks ? captureMicroseconds / ( double )( mCaptureEndTicks - mCaptureBeginTicks ) : 0.0 );
+
+	fprintf( file, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n" );
+
+	bool firstEvent( true );
+	uint32_t numDropped( 0 );
+
+	for( uint32_t threadIdx( 0 ); threadIdx < AXThreadIndex::MaxThreads; ++threadIdx )
+	{
+		const ThreadBuffer* buffer( sThreadBuffers.mBuffers[threadIdx].load( std::memory_order_acquire ) );
+
+		if( !buffer || buffer->mGeneration.load( std::memory_order_acquire ) != mLastGeneration )
+		{
+			continue;
+		}
+
+		const uint32_t numEvents( buffer->mNumEvents.load( std::memory_order_acquire ) );
+		numDropped += buffer->mNumDropped.load( std::memory_order_relaxed );
+
+		char threadName[AXPROFILER_MAX_THREAD_NAME];
+		CopyThreadName( *buffer, threadName );
+
+		WriteThreadNameJSON( file, threadIdx, threadName, firstEvent );
+		firstEvent = false;
+
+		for( uint32_t i( 0 ); i < numEvents; ++i )
+		{
+			const ProfileEvent& event( buffer->mBlocks[i / AXPROFILER_EVENTS_PER_BLOCK][i % AXPROFILER_EVENTS_PER_BLOCK] );
+			const uint32_t countersIdx( event.mCountersIdx - 1 );
+
+			WriteScopeJSON( file, threadIdx, event, event.mCountersIdx != 0 ? &buffer->mCounterBlocks[countersIdx / AXPROFILER_EVENTS_PER_BLOCK][countersIdx % AXPROFILER_EVENTS_PER_BLOCK] : nullptr,
+				mCaptureBeginTicks, microsecondsPerTick );
+		}
+	}
+
+	fprintf( file, "\n]}\n" );
+
+	const bool succeeded( ferror( file ) == 0 );
+	fclose( file );
+
+	if( numDropped > 0 )
+	{
+		AXWARN( "Profiler", "Dropped %u scopes, raise Max Events Per Thread to keep them", numDropped );
+	}
+
+	return succeeded;
+}
+
+/**
+* Turns recording scopes into each thread's hitch ring on or off
+*/
+void AXProfiler::SetHitchCapture( bool enabled )
+{
+	if( !IsEnabled( ) || enabled == IsHitchCapturing( ) )
+	{
+		return;
+	}
+
+	mNumFrameStarts = 0;
+	sHitchCapturing = enabled;
+
+	if( enabled )
+	{
+		AXLOG( "Profiler", "Capturing hitches over %u ms, keeping up to %u scopes per thread", mSettings->mHitchThresholdMs.Val( ), sHitchEventsPerThread.load( ) );
+	}
+	else
+	{
+		AXLOG( "Profiler", "Stopped capturing hitches" );
+	}
+}
+
+/**
+* Writes every scope in the hitch rings overlapping the kept frames and the hitch to a Chrome trace JSON file, returns false
+* on failure
+*/
+bool AXProfiler::ExportHitchTrace( const char* path ) const
+{
+	FILE* file( AXUtils::OpenFile( path, "w" ) );
+
+	if( !file )
+	{
+		return false;
+	}
+
+	setvbuf( file, nullptr, _IOFBF, 1024 * 1024 );
+
+	const double hitchMicroseconds( std::chrono::duration< double, std::micro >( mHitchEnd.mTime - mHitchBegin.mTime ).count( ) );
+	const double microsecondsPerTick( mHitchEnd.mTicks > mHitchBegin.mTicks ? hitchMicroseconds / ( double )( mHitchEnd.mTicks - mHitchBegin.mTicks ) : 0.0 );
+
+	fprintf( file, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n" );
+
+	bool firstEvent( true );
+
+	std::vector< ProfileEvent > events;
+	std::vector< AXHardwareCounters::Values > counters;
+
+	for( uint32_t threadIdx( 0 ); threadIdx < AXThreadIndex::MaxThreads; ++threadIdx )
+	{
+		const ThreadBuffer* buffer( sThreadBuffers.mBuffers[threadIdx].load( std::memory_order_acquire ) );
+
+		if( !buffer )
+		{
+			continue;
+		}
+
+		const uint64_t written( buffer->mHitchRingWritten.load( std::memory_order_acquire ) );
+
+		if( written == 0 )
+		{
+			continue;
+		}
+
+		// Other threads keep recording while the ring is copied, so copy it first and then drop any slot that may have been
+		// overwritten part way through
+		const uint64_t firstCopied( written > buffer->mHitchRingSize ? written - buffer->mHitchRingSize : 0 );
+
+		events.clear( );
+		counters.clear( );
+
+		for( uint64_t i( firstCopied ); i < written; ++i )
+		{
+			const uint32_t slot( ( uint32_t )( i % buffer->mHitchRingSize ) );
+
+			events.push_back( buffer->mHitchRing[slot] );
+			counters.push_back( events.back( ).mCountersIdx != 0 ? buffer->mHitchRingCounters[slot] : AXHardwareCounters::Values( ) );
+		}
+
+		std::atomic_thread_fence( std::memory_order_acquire );
+
+		const uint64_t writtenAfterCopy( buffer->mHitchRingWritten.load( std::memory_order_relaxed ) );
+		const uint64_t firstIntact( writtenAfterCopy >= buffer->mHitchRingSize ? writtenAfterCopy + 1 - buffer->mHitchRingSize : 0 );
+		const size_t numOverwritten( ( size_t )( AXUtils::Min( AXUtils::Max( firstIntact, firstCopied ), written ) - firstCopied ) );
+
+		char threadName[AXPROFILER_MAX_THREAD_NAME];
+		CopyThreadName( *buffer, threadName );
+
+		WriteThreadNameJSON( file, threadIdx, threadName, firstEvent );
+		firstEvent = false;
+
+		for( size_t i( numOverwritten ); i < events.size( ); ++i )
+		{
+			const ProfileEvent& event( events[i] );
+
+			if( event.mEndTicks >= mHitchBegin.mTicks && event.mBeginTicks <= mHitchEnd.mTicks )
+			{
+				WriteScopeJSON( file, threadIdx, event, event.mCountersIdx != 0 ? &counters[i] : nullptr, mHitchBegin.mTicks, microsecondsPerTick );
+			}
+		}
+	}
+
+	fprintf( file, "\n]}\n" );
+
+	const bool succeeded( ferror( file ) == 0 );
+	fclose( file );
+
+	return succeeded;
+}
+
+/**
+* Returns true if the engine was built with AXPROFILING
+*/
+bool AXProfiler::IsEnabled( )
+{
+#if defined( AXPROFILING )
+	return true;
+#else
+	return false;
+#endif // #if defined( AXPROFILING )
+}
+
+/**
+* Stores a finished scope in the calling thread's buffer if generation is a capture, and in its hitch ring while hitches are
+* captured. Prefer AXPROFILE_SCOPE. counters is the change in hardware counters over the scope, if they were read
+*/
+void AXProfiler::RecordScope( const char* name, uint64_t beginTicks, uint64_t endTicks, uint32_t generation, const AXHardwareCounters::Values* counters )
+{
+	ThreadBuffer* buffer( GetThreadBuffer( ) );
+
+	if( !buffer )
+	{
+		return;
+	}
+
+	if( IsHitchCapturing( ) )
+	{
+		RecordHitchScope( *buffer, name, beginTicks, endTicks, counters );
+	}
+
+	if( generation == 0 )
+	{
+		return;
+	}
+
+	uint32_t numEvents( buffer->mNumEvents.load( std::memory_order_relaxed ) );
+	const uint32_t bufferGeneration( buffer->mGeneration.load( std::memory_order_relaxed ) );
+
+	if( bufferGeneration != generation )
+	{
+		// A scope that began in an earlier capture and ended after a newer one started belongs to neither
+		if( generation < bufferGeneration )
+		{
+			return;
+		}
+
+		numEvents = 0;
+		buffer->mNumCounters = 0;
+		buffer->mNumEvents.store( 0, std::memory_order_relaxed );
+		buffer->mNumDropped.store( 0, std::memory_order_relaxed );
+		buffer->mGeneration.store( generation, std::memory_order_release );
+	}
+
+	if( numEvents >= sMaxEventsPerThread.load( std::memory_order_relaxed ) )
+	{
+		buffer->mNumDropped.store( buffer->mNumDropped.load( std::memory_order_relaxed ) + 1, std::memory_order_relaxed );
+		return;
+	}
+
+	ProfileEvent*& block( buffer->mBlocks[numEvents / AXPROFILER_EVENTS_PER_BLOCK] );
+
+	if( !block )
+	{
+		block = new ProfileEvent[AXPROFILER_EVENTS_PER_BLOCK];
+	}
+
+	ProfileEvent& event( block[numEvents % AXPROFILER_EVENTS_PER_BLOCK] );
+	event.mName = name;
+	event.mBeginTicks = beginTicks;
+	event.mEndTicks = endTicks;
+	event.mCountersIdx = 0;
+
+	if( counters )
+	{
+		// There are never more counted scopes than scopes, so the counter blocks can't run out before the event blocks
+		AXHardwareCounters::Values*& countersBlock( buffer->mCounterBlocks[buffer->mNumCounters / AXPROFILER_EVENTS_PER_BLOCK] );
+
+		if( !countersBlock )
+		{
+			countersBlock = new AXHardwareCounters::Values[AXPROFILER_EVENTS_PER_BLOCK];
+		}
+
+		countersBlock[buffer->mNumCounters % AXPROFILER_EVENTS_PER_BLOCK] = *counters;
+		event.mCountersIdx = ++buffer->mNumCounters;
+	}
+
+	buffer->mNumEvents.store( numEvents + 1, std::memory_order_release );
+}
+
+/**
+* Names the calling thread in exported traces
+*/
+void AXProfiler::SetThreadName( const char* name )
+{
+	if( ThreadBuffer* buffer = GetThreadBuffer( ) )
+	{
+		const size_t length( AXUtils::Min( strlen( name ), ( size_t )( AXPROFILER_MAX_THREAD_NAME - 1 ) ) );
+
+		LockThreadNames( );
+		memcpy( buffer->mName, name, length );
+		buffer->mName[length] = '\0';
+		UnlockThreadNames( );
+	}
+}
+
+/**
+* Override to register a settings object for this system
+*/
+void AXProfiler::CreateEngineSettings( class AXSettingsFile& settings )
+{
+	mSettings = settings.RegisterNewItem< AXProfiler::Settings >( AXProfiler::StaticName( ).GetString( ) );
+}
+
+/**
+* A callback function to draw the capture toggle
+*/
+void AXProfiler::ImGuiCaptureMenuCallback( AXImGui::SystemDebugMenuItem& item )
+{
+	bool capturing( IsCapturing( ) );
+
+	if( ImGui::MenuItem( item.mText.c_str( ), "", &capturing, IsEnabled( ) ) )
+	{
+		if( capturing )
+		{
+			BeginCapture( );
+		}
+		else
+		{
+			EndCapture( );
+		}
+	}
+}
+
+/**
+* A callback function to draw the hitch capture toggle
+*/
+void AXProfiler::ImGuiHitchCaptureMenuCallback( AXImGui::SystemDebugMenuItem& item )
+{
+	bool capturing( IsHitchCapturing( ) );
+
+	if( ImGui::MenuItem( item.mText.c_str( ), "", &capturing, IsEnabled( ) ) )
+	{
+		SetHitchCapture( capturing );
+	}
+}
+
+/**
+* A callback function to draw the hardware counters toggle
+*/
+void AXProfiler::ImGuiHardwareCountersMenuCallback( AXImGui::SystemDebugMenuItem& item )
+{
+	bool enabled( AXHardwareCounters::IsEnabled( ) );
+
+	if( ImGui::MenuItem( item.mText.c_str( ), "", &enabled, AXHardwareCounters::IsSupported( ) ) )
+	{
+		AXHardwareCounters::SetEnabled( enabled );
+	}
+}
\ No newline at end of file
@@ -0,0 +1,431 @@
+// Copyright 2016 Scott Bevin, All Rights Reserved
+
+#pragma once
+
+#include "AX/Core/AXSystem.h"
+#include "AX/Core/AXSettings.h"
+#include "AX/Core/AXHardwareCounters.h"
+#include "AX/Utils/AXParent.h"
+#include "AX/Utils/AXString.h"
+#include "AX/Utils/AXThreadingPrimitives.h"
+#include "AX/Utils/AXUtils.h"
+#include "AX/Graphics/UI/ImGui/AXImGui.h"
+
+#include <chrono>
+#include <stdint.h>
+
+#if defined( _MSC_VER )
+#include <intrin.h>
+#elif defined( __x86_64__ ) || defined( __i386__ )
+#include <x86intrin.h>
+#endif
+
+/**
+ * Number of scopes stored in each block of a thread's buffer, blocks are allocated the first time a thread fills the last one
+ */
+#define AXPROFILER_EVENTS_PER_BLOCK 4096
+
+/**
+ * Most blocks a single thread's buffer can grow to, scopes past the end are counted as dropped
+ */
+#define AXPROFILER_MAX_BLOCKS_PER_THREAD 1024
+
+/**
+ * Longest thread name stored, including the terminator
+ */
+#define AXPROFILER_MAX_THREAD_NAME 64
+
+/**
+ * Most frames of history a hitch trace can hold, not counting the hitch itself
+ */
+#define AXPROFILER_MAX_HITCH_FRAMES 256
+
+#if defined( AXPROFILING )
+
+/**
+ * Records the time spent until the end of the enclosing scope while a capture is running. NAME must outlive the capture,
+ * string literals and AXName strings are fine
+ */
+#define AXPROFILE_SCOPE( NAME ) AXProfileScope AXJOIN( axProfileScope, __LINE__ )( NAME )
+
+/**
+ * As AXPROFILE_SCOPE, also recording the calling thread's hardware counters over the scope while they are enabled
+ */
+#define AXPROFILE_SCOPE_COUNTERS( NAME ) AXProfileCountersScope AXJOIN( axProfileScope, __LINE__ )( NAME )
+
+#else
+
+#define AXPROFILE_SCOPE( NAME ) do { } while( false )
+#define AXPROFILE_SCOPE_COUNTERS( NAME ) do { } while( false )
+
+#endif // #if defined( AXPROFILING )
+
+/**
+ * A CPU scope profiler. Scopes are written to a buffer owned by the recording thread so recording never takes a lock, and a
+ * capture is exported as a Chrome trace that chrome://tracing and Perfetto can open. Captures are started and stopped from the
+ * main thread. While hitch capture is on every thread also keeps its latest scopes in a fixed size ring, and a frame that runs
+ * over the hitch threshold writes the frames before it and itself to a trace
+ */
+class AXProfiler : public AXParent< AXSystem< AXProfiler >, AXProfiler >
+{
+public:
+	class Settings : public AXSettingsFile::SettingsItem
+	{
+	public:
+		/**
+		* Constructor
+		*/
+		Settings( )
+		{
+			RegisterProperty( mTraceFile, "Trace File" );
+			RegisterProperty( mMaxEventsPerThread, "Max Events Per Thread" );
+			RegisterProperty( mHardwareCounters, "Hardware Counters" );
+			RegisterProperty( mHitchCapture, "Hitch Capture" );
+			RegisterProperty( mHitchThresholdMs, "Hitch Threshold Ms" );
+			RegisterProperty( mHitchFrames, "Hitch Frames" );
+			RegisterProperty( mHitchEventsPerThread, "Hitch Events Per Thread" );
+			RegisterProperty( mHitchTracePrefix, "Hitch Trace Prefix" );
+			RegisterProperty( mMaxHitchTraces, "Max Hitch Traces" );
+		}
+
+	public:
+		/**
+		 * Where a capture is written when it is stopped
+		 */
+		AXProperty< AXString > mTraceFile = "Profile.json";
+
+		/**
+		 * Most scopes kept per thread in a single capture, rounded up to a whole block
+		 */
+		AXProperty< uint32_t > mMaxEventsPerThread = 1024 * 1024;
+
+		/**
+		 * If true hardware counters are read around counted scopes and every frame, also turned on by -hwcounters
+		 */
+		AXProperty< bool > mHardwareCounters = false;
+
+		/**
+		 * If true hitches are captured automatically, also turned on by -hitches
+		 */
+		AXProperty< bool > mHitchCapture = false;
+
+		/**
+		 * A frame whose work takes longer than this many milliseconds is a hitch, -hitchms=N overrides it for the run
+		 */
+		AXProperty< uint32_t > mHitchThresholdMs = 50;
+
+		/**
+		 * The number of frames before a hitch written with it
+		 */
+		AXProperty< uint32_t > mHitchFrames = 8;
+
+		/**
+		 * The size of each thread's ring, bounding hitch capture's memory to this many scopes per thread that records. Older
+		 * scopes are lost once a thread's scopes over the kept frames overflow it. Applied on initialise
+		 */
+		AXProperty< uint32_t > mHitchEventsPerThread = 64 * 1024;
+
+		/**
+		 * Hitch traces are written to this followed by the frame number
+		 */
+		AXProperty< AXString > mHitchTracePrefix = "Hitch";
+
+		/**
+		 * The most hitch traces written in one run, so a long soak test can't fill the disk
+		 */
+		AXProperty< uint32_t > mMaxHitchTraces = 32;
+	};
+
+public:
+	/**
+	* Override to handle command line arguments, gets called after create settings
+	*/
+	virtual void HandleCommandLine( const std::vector< AXString >& args ) override;
+
+	/**
+	* Initialise the system, called after settings are loaded
+	*/
+	virtual InitResult OnInitialize( ) override;
+
+	/**
+	* Called at the start of every frame
+	*/
+	virtual void BeginFrame( ) override;
+
+	/**
+	 * Called by the engine loop once a frame's work is done with how long it took, not counting the frame cap's sleep.
+	 * The next BeginFrame compares it against the hitch threshold
+	 */
+	void AddFrameTime( float ms );
+
+	/**
+	* Shutdown the system
+	*/
+	virtual void OnShutdown( ) override;
+
+	/**
+	 * Starts a new capture, discarding the previous one
+	 */
+	void BeginCapture( );
+
+	/**
+	 * Stops the running capture and writes it to the trace file
+	 */
+	void EndCapture( );
+
+	/**
+	 * Writes the last capture to a Chrome trace JSON file, returns false on failure
+	 */
+	bool ExportChromeTrace( const char* path ) const;
+
+	/**
+	 * Returns true if the engine was built with AXPROFILING
+	 */
+	static bool IsEnabled( );
+
+	/**
+	 * Returns the running capture, or 0 if nothing is being captured
+	 */
+	static uint32_t CaptureGeneration( ) { return sCaptureGeneration.load( std::memory_order_relaxed ); }
+
+	/**
+	 * Returns true while a capture is running
+	 */
+	static bool IsCapturing( ) { return CaptureGeneration( ) != 0; }
+
+	/**
+	 * Turns recording scopes into each thread's hitch ring on or off
+	 */
+	void SetHitchCapture( bool enabled );
+
+	/**
+	 * Returns true while scopes are recorded into the hitch rings
+	 */
+	static bool IsHitchCapturing( ) { return sHitchCapturing.load( std::memory_order_relaxed ); }
+
+	/**
+	 * Returns true while scopes are recorded for a capture or the hitch rings
+	 */
+	static bool IsRecording( ) { return IsCapturing( ) || IsHitchCapturing( ); }
+
+	/**
+	 * Returns the current time in profiler ticks, the time stamp counter where there is one
+	 */
+	static uint64_t Now( );
+
+	/**
+	 * Stores a finished scope in the calling thread's buffer if generation is a capture, and in its hitch ring while hitches are
+	 * captured. Prefer AXPROFILE_SCOPE. counters is the change in hardware counters over the scope, if they were read
+	 */
+	static void RecordScope( const char* name, uint64_t beginTicks, uint64_t endTicks, uint32_t generation, const AXHardwareCounters::Values* counters = nullptr );
+
+	/**
+	 * Names the calling thread in exported traces
+	 */
+	static void SetThreadName( const char* name );
+
+protected:
+	/**
+	* Override to register a settings object for this system
+	*/
+	virtual void CreateEngineSettings( class AXSettingsFile& settings ) override;
+
+private:
+	/**
+	* A callback function to draw the capture toggle
+	*/
+	void ImGuiCaptureMenuCallback( AXImGui::SystemDebugMenuItem& item );
+
+	/**
+	* A callback function to draw the hardware counters toggle
+	*/
+	void ImGuiHardwareCountersMenuCallback( AXImGui::SystemDebugMenuItem& item );
+
+	/**
+	* A callback function to draw the hitch capture toggle
+	*/
+	void ImGuiHitchCaptureMenuCallback( AXImGui::SystemDebugMenuItem& item );
+
+	/**
+	 * Writes every scope in the hitch rings overlapping the kept frames and the hitch to a Chrome trace JSON file, returns false
+	 * on failure
+	 */
+	bool ExportHitchTrace( const char* path ) const;
+
+	/**
+	 * A frame's start in profiler ticks and wall clock time
+	 */
+	struct FrameStart
+	{
+		uint64_t mTicks = 0;
+		std::chrono::steady_clock::time_point mTime;
+	};
+
+private:
+	/**
+	 * The generation of the running capture, 0 while nothing is being captured
+	 */
+	static AXAtomic< uint32_t > sCaptureGeneration;
+
+	/**
+	 * True while scopes are recorded into the hitch rings
+	 */
+	static AXAtomic< bool > sHitchCapturing;
+
+	/**
+	 * Pointer to the created settings object
+	 */
+	Settings* mSettings = nullptr;
+
+	/**
+	 * Set when -hwcounters was passed on the command line
+	 */
+	bool mHardwareCountersFromCommandLine = false;
+
+	/**
+	 * Set when -capture was passed on the command line, capturing from initialise until shutdown
+	 */
+	bool mCaptureFromCommandLine = false;
+
+	/**
+	 * Set when -hitches or -hitchms=N were passed on the command line, a negative threshold uses the setting
+	 */
+	bool mHitchCaptureFromCommandLine = false;
+	int32_t mHitchThresholdMsFromCommandLine = -1;
+
+	/**
+	 * How long the last frame's work took, set by AddFrameTime
+	 */
+	float mLastFrameMs = 0.0f;
+
+	/**
+	 * The start of the latest frames, enough to find the start of the kept frames and of the frame that may be a hitch
+	 */
+	FrameStart mFrameStarts[AXPROFILER_MAX_HITCH_FRAMES + 1];
+	uint32_t mNumFrameStarts = 0;
+	uint32_t mNextFrameStart = 0;
+
+	/**
+	 * The span of the hitch trace being written, from the start of the oldest kept frame to the end of the hitch
+	 */
+	FrameStart mHitchBegin;
+	FrameStart mHitchEnd;
+
+	/**
+	 * The number of hitch traces written this run
+	 */
+	uint32_t mNumHitchTraces = 0;
+
+	/**
+	 * The generation of the last capture started
+	 */
+	uint32_t mLastGeneration = 0;
+
+	/**
+	 * Ticks and wall clock time at the start and end of the last capture, used to convert ticks to microseconds on export
+	 */
+	uint64_t mCaptureBeginTicks = 0;
+	uint64_t mCaptureEndTicks = 0;
+	std::chrono::steady_clock::time_point mCaptureBeginTime;
+	std::chrono::steady_clock::time_point mCaptureEndTime;
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Returns the current time in profiler ticks, the time stamp counter where there is one
+ */
+inline uint64_t AXProfiler::Now( )
+{
+#if defined( _MSC_VER ) || defined( __x86_64__ ) || defined( __i386__ )
+	return __rdtsc( );
+#else
+	return ( uint64_t )std::chrono::steady_clock::now( ).time_since_epoch( ).count( );
+#endif
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Records the lifetime of the object as a profiler scope if a capture was running or hitches were being captured when it was created
+ */
+class AXProfileScope
+{
+public:
+	AXProfileScope( const char* name )
+		: mName( name )
+		, mGeneration( AXProfiler::CaptureGeneration( ) )
+		, mRecording( mGeneration != 0 || AXProfiler::IsHitchCapturing( ) )
+		, mBeginTicks( mRecording ? AXProfiler::Now( ) : 0 )
+	{
+	}
+
+	~AXProfileScope( )
+	{
+		if( mRecording )
+		{
+			AXProfiler::RecordScope( mName, mBeginTicks, AXProfiler::Now( ), mGeneration );
+		}
+	}
+
+	AXProfileScope( const AXProfileScope& ) = delete;
+	AXProfileScope& operator = ( const AXProfileScope& ) = delete;
+
+private:
+	const char* mName;
+	uint32_t mGeneration;
+	bool mRecording;
+	uint64_t mBeginTicks;
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * As AXProfileScope, also reading the calling thread's hardware counters at each end of the scope while they are enabled
+ */
+class AXProfileCountersScope
+{
+public:
+	AXProfileCountersScope( const char* name )
+		: mName( name )
+		, mGeneration( AXProfiler::CaptureGeneration( ) )
+		, mRecording( mGeneration != 0 || AXProfiler::IsHitchCapturing( ) )
+		, mCounting( mRecording && AXHardwareCounters::IsEnabled( ) && AXHardwareCounters::Read( mBeginCounters ) )
+		, mBeginTicks( mRecording ? AXProfiler::Now( ) : 0 )
+	{
+	}
+
+	~AXProfileCountersScope( )
+	{
+		if( mRecording )
+		{
+			const uint64_t endTicks( AXProfiler::Now( ) );
+
+			AXHardwareCounters::Values endCounters;
+
+			if( mCounting && AXHardwareCounters::Read( endCounters ) )
+			{
+				const AXHardwareCounters::Values counters( endCounters - mBeginCounters );
+				AXProfiler::RecordScope( mName, mBeginTicks, endTicks, mGeneration, &counters );
+			}
+			else
+			{
+				AXProfiler::RecordScope( mName, mBeginTicks, endTicks, mGeneration );
+			}
+		}
+	}
+
+	AXProfileCountersScope( const AXProfileCountersScope& ) = delete;
+	AXProfileCountersScope& operator = ( const AXProfileCountersScope& ) = delete;
+
+private:
+	const char* mName;
+	uint32_t mGeneration;
+	bool mRecording;
+	AXHardwareCounters::Values mBeginCounters;
+	bool mCounting;
+	uint64_t mBeginTicks;
+};
\ No newline at end of file
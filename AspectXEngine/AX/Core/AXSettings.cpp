@@ -2,14 +2,15 @@
 
 #include "AXSettings.h"
 #include "AXLogging.h"
-#include "AX/IO/AXFile.h"
+#include "AX/IO/AXPlatformFile.h"
+#include "AX/Utils/AXJSONArena.h"
 #include "Libs/cJSON/cJSON.h"
 #include "AX/Graphics/UI/ImGui/AXImGui.h"
 #include "AXApplication.h"
 #include "Libs/IMGui/imgui.h"
 #include "AX/Content/AXContent.h"
 
-AXString AXSystem< AXSettings >::sSystemName = "Settings";
+template<> AXName AXSystem< AXSettings >::sSystemName = "Settings";
 
 /**
 * Constructor
@@ -65,7 +66,7 @@ void AXSettings::Update( float dt )
 */
 void AXSettings::CreateEngineSettings( class AXSettingsFile& settings )
 {
-	mSettings = settings.RegisterNewItem< AXSettings::Settings >( AXSettings::StaticName( ) );
+	mSettings = settings.RegisterNewItem< AXSettings::Settings >( AXSettings::StaticName( ).GetString( ) );
 }
 
 /**
@@ -177,15 +178,17 @@ AXSettingsFile::AXSettingsFile( const AXString& name )
 */
 void AXSettingsFile::Load( )
 {
-	AXFile file( AXSettings::BuildPathToConfigFile( mName ), AXFile::FileOpenMode::Read, AXFile::DataMode::Normal );
+	AXPlatformFile file;
 
-	if( file.IsOpen( ) )
+	if( file.OpenFile( AXSettings::BuildPathToConfigFile( mName ), AXFile::FileOpenMode::Read, AXFile::DataMode::Normal ) )
 	{
 		AXFile::InternalFileBuffer& buffer( file.ReadFileToInternalBuffer( ) );
 
-		if( buffer.mBuffer )
+		if( buffer )
 		{
-			if( cJSON* jsonRoot = cJSON_Parse( (const char*)buffer.mBuffer ) )
+			AXJSONArenaScope jsonArena( AXJSONArenaScope::BlockSizeForText( ( size_t )buffer.Size( ) ) );
+
+			if( cJSON* jsonRoot = cJSON_Parse( (const char*)buffer.Data( ) ) )
 			{
 				if( cJSON* meta = cJSON_GetObjectItem( jsonRoot, "Meta" ) )
 				{
@@ -220,9 +223,9 @@ void AXSettingsFile::Load( )
 */
 void AXSettingsFile::Save( )
 {
-	AXFile file( AXSettings::BuildPathToConfigFile( mName ), AXFile::FileOpenMode::Write, AXFile::DataMode::Normal );
+	AXPlatformFile file;
 
-	if( file.IsOpen( ) )
+	if( file.OpenFile( AXSettings::BuildPathToConfigFile( mName ), AXFile::FileOpenMode::Write, AXFile::DataMode::Normal ) )
 	{
 		if( cJSON* jsonRoot = cJSON_CreateObject( ) )
 		{
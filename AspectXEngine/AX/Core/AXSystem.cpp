@@ -1,12 +1,19 @@
 // Copyright 2016 Scott Bevin, All Rights Reserved
 
 #include "AXSystem.h"
+#include "AXMemoryTracking.h"
+
+/**
+* Changes whenever any system changes what it declares
+*/
+uint32_t AXSystemBase::sDeclarationsVersion = 0;
 
 /**
 * Constructor
 */
-AXSystemBase::AXSystemBase( const AXString& name )
+AXSystemBase::AXSystemBase( const AXName& name )
 	: mName( name )
+	, mMemoryTag( AXMemoryTracking::RegisterTag( name.c_str( ) ) )
 {
 
 }
@@ -24,6 +31,8 @@ AXSystemBase::~AXSystemBase()
 */
 AXSystemBase::InitResult AXSystemBase::Initialize( )
 {
+	AXMEMORY_TAG_SCOPE( mMemoryTag );
+
 	InitResult res( OnInitialize( ) );
 
 	if( res == InitResult::Initialized )
@@ -45,19 +54,48 @@ void AXSystemBase::Shutdown( )
 {
 	if( mState == State::Initialized || mState == State::FailedToInitialize )
 	{
+		AXMEMORY_TAG_SCOPE( mMemoryTag );
 		OnShutdown( );
 	}
 
 	mState = State::Shutdown;
 }
 
+/**
+* Declares the frame callbacks safe to run on any thread, at the same time as other systems. Thread safe systems only touch
+* themselves and the systems they declare, everything else stays pinned to the main thread. Call from the constructor
+*/
+void AXSystemBase::DeclareThreadSafe( )
+{
+	mThreadSafe = true;
+	++sDeclarationsVersion;
+}
+
+/**
+* Declares the frame callbacks read from another system, so they never run at the same time as a system writing to it
+*/
+void AXSystemBase::DeclareRead( const AXName& systemName )
+{
+	mDeclaredReads.push_back( systemName );
+	++sDeclarationsVersion;
+}
+
+/**
+* Declares the frame callbacks write to another system, so they never run at the same time as a system touching it
+*/
+void AXSystemBase::DeclareWrite( const AXName& systemName )
+{
+	mDeclaredWrites.push_back( systemName );
+	++sDeclarationsVersion;
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 /**
 * Attempts to find a system, if registered
 */
-const AXSystemBase* AXISystemOwner::FindSystem( const AXString& sysName ) const
+const AXSystemBase* AXISystemOwner::FindSystem( const AXName& sysName ) const
 {
 	for( auto it : mSystems )
 	{
@@ -73,7 +111,7 @@ const AXSystemBase* AXISystemOwner::FindSystem( const AXString& sysName ) const
 /**
 * Attempts to find a system, if registered
 */
-AXSystemBase* AXISystemOwner::FindSystem( const AXString& sysName )
+AXSystemBase* AXISystemOwner::FindSystem( const AXName& sysName )
 {
 	for( auto it : mSystems )
 	{
@@ -3,7 +3,9 @@
 #pragma once
 
 #include "AX/Utils/AXString.h"
+#include "AX/Utils/AXName.h"
 #include <map>
+#include <stdint.h>
 #include <type_traits>
 #include <vector>
 
@@ -36,17 +38,42 @@ public:
 	/**
 	* Constructor
 	*/
-	AXSystemBase( const AXString& name );
+	AXSystemBase( const AXName& name );
 
 	/**
 	* Destructor
 	*/
 	~AXSystemBase();
 	
-	const AXString& GetName( ) const { return mName; }
+	const AXName& GetName( ) const { return mName; }
 
 	State GetState( ) const { return mState; }
 
+	/**
+	 * Returns the memory tag allocations made inside this system's callbacks are attributed to
+	 */
+	uint16_t GetMemoryTag( ) const { return mMemoryTag; }
+
+	/**
+	 * Returns true if the system declared its frame callbacks safe to run on any thread
+	 */
+	bool IsThreadSafe( ) const { return mThreadSafe; }
+
+	/**
+	 * Returns the systems this system declared it reads from in its frame callbacks
+	 */
+	const std::vector< AXName >& GetDeclaredReads( ) const { return mDeclaredReads; }
+
+	/**
+	 * Returns the systems this system declared it writes to in its frame callbacks, not counting itself
+	 */
+	const std::vector< AXName >& GetDeclaredWrites( ) const { return mDeclaredWrites; }
+
+	/**
+	 * Returns a number that changes whenever any system changes what it declares, so schedules know when to rebuild
+	 */
+	static uint32_t GetDeclarationsVersion( ) { return sDeclarationsVersion; }
+
 	/**
 	 * Override to register a settings object for this system
 	 */
@@ -99,11 +126,41 @@ protected:
 	*/
 	virtual void OnShutdown( ) { }
 
+	/**
+	 * Declares the frame callbacks safe to run on any thread, at the same time as other systems. Thread safe systems only touch
+	 * themselves and the systems they declare, everything else stays pinned to the main thread. Call from the constructor
+	 */
+	void DeclareThreadSafe( );
+
+	/**
+	 * Declares the frame callbacks read from another system, so they never run at the same time as a system writing to it
+	 */
+	void DeclareRead( const AXName& systemName );
+
+	/**
+	 * Declares the frame callbacks write to another system, so they never run at the same time as a system touching it
+	 */
+	void DeclareWrite( const AXName& systemName );
+
+	template< class T >
+	void DeclareRead( ) { DeclareRead( T::StaticName( ) ); }
+
+	template< class T >
+	void DeclareWrite( ) { DeclareWrite( T::StaticName( ) ); }
+
 private:
 
-	AXString mName = "Undefined";
+	AXName mName;
 
 	State mState = State::Uninitialized;
+
+	uint16_t mMemoryTag = 0;
+
+	bool mThreadSafe = false;
+	std::vector< AXName > mDeclaredReads;
+	std::vector< AXName > mDeclaredWrites;
+
+	static uint32_t sDeclarationsVersion;
 };
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -113,9 +170,9 @@ template< class T >
 class AXSystem : public AXParent< AXSystemBase, AXSystem< T > >
 {
 public:
-	AXSystem() : AXParent( sSystemName ) { }
+	AXSystem() : AXParent< AXSystemBase, AXSystem< T > >( sSystemName ) { }
 
-	static const AXString& StaticName( ) { return sSystemName; }
+	static const AXName& StaticName( ) { return sSystemName; }
 
 	/**
 	 * Returns a pointer to this system if found within the system owner
@@ -128,7 +185,7 @@ public:
 	 static T* GetFrom( class AXISystemOwner& sysOwner );
 
 protected:
-	static AXString sSystemName;
+	static AXName sSystemName;
 };
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -158,12 +215,12 @@ public:
 	/**
 	* Attempts to find a system, if registered
 	*/
-	const AXSystemBase* FindSystem( const AXString& sysName ) const;
+	const AXSystemBase* FindSystem( const AXName& sysName ) const;
 
 	/**
 	* Attempts to find a system, if registered
 	*/
-	AXSystemBase* FindSystem( const AXString& sysName );
+	AXSystemBase* FindSystem( const AXName& sysName );
 
 protected:
 	/**
@@ -241,7 +298,7 @@ inline T* AXISystemOwner::FindSystem( )
 template< class T >
 const T* AXSystem< T >::GetFrom( const AXISystemOwner& sysOwner )
 {
-	static_assert( std::is_base_of( AXSystem< T >, T ), "T Must be a system" );
+	static_assert( std::is_base_of< AXSystem< T >, T >::value, "T Must be a system" );
 	return sysOwner.FindSystem< T >( );
 }
 
@@ -0,0 +1,254 @@
+// Copyright 2016 Scott Bevin, All Rights Reserved
+
+#include "AXSystemScheduler.h"
+#include "AX/Core/AXLogging.h"
+#include "AX/Core/AXMemoryTracking.h"
+#include "AX/Core/AXProfiler.h"
+#include "AX/Core/Threads/AXThreadedTasks.h"
+
+#include <algorithm>
+#include <chrono>
+#include <thread>
+
+/**
+* Destructor
+*/
+AXSystemScheduler::~AXSystemScheduler( )
+{
+	delete[] mRemaining;
+}
+
+/**
+* Returns true if the systems or what they declare changed since the schedule was built
+*/
+bool AXSystemScheduler::NeedsBuild( const std::vector< AXSystemBase* >& systems ) const
+{
+	return mBuiltSystems != systems || mBuiltVersion != AXSystemBase::GetDeclarationsVersion( );
+}
+
+/**
+* Builds the schedule for a list of systems, which must not change while it is used
+*/
+void AXSystemScheduler::Build( const std::vector< AXSystemBase* >& systems )
+{
+	mBuiltSystems = systems;
+	mBuiltVersion = AXSystemBase::GetDeclarationsVersion( );
+
+	mNodes.clear( );
+	mNodes.resize( systems.size( ) );
+	mNumUnpinned = 0;
+
+	for( uint32_t i( 0 ); i < systems.size( ); ++i )
+	{
+		Node& node( mNodes[i] );
+		node.mSystem = systems[i];
+		node.mPinned = !systems[i]->IsThreadSafe( );
+
+		if( !node.mPinned )
+		{
+			++mNumUnpinned;
+		}
+
+		// Conflicting systems keep their creation order, so every edge points forwards and the graph can't have a cycle
+		for( uint32_t j( 0 ); j < i; ++j )
+		{
+			if( Conflicts( *systems[j], *systems[i] ) )
+			{
+				mNodes[j].mSuccessors.push_back( i );
+				++node.mNumPredecessors;
+			}
+		}
+	}
+
+	delete[] mRemaining;
+	mRemaining = new AXAtomic< uint32_t >[mNodes.size( ) > 0 ? mNodes.size( ) : 1];
+
+	AXLOG( "Scheduler", "Scheduled %u systems, %u thread safe", ( uint32_t )mNodes.size( ), mNumUnpinned );
+}
+
+/**
+* Calls func on every system and returns once they have all finished. Everything runs on the calling thread, in order, if
+* tasks is nullptr. Must be called from the main thread
+*/
+void AXSystemScheduler::Run( AXThreadedTasks* tasks, const SystemFunc& func, bool readCounters )
+{
+	mTasks = tasks;
+	mFunc = &func;
+	mReadCounters = readCounters;
+
+	if( !mTasks || mNumUnpinned == 0 )
+	{
+		for( uint32_t i( 0 ); i < mNodes.size( ); ++i )
+		{
+			RunNode( i );
+		}
+
+		return;
+	}
+
+	// Tasks left over from an earlier run still hold the old claims, so they can only be reused once nothing else holds them
+	if( !mClaims || mClaims.use_count( ) > 1 || mClaims->size( ) != mNodes.size( ) )
+	{
+		mClaims = std::make_shared< std::vector< AXAtomic< bool > > >( mNodes.size( ) );
+	}
+
+	for( uint32_t i( 0 ); i < mNodes.size( ); ++i )
+	{
+		mRemaining[i] = mNodes[i].mNumPredecessors;
+		( *mClaims )[i] = false;
+	}
+
+	mUnpinnedLeft = mNumUnpinned;
+
+	for( uint32_t i( 0 ); i < mNodes.size( ); ++i )
+	{
+		if( !mNodes[i].mPinned && mNodes[i].mNumPredecessors == 0 )
+		{
+			Submit( i );
+		}
+	}
+
+	// Pinned systems run in creation order, so the only systems they can wait for are thread safe ones already released
+	for( uint32_t i( 0 ); i < mNodes.size( ); ++i )
+	{
+		if( mNodes[i].mPinned )
+		{
+			while( mRemaining[i] != 0 )
+			{
+				Help( );
+			}
+
+			RunNode( i );
+		}
+	}
+
+	while( mUnpinnedLeft != 0 )
+	{
+		Help( );
+	}
+}
+
+/**
+* Returns true if two systems touch the same system and at least one of them writes to it
+*/
+bool AXSystemScheduler::Conflicts( const AXSystemBase& a, const AXSystemBase& b )
+{
+	auto writes = [ ]( const AXSystemBase& system, const AXName& name )
+	{
+		const std::vector< AXName >& declared( system.GetDeclaredWrites( ) );
+		return system.GetName( ) == name || std::find( declared.begin( ), declared.end( ), name ) != declared.end( );
+	};
+
+	auto touches = [ &writes ]( const AXSystemBase& system, const AXName& name )
+	{
+		const std::vector< AXName >& declared( system.GetDeclaredReads( ) );
+		return writes( system, name ) || std::find( declared.begin( ), declared.end( ), name ) != declared.end( );
+	};
+
+	if( touches( b, a.GetName( ) ) || touches( a, b.GetName( ) ) )
+	{
+		return true;
+	}
+
+	for( const AXName& name : a.GetDeclaredWrites( ) )
+	{
+		if( touches( b, name ) )
+		{
+			return true;
+		}
+	}
+
+	for( const AXName& name : b.GetDeclaredWrites( ) )
+	{
+		if( touches( a, name ) )
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+/**
+* Runs a system on the calling thread then releases the systems waiting for it
+*/
+void AXSystemScheduler::RunNode( uint32_t idx )
+{
+	Node& node( mNodes[idx] );
+	AXSystemBase& system( *node.mSystem );
+
+	AXHardwareCounters::Values beginCounters;
+	const bool readCounters( mReadCounters && AXHardwareCounters::Read( beginCounters ) );
+
+	const std::chrono::high_resolution_clock::time_point beginTime( std::chrono::high_resolution_clock::now( ) );
+
+	{
+		AXMEMORY_TAG_SCOPE( system.GetMemoryTag( ) );
+		AXPROFILE_SCOPE_COUNTERS( system.GetName( ).c_str( ) );
+		( *mFunc )( system );
+	}
+
+	node.mRun.mMs = std::chrono::duration< float, std::milli >( std::chrono::high_resolution_clock::now( ) - beginTime ).count( );
+
+	AXHardwareCounters::Values endCounters;
+	node.mRun.mHasCounters = readCounters && AXHardwareCounters::Read( endCounters );
+	node.mRun.mCounters = endCounters - beginCounters;
+
+	if( !mTasks || mNumUnpinned == 0 )
+	{
+		return;
+	}
+
+	for( uint32_t successor : node.mSuccessors )
+	{
+		if( --mRemaining[successor] == 0 && !mNodes[successor].mPinned )
+		{
+			Submit( successor );
+		}
+	}
+
+	if( !node.mPinned )
+	{
+		--mUnpinnedLeft;
+	}
+}
+
+/**
+* Hands a thread safe system whose predecessors have all finished to the tasks system
+*/
+void AXSystemScheduler::Submit( uint32_t idx )
+{
+	std::shared_ptr< std::vector< AXAtomic< bool > > > claims( mClaims );
+
+	AXTask::Params params;
+	params.mPriority = AXTask::Priority::ASAP;
+	params.mCallback = [ this, idx, claims ]( AXTask::TaskUserData* userData )
+	{
+		// If the main thread got to the system first the run may have ended, so this must not touch the scheduler
+		if( Claim( *claims, idx ) )
+		{
+			RunNode( idx );
+		}
+
+		return AXTask::TaskResult( );
+	};
+
+	mTasks->RequestTaskRun( params );
+}
+
+/**
+* Runs a thread safe system that is ready and not yet claimed, or yields if there are none, while the main thread waits
+*/
+void AXSystemScheduler::Help( )
+{
+	for( uint32_t i( 0 ); i < mNodes.size( ); ++i )
+	{
+		if( !mNodes[i].mPinned && mRemaining[i] == 0 && !( *mClaims )[i] && Claim( *mClaims, i ) )
+		{
+			RunNode( i );
+			return;
+		}
+	}
+
+	std::this_thread::yield( );
+}
\ No newline at end of file
@@ -0,0 +1,145 @@
+// Copyright 2016 Scott Bevin, All Rights Reserved
+
+#pragma once
+
+#include "AX/Core/AXSystem.h"
+#include "AX/Core/AXHardwareCounters.h"
+#include "AX/Utils/AXThreadingPrimitives.h"
+
+#include <functional>
+#include <memory>
+#include <stdint.h>
+#include <vector>
+
+class AXThreadedTasks;
+
+/**
+ * Runs a phase of the frame over every system, at the same time where the systems allow it. Systems are pinned to the main
+ * thread unless they declare themselves thread safe, and two systems that touch the same system, at least one of them writing
+ * to it, run in creation order. Every system writes to itself. Thread safe systems run as tasks on AXThreadedTasks while the
+ * main thread runs the pinned systems in order. Whenever the main thread has to wait it runs any thread safe system that is
+ * ready but not yet picked up by a task thread, and never unrelated tasks, so a long task can't stall the frame
+ */
+class AXSystemScheduler
+{
+public:
+	using SystemFunc = std::function< void( AXSystemBase& ) >;
+
+	/**
+	 * How long a system took in the last run, and the change in its thread's hardware counters if they were read
+	 */
+	struct SystemRun
+	{
+		float mMs = 0.0f;
+		AXHardwareCounters::Values mCounters;
+		bool mHasCounters = false;
+	};
+
+public:
+	/**
+	 * Destructor
+	 */
+	~AXSystemScheduler( );
+
+	/**
+	 * Returns true if the systems or what they declare changed since the schedule was built
+	 */
+	bool NeedsBuild( const std::vector< AXSystemBase* >& systems ) const;
+
+	/**
+	 * Builds the schedule for a list of systems, which must not change while it is used
+	 */
+	void Build( const std::vector< AXSystemBase* >& systems );
+
+	/**
+	 * Calls func on every system and returns once they have all finished. Everything runs on the calling thread, in order, if
+	 * tasks is nullptr. Must be called from the main thread
+	 */
+	void Run( AXThreadedTasks* tasks, const SystemFunc& func, bool readCounters );
+
+	/**
+	 * Returns the number of systems scheduled
+	 */
+	uint32_t NumSystems( ) const { return ( uint32_t )mNodes.size( ); }
+
+	/**
+	 * Returns the system at idx, in creation order
+	 */
+	AXSystemBase& GetSystem( uint32_t idx ) const { return *mNodes[idx].mSystem; }
+
+	/**
+	 * Returns how the system at idx ran last time
+	 */
+	const SystemRun& GetSystemRun( uint32_t idx ) const { return mNodes[idx].mRun; }
+
+private:
+	/**
+	 * A system and the systems that must wait for it
+	 */
+	struct Node
+	{
+		AXSystemBase* mSystem = nullptr;
+		bool mPinned = true;
+		uint32_t mNumPredecessors = 0;
+		std::vector< uint32_t > mSuccessors;
+		SystemRun mRun;
+	};
+
+	/**
+	 * Returns true if two systems touch the same system and at least one of them writes to it
+	 */
+	static bool Conflicts( const AXSystemBase& a, const AXSystemBase& b );
+
+	/**
+	 * Runs a system on the calling thread then releases the systems waiting for it
+	 */
+	void RunNode( uint32_t idx );
+
+	/**
+	 * Hands a thread safe system whose predecessors have all finished to the tasks system
+	 */
+	void Submit( uint32_t idx );
+
+	/**
+	 * Runs a thread safe system that is ready and not yet claimed, or yields if there are none, while the main thread waits
+	 */
+	void Help( );
+
+	/**
+	 * Claims a system for the calling thread, returns false if another thread already claimed it this run
+	 */
+	static bool Claim( std::vector< AXAtomic< bool > >& claims, uint32_t idx ) { return !claims[idx].exchange( true ); }
+
+private:
+	std::vector< Node > mNodes;
+
+	/**
+	 * The number of thread safe systems, and the systems and declarations version the schedule was built from
+	 */
+	uint32_t mNumUnpinned = 0;
+	std::vector< AXSystemBase* > mBuiltSystems;
+	uint32_t mBuiltVersion = 0;
+
+	/**
+	 * Predecessors each system is still waiting for in the current run, one per node
+	 */
+	AXAtomic< uint32_t >* mRemaining = nullptr;
+
+	/**
+	 * Whether each system has been claimed by a thread in the current run. Shared with the submitted tasks, as a task can still
+	 * be queued after the run ends if the main thread claimed its system first
+	 */
+	std::shared_ptr< std::vector< AXAtomic< bool > > > mClaims;
+
+	/**
+	 * Thread safe systems that haven't finished in the current run
+	 */
+	AXAtomic< uint32_t > mUnpinnedLeft = 0;
+
+	/**
+	 * The state of the current run
+	 */
+	AXThreadedTasks* mTasks = nullptr;
+	const SystemFunc* mFunc = nullptr;
+	bool mReadCounters = false;
+};
\ No newline at end of file
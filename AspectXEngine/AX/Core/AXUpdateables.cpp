@@ -31,7 +31,7 @@ AXIUpdateable::~AXIUpdateable( )
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-AXString AXSystem< AXUpdateables >::sSystemName = "Updateables";
+template<> AXName AXSystem< AXUpdateables >::sSystemName = "Updateables";
 
 /**
 * Update all the updateable objects
@@ -11,7 +11,7 @@
 #include "AX/Graphics/RenderCore/AXRenderCore.h"
 #include "AX/Graphics/UI/ImGui/AXImGui.h"
 
-AXString AXSystem< AXWindow >::sSystemName = "Window";
+template<> AXName AXSystem< AXWindow >::sSystemName = "Window";
 
 /**
 * Constructor
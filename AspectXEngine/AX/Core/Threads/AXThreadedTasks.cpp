@@ -2,8 +2,10 @@
 
 #include "AXThreadedTasks.h"
 #include "AX/Core/AXApplication.h"
+#include "AX/Core/AXProfiler.h"
+#include "AX/Core/AXPerfCounters.h"
 
-AXString AXSystem< AXThreadedTasks >::sSystemName = "Threaded Tasks";
+template<> AXName AXSystem< AXThreadedTasks >::sSystemName = "Threaded Tasks";
 
 AXTask::TaskResult TestTask( AXTask::TaskUserData* userData )
 {
@@ -96,6 +98,9 @@ void AXThreadedTasks::RequestTaskRun( const AXTask::Params& params )
 
 		mTasks.GetWrite( &params ).push_back( newTask );
 		mTasks.ReleaseLock( &params );
+
+		AXPERF_COUNT( "Tasks/Submitted", 1 );
+		AXPERF_GAUGE_ADD( "Tasks/Queued", 1 );
 	}
 }
 
@@ -107,10 +112,12 @@ bool AXThreadedTasks::RunNextAvailableTask( )
 	// An object that can be used for locking tasks to
 	static thread_local int TasksLockObj = 0;
 
-	// Will read lock the object
-	if( mTasks.GetRead( &TasksLockObj ).empty( ) )
+	// Will read lock the object, the read lock has to be released before the write lock below can be taken
+	const bool hasTasks( !mTasks.GetRead( &TasksLockObj ).empty( ) );
+	mTasks.ReleaseLock( &TasksLockObj );
+
+	if( !hasTasks )
 	{
-		mTasks.ReleaseLock( &TasksLockObj );
 		return false;
 	}
 
@@ -134,6 +141,8 @@ bool AXThreadedTasks::RunNextAvailableTask( )
 			if( taskToRun )
 			{
 				tasks->remove( taskToRun );
+
+				AXPERF_GAUGE_ADD( "Tasks/Queued", -1 );
 			}
 
 			mTasks.ReleaseLock( &TasksLockObj );
@@ -142,11 +151,15 @@ bool AXThreadedTasks::RunNextAvailableTask( )
 
 	if( taskToRun )
 	{
+		AXPROFILE_SCOPE_COUNTERS( "Task" );
+
 		taskToRun->mParams.mCallback( taskToRun->mParams.mUserData );
 
 		delete taskToRun->mParams.mUserData;
 		delete taskToRun;
 
+		AXPERF_COUNT( "Tasks/Run", 1 );
+
 		return true;
 	}
 
@@ -158,7 +171,7 @@ bool AXThreadedTasks::RunNextAvailableTask( )
 */
 void AXThreadedTasks::CreateEngineSettings( class AXSettingsFile& settings )
 {
-	mSettings = settings.RegisterNewItem< AXThreadedTasks::Settings >( AXThreadedTasks::StaticName( ) );
+	mSettings = settings.RegisterNewItem< AXThreadedTasks::Settings >( AXThreadedTasks::StaticName( ).GetString( ) );
 }
 
 /**
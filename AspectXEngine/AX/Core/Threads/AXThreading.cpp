@@ -3,15 +3,16 @@
 #include "AXThreading.h"
 #include "AX/Core/AXLogging.h"
 #include "AX/Core/AXApplication.h"
+#include "AX/Core/AXProfiler.h"
 
-AXString AXSystem< AXThreading >::sSystemName = "Threading";
+template<> AXName AXSystem< AXThreading >::sSystemName = "Threading";
 
 static AXString sAXDefaultThreadName = "AX Thread";
 
 /**
 * Gets set to notify spawned threads that they should stop running
 */
-bool AXThreading::sShuttingDown = false;
+AXAtomic< bool > AXThreading::sShuttingDown = false;
 
 /**
 * Initialise the system, called after settings are loaded
@@ -20,21 +21,21 @@ AXThreading::InitResult AXThreading::OnInitialize( )
 {
 	uint32_t maxConcurentThreads( std::thread::hardware_concurrency( ) );
 
-	if( maxConcurentThreads < 2 )
-	{
-		return AXThreading::InitResult::Failed;
-	}
+	// Create max - 1 so that we dont create one on the same core as the main thread, single core machines such as CI
+	// runners still get one thread so anything waiting on threaded work makes progress
+	mNumThreads = static_cast< ThreadHandle::IdType >( AXUtils::Max( maxConcurentThreads, ( uint32_t )2 ) - 1 );
+	mThreads = new AXThread[mNumThreads];
+	mThreadPool = new ThreadPool( mNumThreads );
 
-	// Create max - 1 so that we dont create one on the same core as the main thread...
-	mThreadPool = new ThreadPool( maxConcurentThreads - 1 );
-
-	if( !mThreadPool )
+	if( !mThreads || !mThreadPool )
 	{
 		return AXThreading::InitResult::Failed;
 	}
 
-	for( AXThread& item : *mThreadPool )
+	for( ThreadHandle::IdType i( 0 ); i < mNumThreads; ++i )
 	{
+		AXThread& item( mThreads[i] );
+
 		if( item.mNativeThread = new std::thread( NativeThreadFunc, std::ref( item ) ) )
 		{
 			item.SetThreadName( sAXDefaultThreadName );
@@ -66,10 +67,12 @@ void AXThreading::OnShutdown( )
 
 	AXLOG( "Threads", "Waiting for threads to shut down." );
 
-	if( mThreadPool )
+	if( mThreads )
 	{
-		for( AXThread& item : *mThreadPool )
+		for( ThreadHandle::IdType i( 0 ); i < mNumThreads; ++i )
 		{
+			AXThread& item( mThreads[i] );
+
 			if( item.mNativeThread )
 			{
 				item.mNativeThread->join( );
@@ -83,6 +86,10 @@ void AXThreading::OnShutdown( )
 
 	delete mThreadPool;
 	mThreadPool = nullptr;
+
+	delete[] mThreads;
+	mThreads = nullptr;
+	mNumThreads = 0;
 }
 
 /**
@@ -92,24 +99,49 @@ void AXThreading::NativeThreadFunc( AXThread& thread )
 {
 	while( !thread.mNativeThread ) { }
 
-	AXLOG( "Threads", "Starting thread: %d", thread.mNativeThread->get_id( ) );
+	AXLOG( "Threads", "Starting thread: %u", AXThreadIndex::Current( ) );
+
+	// The handle the profiler last named this thread for, the name changes each time the thread is obtained
+	ThreadHandle profilerNamedHandle( ThreadHandle::Invalid );
+
+	// Runs from a copy of the params taken each time the thread is obtained or released, as they can be replaced while the
+	// callback is running
+	ObtainThreadParams params;
+	ThreadHandle handle( ThreadHandle::Invalid );
 
 	do 
 	{
 		bool didSomething( false );
 
-		if( thread.mParams.mCallback )
+		{
+			std::lock_guard< std::mutex > lock( thread.mParamsMutex );
+
+			if( thread.mHandle != handle )
+			{
+				params = thread.mParams;
+				handle = thread.mHandle;
+			}
+		}
+
+		if( params.mCallback )
 		{
 			thread.mState = AXThread::State::Running;
 			didSomething = true;
 
-			ThreadResult result( thread.mParams.mCallback( thread.mParams.mUserData ) );
+			if( handle != profilerNamedHandle )
+			{
+				AXProfiler::SetThreadName( params.mThreadName.c_str( ) );
+				profilerNamedHandle = handle;
+			}
+
+			ThreadResult result( params.mCallback( params.mUserData ) );
 
 			if( result.mResult == ThreadResult::Result::Finish )
 			{
 				if( AXThreading* threading = AXThreading::GetFrom( AXApplication::Get( ) ) )
 				{
-					threading->ReleaseThread( thread.mHandle );
+					ThreadHandle releasedHandle( handle );
+					threading->ReleaseThread( releasedHandle );
 				}
 			}
 		}
@@ -117,7 +149,7 @@ void AXThreading::NativeThreadFunc( AXThread& thread )
 	} while ( !sShuttingDown );
 
 	AXASSERT( thread.mNativeThread, "Native thread invalid" );
-	AXLOG( "Threads", "Shutting down thread: %d", thread.mNativeThread->get_id( ) );
+	AXLOG( "Threads", "Shutting down thread: %u", AXThreadIndex::Current( ) );
 }
 
 /**
@@ -127,11 +159,16 @@ AXThreading::ThreadHandle AXThreading::ObtainThread( const ObtainThreadParams& p
 {
 	if( params.mCallback )
 	{
-		AXThread* obtainedThread = nullptr;
-		ThreadHandle hndl( mThreadPool->Allocate( &obtainedThread ) );
+		AXThread** slot = nullptr;
+		ThreadHandle hndl( mThreadPool->Allocate( &slot ) );
 
-		if( hndl.IsValid( ) && obtainedThread )
+		if( hndl.IsValid( ) && slot )
 		{
+			AXThread* obtainedThread( &mThreads[hndl.Id( )] );
+			( *slot ) = obtainedThread;
+
+			std::lock_guard< std::mutex > lock( obtainedThread->mParamsMutex );
+
 			obtainedThread->mHandle = hndl;
 			obtainedThread->mParams = params;
 
@@ -149,9 +186,14 @@ AXThreading::ThreadHandle AXThreading::ObtainThread( const ObtainThreadParams& p
 */
 void AXThreading::ReleaseThread( ThreadHandle& handle )
 {
-	if( AXThread* thread = mThreadPool->TryGet( handle ) )
+	if( AXThread** slot = mThreadPool->TryGet( handle ) )
 	{
+		AXThread* thread( *slot );
+
+		std::lock_guard< std::mutex > lock( thread->mParamsMutex );
+
 		thread->mParams = ObtainThreadParams( );
+		thread->mHandle = ThreadHandle::Invalid;
 		thread->mState = AXThread::State::Available;
 
 		thread->SetThreadName( sAXDefaultThreadName );
@@ -182,11 +224,13 @@ void AXThreading::RenderImGuiThreadingWindow( )
 			static AXThread* CurrentlySelectedThread = nullptr;
 
 			uint32_t id( 0 );
-			for( AXThread& item : *mThreadPool )
+			for( ThreadHandle::IdType i( 0 ); i < mNumThreads; ++i )
 			{
+				AXThread& item( mThreads[i] );
+
 				ImGui::PushID( id++ );
 
-				if( ImGui::Selectable( AXUtils::FormatString( "Thread %d: %s", id - 1, item.mParams.mThreadName.c_str() ).c_str(), CurrentlySelectedThread == &item ) )
+				if( ImGui::Selectable( AXUtils::FormatFrameString( "Thread %d: %s", id - 1, item.mParams.mThreadName.c_str() ).c_str(), CurrentlySelectedThread == &item ) )
 				{
 					CurrentlySelectedThread = &item;
 				}
@@ -8,6 +8,7 @@
 #include "AX/Utils/AXResourcePool.h"
 
 #include <functional>
+#include <mutex>
 
 class AXThreading : public AXParent< AXSystem< AXThreading >, AXThreading >
 {
@@ -78,11 +79,14 @@ private:
 		// Params passed in when the thread was obtained
 		ObtainThreadParams mParams;
 
+		// Guards mParams and mHandle, which are swapped by the main thread while the thread polls them
+		std::mutex mParamsMutex;
+
 		// A valid handle for this thread object (when the thread is obtained)
 		ThreadHandle mHandle = ThreadHandle::Invalid;
 
-		// The current state of this thread
-		State::E mState = State::Available;
+		// The current state of this thread, set by the thread itself and when the thread is released
+		AXAtomic< State::E > mState = State::Available;
 
 		// The name given to this thread
 		AXString mName;
@@ -92,7 +96,8 @@ private:
 		void SetThreadName( const AXString& name );
 	};
 
-	using ThreadPool = AXFixedSizeResourcePool< AXThread, ThreadHandle >;
+	// Hands out handles to the threads, the slot with a handle's id points at mThreads[id] while the thread is obtained
+	using ThreadPool = AXFixedSizeResourcePool< AXThread*, ThreadHandle >;
 
 public:
 	/**
@@ -135,7 +140,7 @@ public:
 	/**
 	 * Returns the number of threads available
 	 */
-	ThreadHandle::IdType MaxThreads( ) const { return mThreadPool->Capacity( ); }
+	ThreadHandle::IdType MaxThreads( ) const { return mNumThreads; }
 
 private:
 	/**
@@ -155,14 +160,20 @@ private:
 
 private:
 	/**
-	 * The pool containing all available threads
+	 * Every thread, they run from initialisation until shutdown whether they're obtained or not
+	 */
+	AXThread* mThreads = nullptr;
+	ThreadHandle::IdType mNumThreads = 0;
+
+	/**
+	 * The pool handing out the threads that are available
 	 */
 	ThreadPool* mThreadPool = nullptr;
 
 	/**
 	 * Gets set to notify spawned threads that they should stop running
 	 */
-	static bool sShuttingDown;
+	static AXAtomic< bool > sShuttingDown;
 
 
 	/**
@@ -0,0 +1,22 @@
+// Copyright 2016 Scott Bevin, All Rights Reserved
+
+#if !defined( AXPLATFORM_WINDOWS )
+
+#include "AXThreading.h"
+
+#include <pthread.h>
+#include <string.h>
+
+// Sets the name of a thread
+void AXThreading::AXThread::SetThreadName( const AXString& name )
+{
+	mName = name;
+
+	// Linux limits names to 15 characters plus the terminator and rejects anything longer
+	char shortName[16] = { };
+	memcpy( shortName, name.c_str( ), AXUtils::Min( name.length( ), sizeof( shortName ) - 1 ) );
+
+	pthread_setname_np( mNativeThread->native_handle( ), shortName );
+}
+
+#endif // #if !defined( AXPLATFORM_WINDOWS )
\ No newline at end of file
@@ -4,7 +4,7 @@
 #include "Windows/AXContentBrowserImGuiWindow.h"
 #include "AX/Core/AXApplication.h"
 
-AXString AXSystem< AXEditor >::sSystemName = "Editor";
+template<> AXName AXSystem< AXEditor >::sSystemName = "Editor";
 
 /**
 * Initialise the system, called after settings are loaded
@@ -32,7 +32,7 @@ void AXEditor::Update( float dt )
 */
 void AXEditor::CreateEngineSettings( class AXSettingsFile& settings )
 {
-	mSettings = settings.RegisterNewItem< AXEditor::Settings >( AXEditor::StaticName( ) );
+	mSettings = settings.RegisterNewItem< AXEditor::Settings >( AXEditor::StaticName( ).GetString( ) );
 }
 
 /**
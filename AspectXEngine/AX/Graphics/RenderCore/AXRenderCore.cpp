@@ -10,7 +10,7 @@
 // Todo, shouldnt be here...
 #include <d3d11.h>
 
-AXString AXSystem< AXRenderCore >::sSystemName = "Render Core";
+template<> AXName AXSystem< AXRenderCore >::sSystemName = "Render Core";
 
 /**
 * Constructor
@@ -49,7 +49,7 @@ AXRenderCore::~AXRenderCore()
 */
 void AXRenderCore::CreateEngineSettings( class AXSettingsFile& settings )
 {
-	mSettings = settings.RegisterNewItem< AXRenderCore::Settings >( AXRenderCore::StaticName( ) );
+	mSettings = settings.RegisterNewItem< AXRenderCore::Settings >( AXRenderCore::StaticName( ).GetString( ) );
 }
 
 /**
@@ -2,9 +2,12 @@
 
 #include "AXImGui.h"
 
+#include "AX/Core/AXApplication.h"
+#include "AX/Utils/AXProperties.h"
+
+#if defined(AXPLATFORM_WINDOWS)
 #include "AX/Core/AXWindow.h"
 #include "AX/Graphics/RenderCore/AXRenderCore.h"
-#include "AX/Core/AXApplication.h"
 #include "AX/Graphics/RenderCore/AXGraphicsDevice.h"
 
 // DirectX
@@ -12,9 +15,9 @@
 #include <d3dcompiler.h>
 #define DIRECTINPUT_VERSION 0x0800
 #include <dinput.h>
-#include "AX/Utils/AXProperties.h"
+#endif // #if defined(AXPLATFORM_WINDOWS)
 
-AXString AXSystem< AXImGui >::sSystemName = "ImGui";
+template<> AXName AXSystem< AXImGui >::sSystemName = "ImGui";
 
 /**
 * Constructor
@@ -32,6 +35,8 @@ AXImGui::~AXImGui()
 
 }
 
+#if defined(AXPLATFORM_WINDOWS)
+
 struct VERTEX_CONSTANT_BUFFER
 {
 	float        mvp[4][4];
@@ -564,6 +569,8 @@ void AXImGui::Render( )
 	}
 }
 
+#endif // #if defined(AXPLATFORM_WINDOWS)
+
 /**
 * Registers a menu to appear in the top system menu bar
 */
@@ -740,7 +747,7 @@ void AXImGui::ImGuiSystemDebugMenu_UserGuideWindowCallback( SystemDebugMenuItem&
 void AXImGui::DoRenderPropertyToImGuiHelper( AXString& val )
 {
 	static char buffer[4098];
-	strcpy_s( buffer, val.c_str( ) );
+	snprintf( buffer, sizeof( buffer ), "%s", val.c_str( ) );
 
 	ImGui::PushAllowKeyboardFocus( true );
 	ImGui::InputText( "", buffer, 4098, ImGuiInputTextFlags_AutoSelectAll );
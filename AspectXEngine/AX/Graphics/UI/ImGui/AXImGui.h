@@ -8,6 +8,7 @@
 //#endif // #if defined(AXPLATFORM_WINDOWS)
 
 #include <functional>
+#include <type_traits>
 
 #include "AX/Core/AXSystem.h"
 #include "Libs/IMGui/imgui.h"
@@ -21,6 +22,24 @@ public:
 	virtual void RenderToImGui( const AXString& label ) = 0;
 };
 
+/**
+ * Non-intrusive alternative to AXIImGuiRenderable for value types that should stay free of virtuals. Specialise for a
+ * type and provide a static RenderToImGui( T&, const AXString& ) function
+ */
+template< class T, class TEnable = void >
+struct AXImGuiTraits
+{
+	static const bool IsSpecialized = false;
+};
+
+template< class T >
+struct AXImGuiTraits< T, typename std::enable_if< std::is_base_of< AXIImGuiRenderable, T >::value >::type >
+{
+	static const bool IsSpecialized = true;
+
+	static void RenderToImGui( T& val, const AXString& label ) { val.RenderToImGui( label ); }
+};
+
 class AXImGui : public AXParent< AXSystem< AXImGui >, AXImGui >
 {
 public:
@@ -72,6 +91,9 @@ public:
 
 protected:
 
+#if defined(AXPLATFORM_WINDOWS)
+	// The D3D11 renderer is the only one there is, elsewhere the system just keeps the debug menu so systems can still register with it
+
 	/**
 	* Initialise the system, called after settings are loaded
 	*/
@@ -96,6 +118,7 @@ protected:
 	* Called after Update, before the render pipeline runs
 	*/
 	virtual void Render( ) override;
+#endif // #if defined(AXPLATFORM_WINDOWS)
 
 private:
 
@@ -129,6 +152,11 @@ private:
 	*/
 	void ImGuiSystemDebugMenu_UserGuideWindowCallback( SystemDebugMenuItem& item );
 
+	template< class T >
+	static void DoRenderPropertyToImGuiHelper( T& val, const AXString& label, std::true_type hasImGuiTraits );
+	template< class T >
+	static void DoRenderPropertyToImGuiHelper( T& val, const AXString& label, std::false_type hasImGuiTraits );
+
 	template< class T >
 	static void DoRenderPropertyToImGuiHelper( T& val );
 	static void DoRenderPropertyToImGuiHelper( AXString& val );
@@ -172,7 +200,7 @@ bool ImGui_PropertyGetter_DropDownOptions( void* data, int idx, const char** out
 {
 	if( out_text )
 	{
-		*out_text = (( *static_cast< AXPropertyMetaData< T >::DropDownOptionsCollection* >( data ) )[idx].second).c_str();
+		*out_text = (( *static_cast< typename AXPropertyMetaData< T >::DropDownOptionsCollection* >( data ) )[idx].second).c_str();
 	}
 
 	return true;
@@ -214,14 +242,19 @@ void AXImGui::RenderPropertyToImGuiHelper( T& val, const class AXPropertyMetaDat
 template< class T >
 void AXImGui::RenderPropertyToImGuiHelper( T& val, const AXString& label )
 {
-	if( std::is_base_of< AXIImGuiRenderable, T >::value )
-	{
-		((AXIImGuiRenderable&)( val )).RenderToImGui( label );
-	}
-	else
-	{
-		DoRenderPropertyToImGuiHelper( val );
-	}
+	DoRenderPropertyToImGuiHelper( val, label, std::integral_constant< bool, AXImGuiTraits< T >::IsSpecialized >( ) );
+}
+
+template< class T >
+void AXImGui::DoRenderPropertyToImGuiHelper( T& val, const AXString& label, std::true_type hasImGuiTraits )
+{
+	AXImGuiTraits< T >::RenderToImGui( val, label );
+}
+
+template< class T >
+void AXImGui::DoRenderPropertyToImGuiHelper( T& val, const AXString& label, std::false_type hasImGuiTraits )
+{
+	DoRenderPropertyToImGuiHelper( val );
 }
 
 template< class T >
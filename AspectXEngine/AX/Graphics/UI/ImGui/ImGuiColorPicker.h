@@ -17,7 +17,7 @@ namespace ImGui
 
 		ImGui::SetNextWindowContentSize( ImVec2( 256.0f, 0.0f ) );
 		
-		if( ImGui::Begin( AXUtils::FormatString( "Color Picker: %s", label ).c_str(), windowVisible, ImGuiWindowFlags_NoCollapse | ImGuiWindowFlags_NoResize ) )
+		if( ImGui::Begin( AXUtils::FormatFrameString( "Color Picker: %s", label ).c_str(), windowVisible, ImGuiWindowFlags_NoCollapse | ImGuiWindowFlags_NoResize ) )
 		{
 			bool alphabar = ( numElements == 4 );
 
@@ -256,7 +256,7 @@ namespace ImGui
 				ImVec4 col( color[ 0 ], color[1], color[2], numElements == 4 ? color[3] : 1.0f );
 
 				const ImGuiStyle& style = g->Style;
-				const ImGuiID id = window->GetID( AXUtils::FormatString( "#ColorPickerPreview: %s %d", label, line ).c_str() );
+				const ImGuiID id = window->GetID( AXUtils::FormatFrameString( "#ColorPickerPreview: %s %d", label, line ).c_str() );
 				const float square_size = g->FontSize;
 				ImRect bb;
 				bb.Min = bb.Max = window->DC.CursorPos;
@@ -1,11 +1,17 @@
 // Copyright 2016 Scott Bevin, All Rights Reserved
 
 #include <iostream>
-#include <corecrt_io.h>
 
 #include "AXDirectory.h"
 #include "AX/Core/AXLogging.h"
+
+#if defined( AXPLATFORM_WINDOWS )
+#include <corecrt_io.h>
 #include <wtypes.h>
+#else
+#include <dirent.h>
+#include <sys/stat.h>
+#endif // #if defined( AXPLATFORM_WINDOWS )
 
 /**
 * Clears out the current directory results and reads the results in from the new path, returns true if the directory exists
@@ -17,6 +23,7 @@ bool AXDirectory::Open( const AXString& path )
 
 	if( Exists( path ) )
 	{
+#if defined( AXPLATFORM_WINDOWS )
 		AXString searchPath = path + "/*";
 
 		struct _finddata_t findData;
@@ -39,6 +46,26 @@ bool AXDirectory::Open( const AXString& path )
 
 			return true;
 		}
+#else
+		if( DIR* dir = opendir( path.c_str( ) ) )
+		{
+			while( dirent* entry = readdir( dir ) )
+			{
+				if( entry->d_name[0] != '.' )
+				{
+					Item item;
+					item.mName = entry->d_name;
+					item.mType = ( Exists( path + "/" + item.mName ) ? Item::Type::Directory : Item::Type::File );
+
+					mContents.push_back( item );
+				}
+			}
+
+			closedir( dir );
+
+			return true;
+		}
+#endif // #if defined( AXPLATFORM_WINDOWS )
 	}
 
 	return false;
@@ -57,8 +84,14 @@ void AXDirectory::WatchForChanges( )
 */
 bool AXDirectory::Exists( const AXString& path )
 {
+#if defined( AXPLATFORM_WINDOWS )
 	DWORD dwAttrib = GetFileAttributes( path.c_str() );
 
 	return ( dwAttrib != INVALID_FILE_ATTRIBUTES &&
 		( dwAttrib & FILE_ATTRIBUTE_DIRECTORY ) );
+#else
+	struct stat info;
+
+	return ( stat( path.c_str( ), &info ) == 0 && S_ISDIR( info.st_mode ) );
+#endif // #if defined( AXPLATFORM_WINDOWS )
 }
\ No newline at end of file
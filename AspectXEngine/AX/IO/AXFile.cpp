@@ -4,6 +4,8 @@
 #include "AX/Utils/AXUtils.h"
 #include "AX/Core/AXLogging.h"
 
+#include <string.h>
+
 /**
 * Constructor
 */
@@ -25,8 +27,8 @@ AXFile::AXFile( const AXString& path, FileOpenMode fop, DataMode dm )
 */
 AXFile::~AXFile()
 {
+	// Derived files close themselves, by now CloseFile would only reach the unimplemented base version
 	DestroyInternalBuffer( );
-	CloseFile( );
 }
 
 /**
@@ -91,16 +93,11 @@ AXFile::InternalFileBuffer& AXFile::GetInternalBuffer( )
 }
 
 /**
-* Returns a copy of the internal buffer then clear out our version
+* Moves the internal buffer out of the file, leaving the file without one
 */
 AXFile::InternalFileBuffer AXFile::ObtainInternalBuffer( )
 {
-	AXFile::InternalFileBuffer fbCopy( mInternalFileBuffer );
-
-	mInternalFileBuffer.mBuffer = nullptr;
-	mInternalFileBuffer.mBufferSize = 0;
-
-	return fbCopy;
+	return std::move( mInternalFileBuffer );
 }
 
 /**
@@ -112,12 +109,16 @@ AXFile::InternalFileBuffer& AXFile::CreateInternalBuffer( FileSize size, uint8_t
 
 	if( size > 0 )
 	{
-		mInternalFileBuffer.mBufferSize = size;
-		mInternalFileBuffer.mBuffer = new uint8_t[size];
+		// One extra byte for the terminator, the pool rounds up to a size class so this rarely changes the block size
+		mInternalFileBuffer = GetBufferPool( ).Acquire< FileSize >( size + 1 );
+		AXASSERT( mInternalFileBuffer, "Failed to allocate internal file buffer" );
+
+		mInternalFileBuffer.SetSize( size );
+		mInternalFileBuffer.Data( )[size] = 0;
 
 		if( data )
 		{
-			memcpy( mInternalFileBuffer.mBuffer, data, sizeof( uint8_t ) * size );
+			memcpy( mInternalFileBuffer.Data( ), data, sizeof( uint8_t ) * size );
 		}
 	}
 
@@ -129,10 +130,7 @@ AXFile::InternalFileBuffer& AXFile::CreateInternalBuffer( FileSize size, uint8_t
 */
 void AXFile::DestroyInternalBuffer( )
 {
-	delete[] mInternalFileBuffer.mBuffer;
-
-	mInternalFileBuffer.mBuffer = nullptr;
-	mInternalFileBuffer.mBufferSize = 0;
+	mInternalFileBuffer.Free( );
 }
 
 /**
@@ -149,4 +147,15 @@ AXString AXFile::GetExtention( const AXString& path )
 	}
 
 	return path.substr( periodLoc, strLen - periodLoc );
+}
+
+/**
+* Returns the pool internal file buffers are allocated from, shared by every file and never destroyed. Holds at most 32MB of
+* idle buffers, the application trims it on shutdown
+*/
+AXBufferPool& AXFile::GetBufferPool( )
+{
+	// Leaked on purpose so buffers that outlive static destruction can still be returned to it
+	static AXBufferPool* pool( new AXBufferPool( 64 * 1024, 64 * 1024 * 1024, 32 * 1024 * 1024 ) );
+	return *pool;
 }
\ No newline at end of file
@@ -5,6 +5,7 @@
 #include "AX/Utils/AXString.h"
 #include "AX/Utils/AXBaseObject.h"
 #include "AX/Utils/AXParent.h"
+#include "AX/Utils/AXBuffer.h"
 
 class AXFile : public AXParent< AXBaseObject, AXFile >
 {
@@ -30,11 +31,10 @@ public:
 		Binary,
 	};
 
-	struct InternalFileBuffer
-	{
-		uint8_t* mBuffer = nullptr;
-		FileSize mBufferSize = 0;
-	};
+	/**
+	 * Internal buffers are taken from a shared pool and always have a zero byte after their contents so text can be parsed in place
+	 */
+	using InternalFileBuffer = AXBuffer< FileSize >;
 
 public:
 	/**
@@ -89,7 +89,7 @@ public:
 	InternalFileBuffer& GetInternalBuffer( );
 
 	/**
-	* Returns a copy of the internal buffer then clear out our version
+	* Moves the internal buffer out of the file, leaving the file without one
 	*/
 	InternalFileBuffer ObtainInternalBuffer( );
 
@@ -112,6 +112,12 @@ public:
 	 */
 	static AXString GetExtention( const AXString& path );
 
+	/**
+	 * Returns the pool internal file buffers are allocated from, shared by every file and never destroyed. Holds at most 32MB
+	 * of idle buffers, the application trims it on shutdown
+	 */
+	static AXBufferPool& GetBufferPool( );
+
 protected:
 	/**
 	 * Handles our internal buffer
@@ -2,7 +2,7 @@
 
 #include "AXFileSystem.h"
 
-AXString AXSystem< AXFileSystem >::sSystemName = "Files";
+template<> AXName AXSystem< AXFileSystem >::sSystemName = "Files";
 
 /**
 * Initialise the system, called after settings are loaded
@@ -30,9 +30,9 @@ void AXFileSystem::OnShutdown( )
 
 /**
 * Creates a new file and queues it for an async read, returns a pointer to the file that
-* must be destroyed by calling DestroyFile() when finished.
+* must be destroyed by calling DestroyFile() when finished. Takes ownership of the params buffer
 */
-class AXFile* AXFileSystem::ReadFile( const FileTransactionParams& params )
+class AXFile* AXFileSystem::ReadFile( FileTransactionParams&& params )
 {
 	return nullptr;
 }
@@ -50,5 +50,5 @@ void AXFileSystem::DestroyFile( class AXFile& file )
 */
 void AXFileSystem::CreateEngineSettings( class AXSettingsFile& settings )
 {
-	mSettings = settings.RegisterNewItem< AXFileSystem::Settings >( AXFileSystem::StaticName( ) );
+	mSettings = settings.RegisterNewItem< AXFileSystem::Settings >( AXFileSystem::StaticName( ).GetString( ) );
 }
@@ -77,7 +77,7 @@ public:
 
 		/**
 		 * An allocated buffer to read the file into, the size of the buffer indicates the amount that will be requested read 
-		 * from the file is mReadAmount is 0
+		 * from the file is mReadAmount is 0. Move only, the file system takes ownership of it when the read is queued
 		 */
 		AXBuffer64 mBuffer;
 
@@ -89,9 +89,9 @@ public:
 
 	/**
 	 * Creates a new file and queues it for an async read, returns a pointer to the file that
-	 * must be destroyed by calling DestroyFile() when finished.
+	 * must be destroyed by calling DestroyFile() when finished. Takes ownership of the params buffer
 	 */
-	class AXFile* ReadFile( const FileTransactionParams& params );
+	class AXFile* ReadFile( FileTransactionParams&& params );
 
 	/**
 	 * Cleanly destroys the file and any associated memory in a thread-safe manner
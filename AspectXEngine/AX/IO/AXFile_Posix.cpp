@@ -0,0 +1,165 @@
+// Copyright 2016 Scott Bevin, All Rights Reserved
+
+#if !defined( AXPLATFORM_WINDOWS )
+
+#include "AXFile_Posix.h"
+#include "AX/Utils/AXUtils.h"
+#include "AX/Core/AXProfiler.h"
+#include "AX/Core/AXPerfCounters.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/**
+* Destructor
+*/
+AXFile_Posix::~AXFile_Posix( )
+{
+	CloseFile( );
+}
+
+/**
+* Opens a file, returns true if the file was successfully
+* opened.
+*/
+bool AXFile_Posix::OpenFile( const AXString& path, FileOpenMode fop, DataMode dm )
+{
+	AXPROFILE_SCOPE( "File Open" );
+
+	if( IsOpen( ) )
+	{
+		CloseFile( );
+	}
+
+	// There is no text mode here, so the data mode makes no difference
+	int flags( 0 );
+
+	switch( fop )
+	{
+		case FileOpenMode::Write: { flags = O_WRONLY | O_CREAT | O_TRUNC; } break;
+		case FileOpenMode::Read: { flags = O_RDONLY; } break;
+		case FileOpenMode::Append: { flags = O_WRONLY | O_CREAT | O_APPEND; } break;
+		case FileOpenMode::Truncate: { flags = O_WRONLY | O_CREAT | O_TRUNC; } break;
+		case FileOpenMode::ReadWrite: { flags = O_RDWR; } break;
+	};
+
+	mFileDescriptor = open( path.c_str( ), flags | O_CLOEXEC, 0644 );
+
+	if( IsOpen( ) )
+	{
+		AXPERF_COUNT( "File/Opened", 1 );
+	}
+
+	return IsOpen( );
+}
+
+/**
+* Returns if the file is open
+*/
+bool AXFile_Posix::IsOpen( ) const
+{
+	return mFileDescriptor >= 0;
+}
+
+/**
+* Closes the file, leaving internal buffer intact
+*/
+void AXFile_Posix::CloseFile( )
+{
+	if( IsOpen( ) )
+	{
+		close( mFileDescriptor );
+		mFileDescriptor = -1;
+	}
+}
+
+/**
+* Returns the size of the file
+*/
+AXFile_Posix::FileSize AXFile_Posix::GetFileSize( ) const
+{
+	struct stat info;
+
+	if( !IsOpen( ) || fstat( mFileDescriptor, &info ) != 0 )
+	{
+		return 0;
+	}
+
+	return ( FileSize )info.st_size;
+}
+
+/**
+* File must be open, reads the contents from the file into the internal buffer and returns the internal buffer
+*/
+AXFile_Posix::InternalFileBuffer& AXFile_Posix::ReadFileToInternalBuffer( )
+{
+	AXPROFILE_SCOPE( "File Read" );
+
+	FileSize filesize( GetFileSize( ) );
+	CreateInternalBuffer( filesize );
+
+	if( filesize > 0 )
+	{
+		AXASSERT0( mInternalFileBuffer.Size( ) == filesize );
+
+		// Reads from the start of the file, the same as the Windows implementation
+		FileSize totalRead( 0 );
+
+		while( totalRead < filesize )
+		{
+			const ssize_t numRead( pread( mFileDescriptor, mInternalFileBuffer.Data( ) + totalRead, ( size_t )( filesize - totalRead ), ( off_t )totalRead ) );
+
+			if( numRead < 0 && errno == EINTR )
+			{
+				continue;
+			}
+
+			if( numRead <= 0 )
+			{
+				break;
+			}
+
+			totalRead += ( FileSize )numRead;
+		}
+
+		AXPERF_COUNT( "File/Bytes Read", totalRead );
+	}
+
+	return mInternalFileBuffer;
+}
+
+/**
+* File must be open, writes the contents of the internal buffer to the file
+*/
+void AXFile_Posix::WriteInternalBufferToFile( )
+{
+	if( IsOpen( ) && mInternalFileBuffer && mInternalFileBuffer.Size( ) > 0 )
+	{
+		AXPROFILE_SCOPE( "File Write" );
+
+		FileSize totalWritten( 0 );
+
+		while( totalWritten < mInternalFileBuffer.Size( ) )
+		{
+			const ssize_t numWritten( write( mFileDescriptor, mInternalFileBuffer.Data( ) + totalWritten, ( size_t )( mInternalFileBuffer.Size( ) - totalWritten ) ) );
+
+			if( numWritten < 0 && errno == EINTR )
+			{
+				continue;
+			}
+
+			if( numWritten <= 0 )
+			{
+				break;
+			}
+
+			totalWritten += ( FileSize )numWritten;
+		}
+
+		AXPERF_COUNT( "File/Bytes Written", totalWritten );
+	}
+}
+
+#endif // #if !defined( AXPLATFORM_WINDOWS )
\ No newline at end of file
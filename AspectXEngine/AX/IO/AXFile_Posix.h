@@ -0,0 +1,57 @@
+// Copyright 2016 Scott Bevin, All Rights Reserved
+
+#pragma once
+
+#if !defined( AXPLATFORM_WINDOWS )
+
+#include "AX/IO/AXFile.h"
+
+class AXFile_Posix : public AXParent< AXFile, AXFile_Posix >
+{
+public:
+	using AXParent::AXParent;
+
+	/**
+	* Destructor
+	*/
+	virtual ~AXFile_Posix( );
+
+	/**
+	* Opens a file, returns true if the file was successfully
+	* opened.
+	*/
+	virtual bool OpenFile( const AXString& path, FileOpenMode fop, DataMode dm = AXFile::DataMode::Normal ) override;
+
+	/**
+	* Returns if the file is open
+	*/
+	virtual bool IsOpen( ) const override;
+
+	/**
+	* Closes the file, leaving internal buffer intact
+	*/
+	virtual void CloseFile( ) override;
+
+	/**
+	* Returns the size of the file
+	*/
+	virtual FileSize GetFileSize( ) const override;
+
+	/**
+	* File must be open, reads the contents from the file into the internal buffer and returns the internal buffer
+	*/
+	virtual InternalFileBuffer& ReadFileToInternalBuffer( ) override;
+
+	/**
+	* File must be open, writes the contents of the internal buffer to the file
+	*/
+	virtual void WriteInternalBufferToFile( ) override;
+
+private:
+	/**
+	* The descriptor of the file we have open, -1 when closed
+	*/
+	int mFileDescriptor = -1;
+};
+
+#endif // #if !defined( AXPLATFORM_WINDOWS )
\ No newline at end of file
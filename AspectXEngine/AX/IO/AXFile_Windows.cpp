@@ -4,6 +4,8 @@
 
 #include "AXFile_Windows.h"
 #include "AX\Utils\AXUtils.h"
+#include "AX\Core\AXProfiler.h"
+#include "AX\Core\AXPerfCounters.h"
 #include <xiosbase>
 
 /**
@@ -12,6 +14,8 @@
 */
 bool AXFile_Windows::OpenFile( const AXString& path, FileOpenMode fop, DataMode dm )
 {
+	AXPROFILE_SCOPE( "File Open" );
+
 	if( IsOpen( ) )
 	{
 		CloseFile( );
@@ -35,6 +39,11 @@ bool AXFile_Windows::OpenFile( const AXString& path, FileOpenMode fop, DataMode
 
 	mFile.open( path, openMode );
 
+	if( IsOpen( ) )
+	{
+		AXPERF_COUNT( "File/Opened", 1 );
+	}
+
 	return IsOpen( );
 }
 
@@ -89,13 +98,17 @@ AXFile_Windows::FileSize AXFile_Windows::GetFileSize( ) const
 */
 AXFile_Windows::InternalFileBuffer& AXFile_Windows::ReadFileToInternalBuffer( )
 {
+	AXPROFILE_SCOPE( "File Read" );
+
 	FileSize filesize( GetFileSize( ) );
 	CreateInternalBuffer( filesize );
 
 	if( filesize > 0 )
 	{
-		AXASSERT0( mInternalFileBuffer.mBufferSize == filesize );
-		mFile.read( ( char* )mInternalFileBuffer.mBuffer, mInternalFileBuffer.mBufferSize );
+		AXASSERT0( mInternalFileBuffer.Size( ) == filesize );
+		mFile.read( ( char* )mInternalFileBuffer.Data( ), mInternalFileBuffer.Size( ) );
+
+		AXPERF_COUNT( "File/Bytes Read", mFile.gcount( ) );
 	}
 
 	return mInternalFileBuffer;
@@ -106,9 +119,12 @@ AXFile_Windows::InternalFileBuffer& AXFile_Windows::ReadFileToInternalBuffer( )
 */
 void AXFile_Windows::WriteInternalBufferToFile( )
 {
-	if( IsOpen( ) && mInternalFileBuffer.mBuffer && mInternalFileBuffer.mBufferSize > 0 )
+	if( IsOpen( ) && mInternalFileBuffer && mInternalFileBuffer.Size( ) > 0 )
 	{
-		mFile.write( ( char* )mInternalFileBuffer.mBuffer, mInternalFileBuffer.mBufferSize );
+		AXPROFILE_SCOPE( "File Write" );
+		mFile.write( ( char* )mInternalFileBuffer.Data( ), mInternalFileBuffer.Size( ) );
+
+		AXPERF_COUNT( "File/Bytes Written", mFile.good( ) ? mInternalFileBuffer.Size( ) : 0 );
 	}
 }
 
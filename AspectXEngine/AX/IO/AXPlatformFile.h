@@ -0,0 +1,18 @@
+// Copyright 2016 Scott Bevin, All Rights Reserved
+
+#pragma once
+
+/**
+ * AXPlatformFile is the AXFile implementation for the platform being built
+ */
+#if defined( AXPLATFORM_WINDOWS )
+
+#include "AX/IO/AXFile_Windows.h"
+using AXPlatformFile = AXFile_Windows;
+
+#else
+
+#include "AX/IO/AXFile_Posix.h"
+using AXPlatformFile = AXFile_Posix;
+
+#endif // #if defined( AXPLATFORM_WINDOWS )
\ No newline at end of file
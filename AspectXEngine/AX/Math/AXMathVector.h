@@ -4,14 +4,16 @@
 
 #include "AX/Utils/AXJSON.h"
 #include "AX/Graphics/UI/ImGui/AXImGui.h"
-#include "AX/Utils/AXInterface.h"
-#include "AX/Utils/AXParent.h"
-#include "AX/Utils/AXBaseObject.h"
+#include "Libs/IMGui/imgui_internal.h"
 
+#include <type_traits>
+
+/**
+ * A plain value type with no virtuals so it can be memcpy'd and stored densely, JSON and im gui support is provided
+ * through the AXJSONTraits and AXImGuiTraits specialisations below
+ */
 template< class TBaseType, uint32_t TNumElements >
-class AXMathVector : public AXParent< AXBaseObject, AXMathVector< TBaseType, TNumElements > >
-				, public AXImplementsInterface< AXIJSONParsable >
-				, public AXImplementsInterface< AXIImGuiRenderable >
+class AXMathVector
 {
 public:
 	using VectorType = AXMathVector< TBaseType, TNumElements >;
@@ -19,6 +21,8 @@ public:
 	static const uint32_t NumElements = TNumElements;
 
 public:
+
+	AXMathVector( ) = default;
 	
 	AXMathVector( const BaseType& val )
 	{
@@ -221,14 +225,6 @@ public:
 	const BaseType& Z( ) const { static_assert( NumElements >= 3, "Vector size too small." ); return mElements[2]; }
 	const BaseType& W( ) const { static_assert( NumElements >= 4, "Vector size too small." ); return mElements[3]; }
 
-	// Helpers
-
-	virtual void ReadFromJSON( cJSON& jsonRoot, const char* name ) override;
-
-	virtual void WriteToJSON( cJSON& jsonRoot, const char* name ) const override;
-
-	virtual void RenderToImGui( const AXString& label ) override;
-
 public:
 	BaseType mElements[NumElements];
 };
@@ -279,55 +275,72 @@ using AXVector4i64 = AXMathVector< int64_t, 4 >;
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
+static_assert( std::is_trivially_copyable< AXVector4f >::value, "Math vectors must stay trivially copyable" );
+static_assert( sizeof( AXVector4f ) == sizeof( float ) * 4, "Math vectors must not carry any data beyond their elements" );
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-// Helpers
 template< class TBaseType, uint32_t TNumElements >
-void AXMathVector< TBaseType, TNumElements >::ReadFromJSON( cJSON& jsonRoot, const char* name )
+struct AXJSONTraits< AXMathVector< TBaseType, TNumElements > >
 {
-	if( cJSON* jsonArray = cJSON_GetObjectItem( &jsonRoot, name ) )
-	{
-		uint32_t elementsInJsonArray( cJSON_GetArraySize( jsonArray ) );
-		AXASSERT_WARN( elementsInJsonArray == NumElements, "JSON has the wrong number of elements for vector" );
+	using VectorType = AXMathVector< TBaseType, TNumElements >;
+
+	static const bool IsSpecialized = true;
 
-		for( uint32_t i( 0 ); i < AXUtils::Min( elementsInJsonArray, TNumElements ); ++i )
+	static void ReadFromJSON( cJSON& jsonRoot, VectorType& val, const char* name )
+	{
+		if( cJSON* jsonArray = cJSON_GetObjectItem( &jsonRoot, name ) )
 		{
-			AXJSON::ReadValueFromArray( *jsonArray, mElements[i], i );
+			uint32_t elementsInJsonArray( cJSON_GetArraySize( jsonArray ) );
+			AXASSERT_WARN( elementsInJsonArray == TNumElements, "JSON has the wrong number of elements for vector" );
+
+			for( uint32_t i( 0 ); i < AXUtils::Min( elementsInJsonArray, TNumElements ); ++i )
+			{
+				AXJSON::ReadValueFromArray( *jsonArray, val.mElements[i], i );
+			}
 		}
 	}
-}
 
-template< class TBaseType, uint32_t TNumElements >
-void AXMathVector< TBaseType, TNumElements >::WriteToJSON( cJSON& jsonRoot, const char* name ) const
-{
-	if( cJSON* jsonArray = cJSON_CreateArray( ) )
+	static void WriteToJSON( cJSON& jsonRoot, const VectorType& val, const char* name )
 	{
-		cJSON_AddItemToObject( &jsonRoot, name, jsonArray );
-
-		for( const BaseType& val : mElements )
+		if( cJSON* jsonArray = cJSON_CreateArray( ) )
 		{
-			AXJSON::WriteValueToArray( *jsonArray, val );
+			cJSON_AddItemToObject( &jsonRoot, name, jsonArray );
+
+			for( const TBaseType& ele : val.mElements )
+			{
+				AXJSON::WriteValueToArray( *jsonArray, ele );
+			}
 		}
 	}
-}
+};
 
 template< class TBaseType, uint32_t TNumElements >
-void AXMathVector< TBaseType, TNumElements >::RenderToImGui( const AXString& label )
+struct AXImGuiTraits< AXMathVector< TBaseType, TNumElements > >
 {
-	ImGui::BeginGroup( );
+	using VectorType = AXMathVector< TBaseType, TNumElements >;
 
-	ImGui::PushMultiItemsWidths( TNumElements );
+	static const bool IsSpecialized = true;
 
-	for( uint32_t i( 0 ); i < TNumElements; ++i )
+	static void RenderToImGui( VectorType& val, const AXString& label )
 	{
-		ImGui::PushID( i );
+		ImGui::BeginGroup( );
 
-		AXImGui::RenderPropertyToImGuiHelper< BaseType >( mElements[ i ], label );
-		ImGui::SameLine( 0.0f, ImGui::GetStyle().ItemInnerSpacing.x );
+		ImGui::PushMultiItemsWidths( TNumElements );
 
-		ImGui::PopID( );
+		for( uint32_t i( 0 ); i < TNumElements; ++i )
+		{
+			ImGui::PushID( i );
 
-		ImGui::PopItemWidth( );
-	}
+			AXImGui::RenderPropertyToImGuiHelper< TBaseType >( val.mElements[ i ], label );
+			ImGui::SameLine( 0.0f, ImGui::GetStyle().ItemInnerSpacing.x );
+
+			ImGui::PopID( );
 
-	ImGui::EndGroup( );
-}
\ No newline at end of file
+			ImGui::PopItemWidth( );
+		}
+
+		ImGui::EndGroup( );
+	}
+};
\ No newline at end of file
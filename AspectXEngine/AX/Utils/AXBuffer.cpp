@@ -0,0 +1,208 @@
+// Copyright 2016 Scott Bevin, All Rights Reserved
+
+#include "AXBuffer.h"
+
+#include <stdlib.h>
+
+#if defined( AXPLATFORM_WINDOWS )
+#include <malloc.h>
+#endif
+
+/**
+* Allocates size bytes aligned to alignment, which must be a power of two. Must be freed with AXAlignedFree
+*/
+void* AXAlignedAlloc( size_t size, size_t alignment )
+{
+	if( alignment < sizeof( void* ) )
+	{
+		alignment = sizeof( void* );
+	}
+
+#if defined( AXPLATFORM_WINDOWS )
+	return _aligned_malloc( size, alignment );
+#else
+	void* ptr( nullptr );
+	return posix_memalign( &ptr, alignment, size ) == 0 ? ptr : nullptr;
+#endif
+}
+
+/**
+* Frees memory allocated with AXAlignedAlloc
+*/
+void AXAlignedFree( void* ptr )
+{
+#if defined( AXPLATFORM_WINDOWS )
+	_aligned_free( ptr );
+#else
+	free( ptr );
+#endif
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace
+{
+	size_t RoundUpToPowerOfTwo( size_t val )
+	{
+		size_t ret( 1 );
+
+		while( ret < val )
+		{
+			ret <<= 1;
+		}
+
+		return ret;
+	}
+}
+
+/**
+* Constructor, min and max block size are rounded up to powers of two. Free blocks are freed rather than cached once
+* maxCachedBytes are cached
+*/
+AXBufferPool::AXBufferPool( size_t minBlockSize, size_t maxBlockSize, size_t maxCachedBytes )
+	: mMinBlockSize( RoundUpToPowerOfTwo( minBlockSize ) )
+	, mMaxBlockSize( RoundUpToPowerOfTwo( maxBlockSize < minBlockSize ? minBlockSize : maxBlockSize ) )
+	, mMaxCachedBytes( maxCachedBytes )
+{
+	for( size_t blockSize( mMinBlockSize ); blockSize <= mMaxBlockSize; blockSize <<= 1 )
+	{
+		mFreeBlocks.emplace_back( );
+		mFreeBlocks.back( ).reserve( mMaxCachedBytes / blockSize );
+	}
+}
+
+/**
+* Destructor, frees every cached block
+*/
+AXBufferPool::~AXBufferPool( )
+{
+	Trim( );
+}
+
+/**
+* Frees every cached block
+*/
+void AXBufferPool::Trim( )
+{
+	Lock( );
+
+	for( auto& freeBlocks : mFreeBlocks )
+	{
+		for( void* block : freeBlocks )
+		{
+			AXAlignedFree( block );
+		}
+
+		freeBlocks.clear( );
+	}
+
+	mStats.mCachedBytes = 0;
+
+	Unlock( );
+}
+
+/**
+* Returns the pools usage stats
+*/
+AXBufferPool::Stats AXBufferPool::GetStats( ) const
+{
+	Lock( );
+	Stats ret( mStats );
+	Unlock( );
+
+	return ret;
+}
+
+/**
+* Returns a block of at least size bytes and its real capacity, prefer Acquire
+*/
+void* AXBufferPool::AcquireBlock( size_t size, size_t& outCapacity )
+{
+	const uint32_t sizeClass( SizeClassFor( size ) );
+
+	if( sizeClass >= mFreeBlocks.size( ) )
+	{
+		outCapacity = size;
+		return AXAlignedAlloc( size, AXBUFFERPOOL_ALIGNMENT );
+	}
+
+	outCapacity = mMinBlockSize << sizeClass;
+
+	void* block( nullptr );
+
+	Lock( );
+
+	++mStats.mAcquires;
+
+	if( !mFreeBlocks[sizeClass].empty( ) )
+	{
+		block = mFreeBlocks[sizeClass].back( );
+		mFreeBlocks[sizeClass].pop_back( );
+
+		++mStats.mHits;
+		mStats.mCachedBytes -= outCapacity;
+	}
+
+	Unlock( );
+
+	return block ? block : AXAlignedAlloc( outCapacity, AXBUFFERPOOL_ALIGNMENT );
+}
+
+/**
+* Returns a block to the pool, capacity must be the one returned by AcquireBlock
+*/
+void AXBufferPool::RecycleBlock( void* block, size_t capacity )
+{
+	const uint32_t sizeClass( SizeClassFor( capacity ) );
+	bool cached( false );
+
+	if( sizeClass < mFreeBlocks.size( ) && ( mMinBlockSize << sizeClass ) == capacity )
+	{
+		Lock( );
+
+		if( mStats.mCachedBytes + capacity <= mMaxCachedBytes )
+		{
+			mFreeBlocks[sizeClass].push_back( block );
+			mStats.mCachedBytes += capacity;
+			cached = true;
+		}
+
+		Unlock( );
+	}
+
+	if( !cached )
+	{
+		AXAlignedFree( block );
+	}
+}
+
+/**
+* Returns the size class index that fits size, or the number of classes if it is too large to pool
+*/
+uint32_t AXBufferPool::SizeClassFor( size_t size ) const
+{
+	uint32_t sizeClass( 0 );
+
+	for( size_t blockSize( mMinBlockSize ); blockSize < size && blockSize <= mMaxBlockSize; blockSize <<= 1 )
+	{
+		++sizeClass;
+	}
+
+	return sizeClass;
+}
+
+void AXBufferPool::Lock( ) const
+{
+	bool expected( false );
+
+	do
+	{
+		expected = false;
+	} while( !mLocked.compare_exchange_weak( expected, true ) );
+}
+
+void AXBufferPool::Unlock( ) const
+{
+	mLocked = false;
+}
\ No newline at end of file
@@ -1,34 +1,280 @@
+// Copyright 2016 Scott Bevin, All Rights Reserved
+
 #pragma once
+
+#include "AXThreadingPrimitives.h"
+
+#include <stddef.h>
 #include <stdint.h>
+#include <utility>
+#include <vector>
+
+/**
+ * Alignment of buffers allocated without an explicit alignment, wide enough for SSE and AVX loads
+ */
+#define AXBUFFER_DEFAULT_ALIGNMENT 32
+
+/**
+ * Alignment of every buffer handed out by a buffer pool, a page so pooled buffers can be used for direct / unbuffered IO
+ */
+#define AXBUFFERPOOL_ALIGNMENT 4096
+
+/**
+ * Allocates size bytes aligned to alignment, which must be a power of two. Must be freed with AXAlignedFree
+ */
+void* AXAlignedAlloc( size_t size, size_t alignment );
+
+/**
+ * Frees memory allocated with AXAlignedAlloc
+ */
+void AXAlignedFree( void* ptr );
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+template< typename TSize >
+class AXBuffer;
+
+/**
+ * Recycles large buffers so repeated IO doesn't allocate and free megabytes every time. Blocks are grouped into power of
+ * two size classes between the min and max block size, and free blocks are cached until the total cached across every class
+ * reaches a byte limit. Requests above the max block size are allocated directly and freed on release. The pool must
+ * outlive every buffer acquired from it
+ */
+class AXBufferPool
+{
+public:
+	struct Stats
+	{
+		uint64_t mAcquires = 0;
+		uint64_t mHits = 0;
+		uint64_t mCachedBytes = 0;
+	};
+
+public:
+	/**
+	* Constructor, min and max block size are rounded up to powers of two. Free blocks are freed rather than cached once
+	* maxCachedBytes are cached
+	*/
+	AXBufferPool( size_t minBlockSize, size_t maxBlockSize, size_t maxCachedBytes );
+
+	/**
+	* Destructor, frees every cached block
+	*/
+	~AXBufferPool( );
 
+	AXBufferPool( const AXBufferPool& ) = delete;
+	AXBufferPool& operator = ( const AXBufferPool& ) = delete;
+
+	/**
+	* Returns a buffer of at least size bytes, aligned to AXBUFFERPOOL_ALIGNMENT, the memory is returned to the pool when the buffer is freed
+	*/
+	template< typename TSize >
+	AXBuffer< TSize > Acquire( TSize size );
+
+	/**
+	* Frees every cached block
+	*/
+	void Trim( );
+
+	/**
+	* Returns the pools usage stats
+	*/
+	Stats GetStats( ) const;
+
+	/**
+	* Returns a block of at least size bytes and its real capacity, prefer Acquire
+	*/
+	void* AcquireBlock( size_t size, size_t& outCapacity );
+
+	/**
+	* Returns a block to the pool, capacity must be the one returned by AcquireBlock
+	*/
+	void RecycleBlock( void* block, size_t capacity );
+
+private:
+	/**
+	* Returns the size class index that fits size, or the number of classes if it is too large to pool
+	*/
+	uint32_t SizeClassFor( size_t size ) const;
+
+	void Lock( ) const;
+	void Unlock( ) const;
+
+private:
+	/**
+	 * Free blocks for every size class, each reserved up front so recycling never allocates under the lock
+	 */
+	std::vector< std::vector< void* > > mFreeBlocks;
+
+	size_t mMinBlockSize;
+	size_t mMaxBlockSize;
+	size_t mMaxCachedBytes;
+
+	Stats mStats;
+
+	mutable AXAtomic< bool > mLocked = false;
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * An owned, aligned block of bytes. Move only, the memory is freed or returned to its pool when the buffer is destroyed
+ */
 template< typename TSize >
 class AXBuffer
 {
 public:
+	AXBuffer( ) = default;
 
-	AXBuffer( )
-		: mAddr( nullptr )
-		, mSize( 0 )
+	/**
+	* Allocates an uninitialised buffer of size bytes aligned to alignment, which must be a power of two
+	*/
+	explicit AXBuffer( TSize size, size_t alignment = AXBUFFER_DEFAULT_ALIGNMENT )
+		: mAddr( size > 0 ? static_cast< uint8_t* >( AXAlignedAlloc( size, alignment ) ) : nullptr )
+		, mSize( mAddr ? size : 0 )
+		, mCapacity( mSize )
 	{
 
 	}
 
-	AXBuffer( TSize size )
-		: mAddr( new uint8_t[size] )
-		, mSize( size )
+	AXBuffer( AXBuffer&& other )
+		: mAddr( other.mAddr )
+		, mSize( other.mSize )
+		, mCapacity( other.mCapacity )
+		, mPool( other.mPool )
 	{
+		other.Detach( );
 	}
 
+	AXBuffer& operator = ( AXBuffer&& other )
+	{
+		if( this != &other )
+		{
+			Free( );
+
+			mAddr = other.mAddr;
+			mSize = other.mSize;
+			mCapacity = other.mCapacity;
+			mPool = other.mPool;
+
+			other.Detach( );
+		}
+
+		return *this;
+	}
+
+	AXBuffer( const AXBuffer& ) = delete;
+	AXBuffer& operator = ( const AXBuffer& ) = delete;
+
 	~AXBuffer( )
 	{
-		delete mAddr;
+		Free( );
 	}
 
-	uint8_t* mAddr;
-	TSize mSize;
+	/**
+	* Frees the memory, or returns it to the pool it came from, leaving the buffer empty
+	*/
+	void Free( )
+	{
+		if( mAddr )
+		{
+			if( mPool )
+			{
+				mPool->RecycleBlock( mAddr, mCapacity );
+			}
+			else
+			{
+				AXAlignedFree( mAddr );
+			}
+		}
+
+		Detach( );
+	}
+
+	/**
+	* Changes the size of the buffer without reallocating, returns false if size is larger than the capacity
+	*/
+	bool SetSize( TSize size )
+	{
+		if( size > mCapacity )
+		{
+			return false;
+		}
+
+		mSize = size;
+		return true;
+	}
+
+	uint8_t* Data( ) { return mAddr; }
+	const uint8_t* Data( ) const { return mAddr; }
+
+	/**
+	* Returns the usable size of the buffer
+	*/
+	TSize Size( ) const { return mSize; }
+
+	/**
+	* Returns the size of the underlying allocation, pooled buffers are rounded up to their size class
+	*/
+	size_t Capacity( ) const { return mCapacity; }
+
+	/**
+	* Returns true if the memory will be returned to a pool when freed
+	*/
+	bool IsPooled( ) const { return mPool != nullptr; }
+
+	explicit operator bool( ) const { return mAddr != nullptr; }
+
+private:
+	friend class AXBufferPool;
+
+	AXBuffer( uint8_t* addr, TSize size, size_t capacity, AXBufferPool* pool )
+		: mAddr( addr )
+		, mSize( addr ? size : 0 )
+		, mCapacity( addr ? capacity : 0 )
+		, mPool( addr ? pool : nullptr )
+	{
+
+	}
+
+	void Detach( )
+	{
+		mAddr = nullptr;
+		mSize = 0;
+		mCapacity = 0;
+		mPool = nullptr;
+	}
+
+private:
+	uint8_t* mAddr = nullptr;
+	TSize mSize = 0;
+	size_t mCapacity = 0;
+	AXBufferPool* mPool = nullptr;
 };
 
 using AXBuffer8 = AXBuffer<uint8_t>;
 using AXBuffer16 = AXBuffer<uint16_t>;
 using AXBuffer32 = AXBuffer<uint32_t>; 
-using AXBuffer64 = AXBuffer<uint64_t>;
\ No newline at end of file
+using AXBuffer64 = AXBuffer<uint64_t>;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+* Returns a buffer of at least size bytes, aligned to AXBUFFERPOOL_ALIGNMENT, the memory is returned to the pool when the buffer is freed
+*/
+template< typename TSize >
+AXBuffer< TSize > AXBufferPool::Acquire( TSize size )
+{
+	if( size == 0 )
+	{
+		return AXBuffer< TSize >( );
+	}
+
+	size_t capacity( 0 );
+	uint8_t* block( static_cast< uint8_t* >( AcquireBlock( size, capacity ) ) );
+
+	return AXBuffer< TSize >( block, size, capacity, this );
+}
\ No newline at end of file
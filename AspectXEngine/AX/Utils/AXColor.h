@@ -4,25 +4,22 @@
 
 #include "AX/Math/AXMathVector.h"
 #include "AX/Graphics/UI/ImGui/ImGuiColorPicker.h"
-#include "AXParent.h"
 
 template< class TBaseType, uint32_t TNumElements >
-class AXColor : public AXParent< AXMathVector< TBaseType, TNumElements >, AXColor< TBaseType, TNumElements > >
+class AXColor : public AXMathVector< TBaseType, TNumElements >
 {
 public:
-	using AXParent< AXMathVector< TBaseType, TNumElements >, AXColor< TBaseType, TNumElements > >::AXParent;
+	using AXMathVector< TBaseType, TNumElements >::AXMathVector;
 
-	TBaseType& R( ) { return X( ); }
-	TBaseType& G( ) { return Y( ); }
-	TBaseType& B( ) { return Z( ); }
-	TBaseType& A( ) { return W( ); }
+	TBaseType& R( ) { return this->X( ); }
+	TBaseType& G( ) { return this->Y( ); }
+	TBaseType& B( ) { return this->Z( ); }
+	TBaseType& A( ) { return this->W( ); }
 
-	const TBaseType& R( ) const { return X( ); }
-	const TBaseType& G( ) const { return Y( ); }
-	const TBaseType& B( ) const { return Z( ); }
-	const TBaseType& A( ) const { return W( ); }
-
-	virtual void RenderToImGui( const AXString& label ) override;
+	const TBaseType& R( ) const { return this->X( ); }
+	const TBaseType& G( ) const { return this->Y( ); }
+	const TBaseType& B( ) const { return this->Z( ); }
+	const TBaseType& A( ) const { return this->W( ); }
 };
 
 using AXColorRGBf = AXColor< float, 3 >;
@@ -31,8 +28,20 @@ using AXColorRGBAf = AXColor< float, 4 >;
 using AXColorRGBu8 = AXColor< uint8_t, 3 >;
 using AXColorRGBAu8 = AXColor< uint8_t, 4 >;
 
+static_assert( std::is_trivially_copyable< AXColorRGBAf >::value, "Colors must stay trivially copyable" );
+
 template< class TBaseType, uint32_t TNumElements >
-void AXColor< TBaseType, TNumElements >::RenderToImGui( const AXString& label )
+struct AXJSONTraits< AXColor< TBaseType, TNumElements > > : public AXJSONTraits< AXMathVector< TBaseType, TNumElements > >
 {
-	ImGuiColorPickerPreview( label.c_str(), &(mElements[0]), TNumElements, false );
-}
\ No newline at end of file
+};
+
+template< class TBaseType, uint32_t TNumElements >
+struct AXImGuiTraits< AXColor< TBaseType, TNumElements > >
+{
+	static const bool IsSpecialized = true;
+
+	static void RenderToImGui( AXColor< TBaseType, TNumElements >& val, const AXString& label )
+	{
+		ImGuiColorPickerPreview( label.c_str(), &( val.mElements[0] ), TNumElements, false );
+	}
+};
\ No newline at end of file
@@ -0,0 +1,175 @@
+// Copyright 2016 Scott Bevin, All Rights Reserved
+
+#include "AXFrameAllocator.h"
+
+#include <algorithm>
+
+/**
+* Default size of each thread's scratch blocks, overridden by the application settings
+*/
+#define AXFRAMEALLOCATOR_DEFAULT_BLOCK_SIZE ( 256 * 1024 )
+
+struct alignas( AXCACHE_LINE_SIZE ) AXFrameAllocator::ThreadScratch
+{
+	ThreadScratch( size_t blockSize ) : mAllocators{ { blockSize }, { blockSize } } { }
+
+	/**
+	* Two allocators, used on alternate frames
+	*/
+	AXLinearAllocator mAllocators[2];
+
+	/**
+	* The frame the active allocator was last rewound for, only touched by the owning thread
+	*/
+	uint64_t mFrameIndex = ~0ull;
+
+	/**
+	* Stats for the frame in mPublishedFrameIndex, written by the owning thread and gathered in EndFrame
+	*/
+	AXAtomic< uint64_t > mPublishedFrameIndex = ~0ull;
+	AXAtomic< size_t > mBytesUsed = 0;
+	AXAtomic< size_t > mOverflowBytesUsed = 0;
+	AXAtomic< uint32_t > mNumAllocations = 0;
+
+	/**
+	* Set once the owning thread has exited, the scratch is then freed in the next EndFrame
+	*/
+	AXAtomic< bool > mRetired = false;
+};
+
+struct AXFrameAllocator::ThreadScratchOwner
+{
+	~ThreadScratchOwner( )
+	{
+		if( mScratch )
+		{
+			mScratch->mRetired = true;
+		}
+	}
+
+	ThreadScratch* mScratch = nullptr;
+};
+
+AXAtomic< uint64_t > AXFrameAllocator::sFrameIndex = 0;
+AXAtomic< size_t > AXFrameAllocator::sBlockSize = AXFRAMEALLOCATOR_DEFAULT_BLOCK_SIZE;
+AXFrameAllocator::FrameStats AXFrameAllocator::sLastFrameStats;
+size_t AXFrameAllocator::sHighWaterMark = 0;
+
+AXAtomic< bool > AXFrameAllocator::sThreadScratchesLocked = false;
+
+/**
+* Allocates size bytes of scratch memory for the current frame
+*/
+void* AXFrameAllocator::Allocate( size_t size, size_t alignment )
+{
+	ThreadScratch& scratch( GetThreadScratch( ) );
+
+	const uint64_t frameIndex( sFrameIndex );
+	AXLinearAllocator& allocator( scratch.mAllocators[frameIndex & 1] );
+
+	if( scratch.mFrameIndex != frameIndex )
+	{
+		allocator.SetBlockSize( sBlockSize );
+		allocator.Reset( );
+
+		scratch.mFrameIndex = frameIndex;
+		scratch.mPublishedFrameIndex = frameIndex;
+	}
+
+	void* ptr( allocator.Allocate( size, alignment ) );
+
+	scratch.mBytesUsed.store( allocator.BytesUsed( ), std::memory_order_relaxed );
+	scratch.mOverflowBytesUsed.store( allocator.OverflowBytesUsed( ), std::memory_order_relaxed );
+	scratch.mNumAllocations.store( allocator.NumAllocations( ), std::memory_order_relaxed );
+
+	return ptr;
+}
+
+/**
+* Ends the current frame, gathers its statistics and lets every thread's scratch rewind on its next use. Called by AXApplication
+*/
+void AXFrameAllocator::EndFrame( )
+{
+	FrameStats stats;
+	stats.mFrameIndex = sFrameIndex;
+
+	LockThreadScratches( );
+
+	AXVector< ThreadScratch* >& threadScratches( GetThreadScratches( ) );
+
+	for( auto it = threadScratches.begin( ); it != threadScratches.end( ); )
+	{
+		ThreadScratch* scratch( *it );
+
+		if( scratch->mRetired )
+		{
+			delete scratch;
+			it = threadScratches.erase( it );
+			continue;
+		}
+
+		if( scratch->mPublishedFrameIndex == stats.mFrameIndex )
+		{
+			stats.mBytesUsed += scratch->mBytesUsed.load( std::memory_order_relaxed );
+			stats.mOverflowBytesUsed += scratch->mOverflowBytesUsed.load( std::memory_order_relaxed );
+			stats.mNumAllocations += scratch->mNumAllocations.load( std::memory_order_relaxed );
+			++stats.mNumThreads;
+		}
+
+		++it;
+	}
+
+	UnlockThreadScratches( );
+
+	sLastFrameStats = stats;
+	sHighWaterMark = std::max( sHighWaterMark, stats.mBytesUsed );
+
+	++sFrameIndex;
+}
+
+/**
+* Sets the size of each thread's scratch block, existing blocks grow to it on their next rewind
+*/
+void AXFrameAllocator::SetBlockSize( size_t blockSize )
+{
+	sBlockSize = blockSize;
+}
+
+/**
+* Returns the calling thread's scratch, creating and registering it on first use
+*/
+AXFrameAllocator::ThreadScratch& AXFrameAllocator::GetThreadScratch( )
+{
+	static thread_local ThreadScratchOwner owner;
+
+	if( !owner.mScratch )
+	{
+		owner.mScratch = new ThreadScratch( sBlockSize );
+
+		LockThreadScratches( );
+		GetThreadScratches( ).push_back( owner.mScratch );
+		UnlockThreadScratches( );
+	}
+
+	return *owner.mScratch;
+}
+
+/**
+* Returns every thread's scratch, must only be accessed with the scratch lock held
+*/
+AXVector< AXFrameAllocator::ThreadScratch* >& AXFrameAllocator::GetThreadScratches( )
+{
+	static AXVector< ThreadScratch* > threadScratches;
+	return threadScratches;
+}
+
+void AXFrameAllocator::LockThreadScratches( )
+{
+	bool expectedLockedFlag = false;
+	do { expectedLockedFlag = false; } while( !sThreadScratchesLocked.compare_exchange_weak( expectedLockedFlag, true ) );
+}
+
+void AXFrameAllocator::UnlockThreadScratches( )
+{
+	sThreadScratchesLocked = false;
+}
\ No newline at end of file
@@ -0,0 +1,125 @@
+// Copyright 2016 Scott Bevin, All Rights Reserved
+
+#pragma once
+
+#include "AXLinearAllocator.h"
+#include "AXThreadingPrimitives.h"
+#include "AXVector.h"
+
+#include <string>
+#include <vector>
+
+/**
+ * Per thread scratch memory that lives for a frame. Every thread gets a pair of AXLinearAllocators on first use and
+ * alternates between them each frame, rewinding the one it switches to the first time it allocates after AXApplication
+ * has ended a frame. Memory is therefore valid until the end of the frame after the one it was allocated in, which keeps
+ * work that straddles a frame boundary safe, but must never be kept longer than that. Frees are no-ops
+ */
+class AXFrameAllocator
+{
+public:
+	/**
+	* Statistics for a single frame, summed over every thread that used frame scratch during that frame
+	*/
+	struct FrameStats
+	{
+		uint64_t mFrameIndex = 0;
+		size_t mBytesUsed = 0;
+		size_t mOverflowBytesUsed = 0;
+		uint32_t mNumAllocations = 0;
+		uint32_t mNumThreads = 0;
+	};
+
+public:
+	/**
+	* Allocates size bytes of scratch memory for the current frame
+	*/
+	static void* Allocate( size_t size, size_t alignment = AXLINEARALLOCATOR_DEFAULT_ALIGNMENT );
+
+	/**
+	* Allocates an uninitialised array of count elements of T for the current frame
+	*/
+	template< class T >
+	static T* AllocateArray( size_t count ) { return static_cast< T* >( Allocate( sizeof( T ) * count, alignof( T ) ) ); }
+
+	/**
+	* Ends the current frame, gathers its statistics and lets every thread's scratch rewind on its next use. Called by AXApplication
+	*/
+	static void EndFrame( );
+
+	/**
+	* Sets the size of each thread's scratch block, existing blocks grow to it on their next rewind
+	*/
+	static void SetBlockSize( size_t blockSize );
+
+	/**
+	* Returns the index of the frame currently being allocated for
+	*/
+	static uint64_t FrameIndex( ) { return sFrameIndex; }
+
+	/**
+	* Returns the statistics of the last completed frame
+	*/
+	static const FrameStats& LastFrameStats( ) { return sLastFrameStats; }
+
+	/**
+	* Returns the most scratch memory used by any single completed frame
+	*/
+	static size_t HighWaterMark( ) { return sHighWaterMark; }
+
+private:
+	struct ThreadScratch;
+	struct ThreadScratchOwner;
+
+	/**
+	* Returns the calling thread's scratch, creating and registering it on first use
+	*/
+	static ThreadScratch& GetThreadScratch( );
+
+	/**
+	* Returns every thread's scratch, must only be accessed with the scratch lock held
+	*/
+	static AXVector< ThreadScratch* >& GetThreadScratches( );
+
+	static void LockThreadScratches( );
+	static void UnlockThreadScratches( );
+
+	static AXAtomic< uint64_t > sFrameIndex;
+	static AXAtomic< size_t > sBlockSize;
+	static FrameStats sLastFrameStats;
+	static size_t sHighWaterMark;
+	static AXAtomic< bool > sThreadScratchesLocked;
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * STL allocator adapter over AXFrameAllocator, containers using it must not outlive the frame
+ */
+template< class T >
+class AXFrameStlAllocator
+{
+public:
+	using value_type = T;
+
+	AXFrameStlAllocator( ) = default;
+
+	template< class U >
+	AXFrameStlAllocator( const AXFrameStlAllocator< U >& ) { }
+
+	T* allocate( size_t count ) { return AXFrameAllocator::AllocateArray< T >( count ); }
+
+	void deallocate( T*, size_t ) { }
+
+	template< class U >
+	bool operator == ( const AXFrameStlAllocator< U >& ) const { return true; }
+
+	template< class U >
+	bool operator != ( const AXFrameStlAllocator< U >& ) const { return false; }
+};
+
+using AXFrameString = std::basic_string< char, std::char_traits< char >, AXFrameStlAllocator< char > >;
+
+template< class T >
+using AXFrameVector = std::vector< T, AXFrameStlAllocator< T > >;
\ No newline at end of file
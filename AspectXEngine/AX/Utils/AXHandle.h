@@ -2,22 +2,29 @@
 
 #pragma once
 
-#include "AXParent.h"
-#include "AXBaseObject.h"
 #include <stdint.h>
-
-template< class TIdType, class TUniqueType >
-class AXHandleBase : public AXParent< AXBaseObject, AXHandleBase< TIdType, TUniqueType > >
+#include <limits>
+#include <type_traits>
+
+/**
+ * A lightweight handle to a slot within a resource pool. The id is the index of the slot, the generation is a per slot
+ * counter that the owning pool bumps every time the slot is released, so stale handles can be detected with a simple compare.
+ * Generation 0 is never handed out by a pool, which is what makes Invalid fail validation against any slot
+ */
+template< class TIdType, class TGenerationType >
+class AXHandleBase
 {
 public:
 	using IdType = TIdType;
-	using UniqueType = TUniqueType;
-	using HandleType = AXHandleBase< TIdType, TUniqueType >;
+	using GenerationType = TGenerationType;
+	using HandleType = AXHandleBase< TIdType, TGenerationType >;
 
-	AXHandleBase( const HandleType& hndl ) : mId( hndl.mId ), mUnique( hndl.mUnique ) { }
+	AXHandleBase( ) : mId( 0 ), mGeneration( 0 ) { }
 
 	const IdType& Id( ) const { return mId; }
 
+	const GenerationType& Generation( ) const { return mGeneration; }
+
 	bool IsValid( ) const { return *this != Invalid; }
 
 	// Operators
@@ -27,44 +34,43 @@ public:
 	operator const IdType&( ) const { return mId; }
 	operator IdType( ) const { return mId; }
 
-	HandleType& operator = ( const HandleType& hndl ) { mId = hndl.mId; mUnique = hndl.mUnique; return *this; }
-
-	bool operator == ( const HandleType& hndl ) const { return ( mId == hndl.mId && mUnique == hndl.mUnique ); }
+	bool operator == ( const HandleType& hndl ) const { return ( mId == hndl.mId && mGeneration == hndl.mGeneration ); }
 
 	bool operator != ( const HandleType& hndl ) const { return !( *this == hndl ); }
 
-	static HandleType Create( )
+	static HandleType Create( const IdType &id, const GenerationType& generation )
 	{
-		static AXAtomic< IdType > nextId = 0;
-		return Create( nextId++ );
+		return HandleType( id, generation );
 	}
 
-	static HandleType Create( const IdType &id )
+	/**
+	 * Returns the generation that follows the given one, skipping 0 when it wraps so a slot never matches Invalid
+	 */
+	static GenerationType NextGeneration( const GenerationType& generation )
 	{
-		return HandleType( id );
+		const GenerationType next( static_cast< GenerationType >( generation + 1 ) );
+		return next != 0 ? next : FirstGeneration;
 	}
 
 protected:
-	AXHandleBase( ) : AXHandleBase( Invalid ) { }
-	AXHandleBase( const IdType &id ) : mId( id ) { AllocateNextUnique( mUnique ); }
-
-	void AllocateNextUnique( UniqueType& unique )
-	{
-		static AXAtomic< UniqueType > nextUnique = 0;
-		unique = nextUnique++;
-	}
+	AXHandleBase( const IdType &id, const GenerationType& generation ) : mId( id ), mGeneration( generation ) { }
 
 private:
 	IdType mId;
-	UniqueType mUnique;
+	GenerationType mGeneration;
 
 public:
 	static const HandleType Invalid;
 
 	static const IdType MaxId = std::numeric_limits< TIdType >::max( );
+
+	static const GenerationType FirstGeneration = 1;
 };
 
-template< class TIdType, class TUniqueType >
-const AXHandleBase< TIdType, TUniqueType > AXHandleBase< TIdType, TUniqueType >::Invalid = AXHandleBase< TIdType, TUniqueType >( 0 );
+template< class TIdType, class TGenerationType >
+const AXHandleBase< TIdType, TGenerationType > AXHandleBase< TIdType, TGenerationType >::Invalid = AXHandleBase< TIdType, TGenerationType >( );
+
+using AXHandle = AXHandleBase< uint32_t, uint32_t >;
 
-using AXHandle = AXHandleBase< uint32_t, uint32_t >;
\ No newline at end of file
+static_assert( std::is_trivially_copyable< AXHandle >::value, "Handles are passed around by value and must stay trivially copyable" );
+static_assert( sizeof( AXHandle ) == sizeof( uint32_t ) * 2, "AXHandle is expected to pack into 8 bytes" );
\ No newline at end of file
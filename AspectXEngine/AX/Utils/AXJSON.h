@@ -6,6 +6,8 @@
 #include "AX/Utils/AXString.h"
 #include "AXInterface.h"
 
+#include <type_traits>
+
 class AXIJSONParsable : public AXInterface< AXIJSONParsable >
 {
 public:
@@ -13,11 +15,24 @@ public:
 	virtual void WriteToJSON( cJSON& jsonRoot, const char* name ) const = 0;
 };
 
+/**
+ * Non-intrusive alternative to AXIJSONParsable for value types that should stay free of virtuals. Specialise for a type
+ * and provide static ReadFromJSON( cJSON&, T&, const char* ) and WriteToJSON( cJSON&, const T&, const char* ) functions
+ */
+template< class T, class TEnable = void >
+struct AXJSONTraits
+{
+	static const bool IsSpecialized = false;
+};
+
 class AXJSON
 {
 public:
 	static void WriteValue( cJSON& jsonRoot, const AXIJSONParsable& val, const char* name ) { val.WriteToJSON( jsonRoot, name ); }
 
+	template< class T >
+	static typename std::enable_if< AXJSONTraits< T >::IsSpecialized >::type WriteValue( cJSON& jsonRoot, const T& val, const char* name ) { AXJSONTraits< T >::WriteToJSON( jsonRoot, val, name ); }
+
 	static void WriteValue( cJSON& jsonRoot, const AXString& val, const char* name ) { cJSON_AddStringToObject( &jsonRoot, name, val.c_str( ) ); }
 
 	static void WriteValue( cJSON& jsonRoot, const bool& val, const char* name ) { cJSON_AddBoolToObject( &jsonRoot, name, val ); }
@@ -43,6 +58,9 @@ public:
 
 	static void ReadValue( cJSON& jsonRoot, AXIJSONParsable& val, const char* name ) { val.ReadFromJSON( jsonRoot, name ); }
 
+	template< class T >
+	static typename std::enable_if< AXJSONTraits< T >::IsSpecialized >::type ReadValue( cJSON& jsonRoot, T& val, const char* name ) { AXJSONTraits< T >::ReadFromJSON( jsonRoot, val, name ); }
+
 	static void ReadValue( cJSON& jsonRoot, float& val, const char* name )
 	{
 		if( cJSON* versionJSON = cJSON_GetObjectItem( &jsonRoot, name ) )
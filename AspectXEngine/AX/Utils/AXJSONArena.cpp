@@ -0,0 +1,79 @@
+// Copyright 2016 Scott Bevin, All Rights Reserved
+
+#include "AXJSONArena.h"
+#include "Libs/cJSON/cJSON.h"
+
+#include <stdlib.h>
+
+namespace
+{
+	static thread_local AXJSONArenaScope* tActiveScope = nullptr;
+}
+
+/**
+* Constructor, blockSize should roughly fit the parsed document, anything beyond it spills into overflow blocks
+*/
+AXJSONArenaScope::AXJSONArenaScope( size_t blockSize )
+	: mArena( blockSize )
+	, mPrevious( tActiveScope )
+{
+	InstallHooks( );
+	tActiveScope = this;
+}
+
+/**
+* Destructor, frees everything allocated in the scope
+*/
+AXJSONArenaScope::~AXJSONArenaScope( )
+{
+	tActiveScope = mPrevious;
+}
+
+/**
+* Returns a block size suited to parsing a document of textSize bytes
+*/
+size_t AXJSONArenaScope::BlockSizeForText( size_t textSize )
+{
+	// Every value costs a node as well as its text, for typical settings and manifests the parsed size is about 3x the text
+	return textSize * 3 + 1024;
+}
+
+/**
+* cJSON's hooks are global, so they are installed once and route every allocation through the calling thread's active scope
+*/
+void AXJSONArenaScope::InstallHooks( )
+{
+	static const bool installed = [ ]( )
+	{
+		cJSON_Hooks hooks;
+		hooks.malloc_fn = &AXJSONArenaScope::Malloc;
+		hooks.free_fn = &AXJSONArenaScope::Free;
+		cJSON_InitHooks( &hooks );
+		return true;
+	}( );
+
+	( void )installed;
+}
+
+void* AXJSONArenaScope::Malloc( size_t size )
+{
+	if( tActiveScope )
+	{
+		return tActiveScope->mArena.Allocate( size, sizeof( void* ) );
+	}
+
+	return malloc( size );
+}
+
+void AXJSONArenaScope::Free( void* ptr )
+{
+	for( AXJSONArenaScope* scope( tActiveScope ); scope; scope = scope->mPrevious )
+	{
+		if( scope->mArena.Owns( ptr ) )
+		{
+			return;
+		}
+	}
+
+	free( ptr );
+}
\ No newline at end of file
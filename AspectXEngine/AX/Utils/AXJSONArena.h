@@ -0,0 +1,67 @@
+// Copyright 2016 Scott Bevin, All Rights Reserved
+
+#pragma once
+
+#include "AXLinearAllocator.h"
+
+#include <stddef.h>
+
+/**
+ * Block size used when a scope is not given one
+ */
+#define AXJSONARENA_DEFAULT_BLOCK_SIZE ( 64 * 1024 )
+
+/**
+ * While in scope, every cJSON allocation made on the constructing thread is carved out of a linear arena, so a whole
+ * document parses into a few contiguous blocks and cJSON_Delete becomes a no-op, the memory is released in one go when
+ * the scope ends. Nodes and strings created inside the scope must not be used or freed after it ends. Scopes can nest,
+ * memory allocated outside any scope is still freed normally
+ */
+class AXJSONArenaScope
+{
+public:
+	/**
+	* Constructor, blockSize should roughly fit the parsed document, anything beyond it spills into overflow blocks
+	*/
+	AXJSONArenaScope( size_t blockSize = AXJSONARENA_DEFAULT_BLOCK_SIZE );
+
+	/**
+	* Destructor, frees everything allocated in the scope
+	*/
+	~AXJSONArenaScope( );
+
+	AXJSONArenaScope( const AXJSONArenaScope& ) = delete;
+	AXJSONArenaScope& operator = ( const AXJSONArenaScope& ) = delete;
+
+	/**
+	* Returns the number of bytes allocated inside the scope so far
+	*/
+	size_t BytesUsed( ) const { return mArena.BytesUsed( ); }
+
+	/**
+	* Returns the number of cJSON allocations made inside the scope so far
+	*/
+	uint32_t NumAllocations( ) const { return mArena.NumAllocations( ); }
+
+	/**
+	* Returns a block size suited to parsing a document of textSize bytes
+	*/
+	static size_t BlockSizeForText( size_t textSize );
+
+private:
+	/**
+	* cJSON's hooks are global, so they are installed once and route every allocation through the calling thread's active scope
+	*/
+	static void InstallHooks( );
+
+	static void* Malloc( size_t size );
+	static void Free( void* ptr );
+
+private:
+	AXLinearAllocator mArena;
+
+	/**
+	* The scope that was active on this thread when this one was created
+	*/
+	AXJSONArenaScope* mPrevious;
+};
\ No newline at end of file
@@ -0,0 +1,172 @@
+// Copyright 2016 Scott Bevin, All Rights Reserved
+
+#include "AXLinearAllocator.h"
+#include "AXUtils.h"
+
+#include <stdlib.h>
+
+/**
+* Constructor, the main block is allocated on first use
+*/
+AXLinearAllocator::AXLinearAllocator( size_t blockSize )
+	: mRequestedBlockSize( blockSize )
+{
+
+}
+
+/**
+* Destructor
+*/
+AXLinearAllocator::~AXLinearAllocator( )
+{
+	FreeOverflowBlocks( );
+	free( mBlock );
+}
+
+/**
+* Allocates size bytes with the given power of two alignment, the memory is valid until the next Reset( )
+*/
+void* AXLinearAllocator::Allocate( size_t size, size_t alignment )
+{
+	AXASSERT( ( alignment & ( alignment - 1 ) ) == 0, "Linear allocator alignment must be a power of two, got %d", ( int )alignment );
+
+	if( !mBlock && mRequestedBlockSize > 0 )
+	{
+		mBlock = static_cast< uint8_t* >( malloc( mRequestedBlockSize ) );
+		mBlockSize = mBlock ? mRequestedBlockSize : 0;
+	}
+
+	++mNumAllocations;
+
+	if( void* ptr = AllocateFromBlock( mBlock, mBlockSize, mOffset, size, alignment ) )
+	{
+		return ptr;
+	}
+
+	return AllocateOverflow( size, alignment );
+}
+
+/**
+* Frees every allocation made since the last reset, frees any overflow blocks and grows the main block if they were needed
+*/
+void AXLinearAllocator::Reset( )
+{
+	const size_t bytesUsed( BytesUsed( ) );
+
+	if( bytesUsed > mHighWaterMark )
+	{
+		mHighWaterMark = bytesUsed;
+	}
+
+	size_t wantedBlockSize( mRequestedBlockSize );
+
+	if( mOverflowBlocks )
+	{
+		// Padding in the overflow blocks is counted, so this is a slight overestimate of what is needed
+		wantedBlockSize = AXUtils::Max( wantedBlockSize, bytesUsed + ( bytesUsed / 4 ) );
+		FreeOverflowBlocks( );
+	}
+
+	if( wantedBlockSize > mBlockSize )
+	{
+		free( mBlock );
+		mBlock = static_cast< uint8_t* >( malloc( wantedBlockSize ) );
+		mBlockSize = mBlock ? wantedBlockSize : 0;
+	}
+
+	mOffset = 0;
+	mOverflowBytesUsed = 0;
+	mNumAllocations = 0;
+}
+
+/**
+* Returns true if ptr points into the main block or one of the overflow blocks
+*/
+bool AXLinearAllocator::Owns( const void* ptr ) const
+{
+	const uint8_t* bytePtr( static_cast< const uint8_t* >( ptr ) );
+
+	if( mBlock && bytePtr >= mBlock && bytePtr < mBlock + mBlockSize )
+	{
+		return true;
+	}
+
+	for( OverflowBlock* block( mOverflowBlocks ); block; block = block->mNext )
+	{
+		if( bytePtr >= block->Data( ) && bytePtr < block->Data( ) + block->mSize )
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+/**
+* Tries to carve an aligned allocation out of a block, returns nullptr if it does not fit
+*/
+void* AXLinearAllocator::AllocateFromBlock( uint8_t* block, size_t blockSize, size_t& offset, size_t size, size_t alignment )
+{
+	if( !block )
+	{
+		return nullptr;
+	}
+
+	const uintptr_t start( reinterpret_cast< uintptr_t >( block ) + offset );
+	const uintptr_t aligned( ( start + alignment - 1 ) & ~( uintptr_t )( alignment - 1 ) );
+	const size_t newOffset( offset + ( aligned - start ) + size );
+
+	if( newOffset > blockSize )
+	{
+		return nullptr;
+	}
+
+	offset = newOffset;
+
+	return reinterpret_cast< void* >( aligned );
+}
+
+/**
+* Allocates from the overflow blocks, adding a new one if the current one is full
+*/
+void* AXLinearAllocator::AllocateOverflow( size_t size, size_t alignment )
+{
+	if( mOverflowBlocks )
+	{
+		const size_t offsetBefore( mOverflowBlocks->mOffset );
+
+		if( void* ptr = AllocateFromBlock( mOverflowBlocks->Data( ), mOverflowBlocks->mSize, mOverflowBlocks->mOffset, size, alignment ) )
+		{
+			mOverflowBytesUsed += mOverflowBlocks->mOffset - offsetBefore;
+			return ptr;
+		}
+	}
+
+	const size_t blockSize( AXUtils::Max( AXUtils::Max( mBlockSize, mRequestedBlockSize ), size + alignment ) );
+
+	OverflowBlock* block( static_cast< OverflowBlock* >( malloc( sizeof( OverflowBlock ) + blockSize ) ) );
+	AXASSERT( block, "Linear allocator failed to allocate an overflow block of %d bytes", ( int )blockSize );
+
+	block->mNext = mOverflowBlocks;
+	block->mSize = blockSize;
+	block->mOffset = 0;
+	mOverflowBlocks = block;
+
+	void* ptr( AllocateFromBlock( block->Data( ), block->mSize, block->mOffset, size, alignment ) );
+	mOverflowBytesUsed += block->mOffset;
+
+	return ptr;
+}
+
+/**
+* Frees all overflow blocks
+*/
+void AXLinearAllocator::FreeOverflowBlocks( )
+{
+	while( mOverflowBlocks )
+	{
+		OverflowBlock* next( mOverflowBlocks->mNext );
+		free( mOverflowBlocks );
+		mOverflowBlocks = next;
+	}
+}
\ No newline at end of file
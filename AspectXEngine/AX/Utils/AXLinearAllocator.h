@@ -0,0 +1,121 @@
+// Copyright 2016 Scott Bevin, All Rights Reserved
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * Default alignment for linear allocations, enough for any fundamental type
+ */
+#define AXLINEARALLOCATOR_DEFAULT_ALIGNMENT 16
+
+/**
+ * A bump allocator, allocations are carved linearly out of a single block and freed all at once with Reset( ). When the
+ * block runs out further allocations spill into overflow blocks taken from the heap, and the next Reset( ) grows the main
+ * block so the same workload fits without overflowing. Not thread safe
+ */
+class AXLinearAllocator
+{
+public:
+	/**
+	* Constructor, the main block is allocated on first use
+	*/
+	AXLinearAllocator( size_t blockSize );
+
+	/**
+	* Destructor
+	*/
+	~AXLinearAllocator( );
+
+	AXLinearAllocator( const AXLinearAllocator& ) = delete;
+	AXLinearAllocator& operator = ( const AXLinearAllocator& ) = delete;
+
+	/**
+	* Allocates size bytes with the given power of two alignment, the memory is valid until the next Reset( )
+	*/
+	void* Allocate( size_t size, size_t alignment = AXLINEARALLOCATOR_DEFAULT_ALIGNMENT );
+
+	/**
+	* Allocates an uninitialised array of count elements of T
+	*/
+	template< class T >
+	T* AllocateArray( size_t count ) { return static_cast< T* >( Allocate( sizeof( T ) * count, alignof( T ) ) ); }
+
+	/**
+	* Frees every allocation made since the last reset, frees any overflow blocks and grows the main block if they were needed
+	*/
+	void Reset( );
+
+	/**
+	* Sets the minimum size of the main block, takes effect on the next Reset( ). The block never shrinks
+	*/
+	void SetBlockSize( size_t blockSize ) { mRequestedBlockSize = blockSize; }
+
+	/**
+	* Returns the size of the main block
+	*/
+	size_t BlockSize( ) const { return mBlockSize; }
+
+	/**
+	* Returns the number of bytes handed out since the last reset, including alignment padding
+	*/
+	size_t BytesUsed( ) const { return mOffset + mOverflowBytesUsed; }
+
+	/**
+	* Returns the number of bytes handed out from overflow blocks since the last reset
+	*/
+	size_t OverflowBytesUsed( ) const { return mOverflowBytesUsed; }
+
+	/**
+	* Returns the largest number of bytes that were in use before any reset
+	*/
+	size_t HighWaterMark( ) const { return mHighWaterMark > BytesUsed( ) ? mHighWaterMark : BytesUsed( ); }
+
+	/**
+	* Returns the number of allocations made since the last reset
+	*/
+	uint32_t NumAllocations( ) const { return mNumAllocations; }
+
+	/**
+	* Returns true if ptr points into the main block or one of the overflow blocks
+	*/
+	bool Owns( const void* ptr ) const;
+
+private:
+	struct OverflowBlock
+	{
+		OverflowBlock* mNext;
+		size_t mSize;
+		size_t mOffset;
+
+		uint8_t* Data( ) { return reinterpret_cast< uint8_t* >( this + 1 ); }
+	};
+
+	/**
+	* Tries to carve an aligned allocation out of a block, returns nullptr if it does not fit
+	*/
+	static void* AllocateFromBlock( uint8_t* block, size_t blockSize, size_t& offset, size_t size, size_t alignment );
+
+	/**
+	* Allocates from the overflow blocks, adding a new one if the current one is full
+	*/
+	void* AllocateOverflow( size_t size, size_t alignment );
+
+	/**
+	* Frees all overflow blocks
+	*/
+	void FreeOverflowBlocks( );
+
+private:
+	uint8_t* mBlock = nullptr;
+	size_t mBlockSize = 0;
+	size_t mRequestedBlockSize = 0;
+	size_t mOffset = 0;
+
+	OverflowBlock* mOverflowBlocks = nullptr;
+	size_t mOverflowBytesUsed = 0;
+
+	size_t mHighWaterMark = 0;
+	uint32_t mNumAllocations = 0;
+};
\ No newline at end of file
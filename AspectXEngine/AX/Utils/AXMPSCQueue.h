@@ -0,0 +1,132 @@
+// Copyright 2016 Scott Bevin, All Rights Reserved
+
+#pragma once
+
+#include "AXThreadingPrimitives.h"
+
+#include <stddef.h>
+#include <stdint.h>
+#include <utility>
+#include <vector>
+
+/**
+ * A bounded, lock-free, multiple producer single consumer queue. Each cell carries a sequence number so producers claim a
+ * cell with a single compare exchange on the enqueue position and publish it with a release store, the consumer never
+ * touches the producers' cache line. Capacity is rounded up to a power of two. TryPop must only ever be called from one
+ * thread at a time, callers that hand consumption between threads must serialise it themselves
+ */
+template< class T >
+class AXMPSCQueue
+{
+public:
+	/**
+	* Constructor, capacity is rounded up to a power of two
+	*/
+	AXMPSCQueue( size_t capacity )
+	{
+		size_t roundedCapacity( 2 );
+
+		while( roundedCapacity < capacity )
+		{
+			roundedCapacity <<= 1;
+		}
+
+		mMask = roundedCapacity - 1;
+		mCells = std::vector< Cell >( roundedCapacity );
+
+		for( size_t i( 0 ); i < roundedCapacity; ++i )
+		{
+			mCells[i].mSequence.store( i, std::memory_order_relaxed );
+		}
+	}
+
+	AXMPSCQueue( const AXMPSCQueue& ) = delete;
+	AXMPSCQueue& operator = ( const AXMPSCQueue& ) = delete;
+
+	/**
+	* Attempts to push a value, returns false without moving from val if the queue is full. Safe to call from any thread
+	*/
+	bool TryPush( T&& val )
+	{
+		size_t pos( mEnqueuePos.load( std::memory_order_relaxed ) );
+		Cell* cell( nullptr );
+
+		while( true )
+		{
+			cell = &mCells[pos & mMask];
+
+			const size_t sequence( cell->mSequence.load( std::memory_order_acquire ) );
+			const intptr_t diff( ( intptr_t )sequence - ( intptr_t )pos );
+
+			if( diff == 0 )
+			{
+				if( mEnqueuePos.compare_exchange_weak( pos, pos + 1, std::memory_order_relaxed ) )
+				{
+					break;
+				}
+			}
+			else if( diff < 0 )
+			{
+				return false;
+			}
+			else
+			{
+				pos = mEnqueuePos.load( std::memory_order_relaxed );
+			}
+		}
+
+		cell->mValue = std::move( val );
+		cell->mSequence.store( pos + 1, std::memory_order_release );
+
+		return true;
+	}
+
+	/**
+	* Attempts to pop the oldest value, returns false if the queue is empty or the oldest value is still being written
+	*/
+	bool TryPop( T& outVal )
+	{
+		Cell& cell( mCells[mDequeuePos & mMask] );
+
+		if( cell.mSequence.load( std::memory_order_acquire ) != mDequeuePos + 1 )
+		{
+			return false;
+		}
+
+		outVal = std::move( cell.mValue );
+		cell.mSequence.store( mDequeuePos + mMask + 1, std::memory_order_release );
+		++mDequeuePos;
+
+		return true;
+	}
+
+	/**
+	* Returns true if there is nothing to pop, only a hint when producers are active
+	*/
+	bool IsEmpty( ) const
+	{
+		return mCells[mDequeuePos & mMask].mSequence.load( std::memory_order_acquire ) != mDequeuePos + 1;
+	}
+
+	/**
+	* Returns the number of values the queue can hold
+	*/
+	size_t Capacity( ) const { return mMask + 1; }
+
+private:
+	struct Cell
+	{
+		AXAtomic< size_t > mSequence;
+		T mValue;
+
+		Cell( ) : mSequence( 0 ) { }
+		Cell( Cell&& other ) : mSequence( other.mSequence.load( ) ), mValue( std::move( other.mValue ) ) { }
+	};
+
+private:
+	std::vector< Cell > mCells;
+	size_t mMask = 0;
+
+	alignas( AXCACHE_LINE_SIZE ) AXAtomic< size_t > mEnqueuePos = 0;
+	alignas( AXCACHE_LINE_SIZE ) size_t mDequeuePos = 0;
+};
\ No newline at end of file
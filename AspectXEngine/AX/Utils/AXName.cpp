@@ -0,0 +1,120 @@
+// Copyright 2016 Scott Bevin, All Rights Reserved
+
+#include "AXName.h"
+#include "AXThreadingPrimitives.h"
+
+#include <unordered_set>
+
+namespace
+{
+	/**
+	* The global intern table. Nodes of an unordered_set never move, so names can point directly at the stored strings
+	*/
+	struct NameTable
+	{
+		std::unordered_set< AXString > mStrings;
+		AXAtomic< bool > mLocked = false;
+
+		void Lock( )
+		{
+			bool expected( false );
+
+			do
+			{
+				expected = false;
+			} while( !mLocked.compare_exchange_weak( expected, true ) );
+		}
+
+		void Unlock( )
+		{
+			mLocked = false;
+		}
+	};
+
+	/**
+	* Constructed on first use so names can safely be used in static initialisers
+	*/
+	NameTable& GetNameTable( )
+	{
+		static NameTable table;
+		return table;
+	}
+
+	const AXString* Intern( const AXString& str )
+	{
+		if( str.empty( ) )
+		{
+			return nullptr;
+		}
+
+		NameTable& table( GetNameTable( ) );
+
+		table.Lock( );
+		const AXString* interned( &*table.mStrings.insert( str ).first );
+		table.Unlock( );
+
+		return interned;
+	}
+}
+
+/**
+* Constructs a name, interning the string if this is the first time it has been seen
+*/
+AXName::AXName( const char* str )
+	: mString( str ? Intern( AXString( str ) ) : nullptr )
+{
+
+}
+
+/**
+* Constructs a name, interning the string if this is the first time it has been seen
+*/
+AXName::AXName( const AXString& str )
+	: mString( Intern( str ) )
+{
+
+}
+
+/**
+* Returns the name for a string if it has already been interned, otherwise returns the none name. Never grows the table
+*/
+AXName AXName::Find( const char* str )
+{
+	AXName ret;
+
+	if( str && *str )
+	{
+		NameTable& table( GetNameTable( ) );
+		const AXString key( str );
+
+		table.Lock( );
+		auto it( table.mStrings.find( key ) );
+		ret.mString = it != table.mStrings.end( ) ? &*it : nullptr;
+		table.Unlock( );
+	}
+
+	return ret;
+}
+
+/**
+* Returns the interned string, valid for the lifetime of the application
+*/
+const AXString& AXName::GetString( ) const
+{
+	static const AXString noneString;
+	return mString ? *mString : noneString;
+}
+
+/**
+* Returns the number of distinct strings interned so far
+*/
+size_t AXName::NumInterned( )
+{
+	NameTable& table( GetNameTable( ) );
+
+	table.Lock( );
+	const size_t numInterned( table.mStrings.size( ) );
+	table.Unlock( );
+
+	return numInterned;
+}
\ No newline at end of file
@@ -0,0 +1,88 @@
+// Copyright 2016 Scott Bevin, All Rights Reserved
+
+#pragma once
+
+#include "AXString.h"
+
+#include <functional>
+#include <stddef.h>
+
+/**
+ * An interned, immutable string used for names and keys. Every distinct string is stored once in a global table so
+ * copying, comparing and hashing a name is a single pointer operation. Constructing a name from a string takes a lock
+ * and a hash lookup, so names used on hot paths should be constructed once and kept, e.g. as a static. Interned strings
+ * are never freed, so names should not be built from unbounded runtime data, use Find to look those up instead
+ */
+class AXName
+{
+public:
+	/**
+	 * Constructs the none name, which is empty
+	 */
+	AXName( ) = default;
+
+	/**
+	 * Constructs a name, interning the string if this is the first time it has been seen
+	 */
+	AXName( const char* str );
+
+	/**
+	 * Constructs a name, interning the string if this is the first time it has been seen
+	 */
+	AXName( const AXString& str );
+
+	/**
+	 * Returns the name for a string if it has already been interned, otherwise returns the none name. Never grows the table
+	 */
+	static AXName Find( const char* str );
+
+	/**
+	 * Returns the name for a string if it has already been interned, otherwise returns the none name. Never grows the table
+	 */
+	static AXName Find( const AXString& str ) { return Find( str.c_str( ) ); }
+
+	/**
+	 * Returns the interned string, valid for the lifetime of the application
+	 */
+	const char* c_str( ) const { return mString ? mString->c_str( ) : ""; }
+
+	/**
+	 * Returns the interned string, valid for the lifetime of the application
+	 */
+	const AXString& GetString( ) const;
+
+	/**
+	 * Returns true if this is the none name
+	 */
+	bool IsNone( ) const { return mString == nullptr; }
+
+	/**
+	 * Returns a hash of the name, stable for the lifetime of the application but not between runs
+	 */
+	size_t Hash( ) const { return std::hash< const void* >( )( mString ); }
+
+	/**
+	 * Returns the number of distinct strings interned so far
+	 */
+	static size_t NumInterned( );
+
+	explicit operator bool( ) const { return mString != nullptr; }
+
+	bool operator == ( const AXName& other ) const { return mString == other.mString; }
+	bool operator != ( const AXName& other ) const { return mString != other.mString; }
+
+private:
+	/**
+	 * Points at the string in the intern table, nullptr for the none name
+	 */
+	const AXString* mString = nullptr;
+};
+
+namespace std
+{
+	template<>
+	struct hash< AXName >
+	{
+		size_t operator()( const AXName& name ) const { return name.Hash( ); }
+	};
+}
\ No newline at end of file
@@ -3,6 +3,7 @@
 #pragma once
 
 #include <list>
+#include <type_traits>
 #include <vector>
 #include "AXJSON.h"
 #include "AX/Graphics/UI/ImGui/AXImGui.h"
@@ -45,6 +46,12 @@ public:
 public:
 	AXProperty( const BaseType& val ) : mVal( val ) { }
 
+	/**
+	 * Allows properties to be initialised from anything convertible to T, such as a string literal for an AXString
+	 */
+	template< class U, class = typename std::enable_if< std::is_convertible< const U&, T >::value >::type >
+	AXProperty( const U& val ) : mVal( val ) { }
+
 	const BaseType& Val( ) const { return mVal; }
 	BaseType& Val( ) { return mVal; }
 
@@ -10,13 +10,19 @@
 #include "AX/Utils/AXVector.h"
 #include "AX/Core/AXLogging.h"
 
+#include <new>
+#include <limits>
+#include <utility>
+#include <type_traits>
+
 using AXResourcePoolHandle = AXHandle;
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 /**
- * An allocator that supports a fixed size resource pool, size specified when the pool is created
+ * An allocator that supports a fixed size resource pool, size specified when the pool is created. Objects are constructed
+ * in place when allocated and destroyed when released, the same as the other storage types
  */
 template< class TResourceType, class THandleType >
 class AXResourcePool_StorageType_FixedSize
@@ -29,10 +35,45 @@ public:
 private:
 	struct ResourceItemMeta
 	{
-		THandleType mCurrentlyValidHandle = THandleType::Invalid;
+		typename THandleType::GenerationType mGeneration = THandleType::FirstGeneration;
 		std::atomic< bool > mInUse = false;
 	};
 
+	using ItemStorage = typename std::aligned_storage< sizeof( TResourceType ), alignof( TResourceType ) >::type;
+
+public:
+	/**
+	 * Iterates over the live objects within the pool, skipping free slots
+	 */
+	class Iterator
+	{
+	public:
+		Iterator( AXResourcePool_StorageType_FixedSize& storage, size_t idx ) : mStorage( storage ), mIdx( idx ) { SkipFreeSlots( ); }
+
+		ResourceType& operator * ( ) const { return mStorage.Item( mIdx ); }
+		ResourceType* operator -> ( ) const { return &( **this ); }
+
+		Iterator& operator ++ ( ) { ++mIdx; SkipFreeSlots( ); return *this; }
+
+		bool operator == ( const Iterator& rhs ) const { return mIdx == rhs.mIdx; }
+		bool operator != ( const Iterator& rhs ) const { return mIdx != rhs.mIdx; }
+
+	private:
+		void SkipFreeSlots( )
+		{
+			while( mIdx < mStorage.mMetas.size( ) && !mStorage.mMetas[mIdx].mInUse )
+			{
+				++mIdx;
+			}
+		}
+
+	private:
+		AXResourcePool_StorageType_FixedSize& mStorage;
+		size_t mIdx;
+	};
+
+	friend class Iterator;
+
 public:
 	AXResourcePool_StorageType_FixedSize( const SizeType& size )
 		: mItems( size )
@@ -41,31 +82,41 @@ public:
 		AXASSERT( size < THandleType::MaxId, "Handle type does not provide support for %d number of items", size );
 	}
 
+	~AXResourcePool_StorageType_FixedSize( )
+	{
+		for( size_t i( 0 ); i < mMetas.size( ); ++i )
+		{
+			if( mMetas[i].mInUse )
+			{
+				Item( i ).~ResourceType( );
+			}
+		}
+	}
+
 	/**
 	* Allocates an object within the pool if possible, returns a handle to the allocated object if one was allocated.
 	* If allocatedObject is not nullptr will fill it in pointing to the object allocated
 	*/
 	Handle Allocate( ResourceType** allocatedObject = nullptr )
 	{ 
-		for( SizeType i( 0 ); i < mItems.size(); ++i )
+		for( SizeType i( 0 ); i < mMetas.size(); ++i )
 		{
-			ResourceType& item( mItems[i] );
 			ResourceItemMeta& meta( mMetas[i] );
 
 			bool expectedInUseFlag = false;
 			if( meta.mInUse.compare_exchange_strong( expectedInUseFlag, true ) )
 			{
-				meta.mCurrentlyValidHandle = Handle::Create( i );
+				ResourceType* item( new( &mItems[i] ) ResourceType( ) );
 
 				if( allocatedObject )
 				{
-					( *allocatedObject ) = &item;
+					( *allocatedObject ) = item;
 				}
 
 				AXASSERT( mNumInUse < Capacity( ), "Something has gone wrong inside a resource pool..." );
 				++mNumInUse;
 
-				return meta.mCurrentlyValidHandle;
+				return Handle::Create( i, meta.mGeneration );
 			}
 		}
 
@@ -79,17 +130,21 @@ public:
 	*/
 	void Release( Handle& hndl )
 	{ 
-		ResourceType& item( mItems[hndl.Id( )] );
-		ResourceItemMeta& meta( mMetas[hndl.Id( )] );
-
-		bool expectedInUseFlag = true;
-		if( meta.mCurrentlyValidHandle == hndl && meta.mInUse.compare_exchange_strong( expectedInUseFlag, false ) )
+		if( hndl.Id( ) < mMetas.size( ) )
 		{
-			meta.mCurrentlyValidHandle = Handle::Invalid;
-			item.~ResourceType( );
+			ResourceItemMeta& meta( mMetas[hndl.Id( )] );
+
+			if( meta.mInUse && meta.mGeneration == hndl.Generation( ) )
+			{
+				// The slot is only marked free once the item is destroyed, so it can't be handed out again mid destruction
+				meta.mGeneration = Handle::NextGeneration( meta.mGeneration );
+				Item( hndl.Id( ) ).~ResourceType( );
 
-			AXASSERT( mNumInUse > 0, "Something has gone wrong inside a resource pool..." );
-			--mNumInUse;
+				AXASSERT( mNumInUse > 0, "Something has gone wrong inside a resource pool..." );
+				--mNumInUse;
+
+				meta.mInUse = false;
+			}
 		}
 
 		hndl = Handle::Invalid;
@@ -100,15 +155,7 @@ public:
 	*/
 	const ResourceType* TryGet( const Handle& hndl ) const
 	{ 
-		ResourceType& item( mItems[hndl.Id( )] );
-		ResourceItemMeta& meta( mMetas[hndl.Id( )] );
-
-		if( meta.mInUse && meta.mCurrentlyValidHandle == hndl )
-		{
-			return &item;
-		}
-
-		return nullptr;
+		return const_cast< AXResourcePool_StorageType_FixedSize* >( this )->TryGet( hndl );
 	}
 
 	/**
@@ -116,12 +163,14 @@ public:
 	*/
 	ResourceType* TryGet( const Handle& hndl )
 	{ 
-		ResourceType& item( mItems[hndl.Id( )] );
-		ResourceItemMeta& meta( mMetas[hndl.Id( )] );
-
-		if( meta.mInUse && meta.mCurrentlyValidHandle == hndl )
+		if( hndl.Id( ) < mMetas.size( ) )
 		{
-			return &item;
+			const ResourceItemMeta& meta( mMetas[hndl.Id( )] );
+
+			if( meta.mInUse && meta.mGeneration == hndl.Generation( ) )
+			{
+				return &Item( hndl.Id( ) );
+			}
 		}
 
 		return nullptr;
@@ -132,7 +181,7 @@ public:
 	*/
 	SizeType Capacity( ) const 
 	{ 
-		return static_cast< SizeType >( mItems.size( ) );
+		return static_cast< SizeType >( mMetas.size( ) );
 	}
 
 	/**
@@ -144,19 +193,22 @@ public:
 	}
 
 	/**
-	* Returns a reference to the begin element of the internal storage items so they can all be iterated over
+	* Returns an iterator to the first live object so they can all be iterated over
 	*/
-	auto begin( ) { return mItems.begin( ); }
+	Iterator begin( ) { return Iterator( *this, 0 ); }
 
 	/**
-	* Returns a reference to the begin element of the internal storage of items so they can all be iterated over
+	* Returns an iterator past the last slot of the pool
 	*/
-	auto end( ) { return mItems.end( ); }
+	Iterator end( ) { return Iterator( *this, mMetas.size( ) ); }
 
 private:
-	AXVector< TResourceType > mItems;
+	ResourceType& Item( size_t idx ) { return *reinterpret_cast< ResourceType* >( &mItems[idx] ); }
+
+private:
+	AXVector< ItemStorage > mItems;
 	AXVector< ResourceItemMeta > mMetas; 
-	AXAtomic< typename SizeType > mNumInUse = 0;
+	AXAtomic< SizeType > mNumInUse = 0;
 };
 
 /**
@@ -167,88 +219,1142 @@ class AXResourcePool_StorageType_StaticFixedSize : public AXResourcePool_Storage
 {
 public:
 	static_assert( TSize < THandleType::MaxId, "Handle type does not provide support for TSize number of items" );
-	static const SizeType Size = TSize;
+	static const typename THandleType::IdType Size = TSize;
 
-	AXResourcePool_StorageType_StaticFixedSize() : AXResourcePool_StorageType_FixedSize( Size ) { }
+	AXResourcePool_StorageType_StaticFixedSize() : AXResourcePool_StorageType_FixedSize< TResourceType, THandleType >( Size ) { }
 };
 
-////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-
-template< class TResourceType, class THandleType, class TResourcePoolStorageType >
-class AXResourcePool : public AXParent< AXBaseObject, AXResourcePool< TResourceType, THandleType, TResourcePoolStorageType > >
+/**
+ * An allocator that grows in fixed size pages on demand, up to a maximum size specified when the pool is created.
+ * Objects are constructed in place and never move once allocated, so pointers remain valid until the handle is released.
+ * Pages that become empty can be handed back to the OS with ReleaseEmptyPages( )
+ */
+template< class TResourceType, class THandleType, uint32_t TPageSize >
+class AXResourcePool_StorageType_Paged
 {
 public:
 	using ResourceType = TResourceType;
-	using ResourcePoolStorageType = TResourcePoolStorageType;
 	using Handle = THandleType;
+	typedef typename Handle::IdType SizeType;
 
-	typedef typename TResourcePoolStorageType::SizeType SizeType;
+	static const uint32_t PageSize = TPageSize;
 
-public:
-	template< typename ... Args >
-	AXResourcePool( Args... args ) : mStorage( args ... ) { }
+	static_assert( TPageSize > 0, "Page size must be greater than 0" );
+
+private:
+	struct ResourceItemMeta
+	{
+		std::atomic< bool > mInUse = false;
+	};
 
 	/**
-	 * Allocates an object within the pool if possible, returns a handle to the allocated object if one was allocated.
-	 * If allocatedObject is not nullptr will fill it in pointing to the object allocated
+	 * The generation of every slot in a page slot. Kept apart from the page so generations carry on counting when an
+	 * empty page is released and recommitted, and handles from before the release stay invalid
 	 */
-	Handle Allocate( ResourceType** allocatedObject = nullptr ) { return mStorage.Allocate( allocatedObject ); }
+	struct PageGenerations
+	{
+		PageGenerations( )
+		{
+			for( typename THandleType::GenerationType& generation : mGenerations )
+			{
+				generation = THandleType::FirstGeneration;
+			}
+		}
+
+		typename THandleType::GenerationType mGenerations[TPageSize];
+	};
+
+	struct Page
+	{
+		typename std::aligned_storage< sizeof( TResourceType ), alignof( TResourceType ) >::type mItems[TPageSize];
+		ResourceItemMeta mMetas[TPageSize];
+		AXAtomic< uint32_t > mNumInUse = 0;
+
+		ResourceType& Item( uint32_t idx ) { return *reinterpret_cast< ResourceType* >( &mItems[idx] ); }
+	};
 
+public:
 	/**
-	 * Released the object pointed to by the handle, if the handle is valid
+	 * Iterates over the live objects within the pool, skipping free slots and uncommitted pages
 	 */
-	void Release( Handle& hndl ) { mStorage.Release( hndl ); }
+	class Iterator
+	{
+	public:
+		Iterator( AXResourcePool_StorageType_Paged& storage, size_t idx ) : mStorage( storage ), mIdx( idx ) { SkipFreeSlots( ); }
+
+		ResourceType& operator * ( ) const { return mStorage.mPages[mIdx / TPageSize].load( )->Item( mIdx % TPageSize ); }
+		ResourceType* operator -> ( ) const { return &( **this ); }
+
+		Iterator& operator ++ ( ) { ++mIdx; SkipFreeSlots( ); return *this; }
+
+		bool operator == ( const Iterator& rhs ) const { return mIdx == rhs.mIdx; }
+		bool operator != ( const Iterator& rhs ) const { return mIdx != rhs.mIdx; }
+
+	private:
+		void SkipFreeSlots( )
+		{
+			const size_t endIdx( mStorage.mNumPageSlotsUsed * TPageSize );
+
+			while( mIdx < endIdx )
+			{
+				Page* page( mStorage.mPages[mIdx / TPageSize].load( ) );
+
+				if( !page )
+				{
+					mIdx = ( ( mIdx / TPageSize ) + 1 ) * TPageSize;
+				}
+				else if( page->mMetas[mIdx % TPageSize].mInUse )
+				{
+					return;
+				}
+				else
+				{
+					++mIdx;
+				}
+			}
+
+			mIdx = endIdx;
+		}
+
+	private:
+		AXResourcePool_StorageType_Paged& mStorage;
+		size_t mIdx;
+	};
+
+	friend class Iterator;
+
+public:
+	AXResourcePool_StorageType_Paged( const SizeType& maxSize )
+		: mPages( ( static_cast< size_t >( maxSize ) + TPageSize - 1 ) / TPageSize )
+		, mGenerations( mPages.size( ) )
+	{
+		AXASSERT( maxSize < THandleType::MaxId, "Handle type does not provide support for %d number of items", maxSize );
+	}
+
+	~AXResourcePool_StorageType_Paged( )
+	{
+		for( AXAtomic< Page* >& pageSlot : mPages )
+		{
+			if( Page* page = pageSlot.load( ) )
+			{
+				for( uint32_t i( 0 ); i < TPageSize; ++i )
+				{
+					if( page->mMetas[i].mInUse )
+					{
+						page->Item( i ).~ResourceType( );
+					}
+				}
+
+				delete page;
+				pageSlot = nullptr;
+			}
+		}
+	}
 
 	/**
-	 * Attempts to get a resource from the given handle, returns it if possible, otherwise returns nullptr
-	 */
-	const ResourceType* TryGet( const Handle& hndl ) const { return mStorage.TryGet( hndl ); }
+	* Allocates an object within the pool if possible, committing a new page if all existing pages are full. Returns a
+	* handle to the allocated object if one was allocated. If allocatedObject is not nullptr will fill it in pointing to the object allocated
+	*/
+	Handle Allocate( ResourceType** allocatedObject = nullptr )
+	{
+		uint32_t numPagesSeen( 0 );
+
+		do
+		{
+			numPagesSeen = mNumPagesCommitted;
+
+			for( size_t pageIdx( 0 ); pageIdx < mNumPageSlotsUsed; ++pageIdx )
+			{
+				Page* page( mPages[pageIdx].load( ) );
+
+				if( !page || page->mNumInUse == TPageSize )
+				{
+					continue;
+				}
+
+				for( uint32_t i( 0 ); i < TPageSize; ++i )
+				{
+					ResourceItemMeta& meta( page->mMetas[i] );
+
+					bool expectedInUseFlag = false;
+					if( meta.mInUse.compare_exchange_strong( expectedInUseFlag, true ) )
+					{
+						ResourceType* item( new( &page->mItems[i] ) ResourceType( ) );
+
+						if( allocatedObject )
+						{
+							( *allocatedObject ) = item;
+						}
+
+						++page->mNumInUse;
+						++mNumInUse;
+
+						return Handle::Create( static_cast< SizeType >( ( pageIdx * TPageSize ) + i ), mGenerations[pageIdx].mGenerations[i] );
+					}
+				}
+			}
+
+		} while( CommitPage( numPagesSeen ) );
+
+		AXWARN( "Resource Pool", "Unable to allocate inside paged resource pool, all %u pages are in use", ( uint32_t )mPages.size( ) );
+
+		return Handle::Invalid;
+	}
 
 	/**
-	* Attempts to get a resource from the given handle, returns it if possible, otherwise returns nullptr
+	* Released the object pointed to by the handle, if the handle is valid
 	*/
-	ResourceType* TryGet( const Handle& hndl ) { return mStorage.TryGet( hndl ); }
+	void Release( Handle& hndl )
+	{
+		if( Page* page = FindPage( hndl ) )
+		{
+			ResourceItemMeta& meta( page->mMetas[hndl.Id( ) % TPageSize] );
+			typename THandleType::GenerationType& generation( Generation( hndl ) );
+
+			if( meta.mInUse && generation == hndl.Generation( ) )
+			{
+				// The slot is only marked free once the item is destroyed, so it can't be handed out again mid destruction
+				generation = Handle::NextGeneration( generation );
+				page->Item( hndl.Id( ) % TPageSize ).~ResourceType( );
+
+				AXASSERT( mNumInUse > 0 && page->mNumInUse > 0, "Something has gone wrong inside a resource pool..." );
+				--page->mNumInUse;
+				--mNumInUse;
+
+				meta.mInUse = false;
+			}
+		}
+
+		hndl = Handle::Invalid;
+	}
 
 	/**
 	* Attempts to get a resource from the given handle, returns it if possible, otherwise returns nullptr
 	*/
-	const ResourceType& Get( const Handle& hndl ) const { return AXUtils::AssertPtrReturnRef( Get( hndl ) ); }
+	const ResourceType* TryGet( const Handle& hndl ) const
+	{
+		return const_cast< AXResourcePool_StorageType_Paged* >( this )->TryGet( hndl );
+	}
 
 	/**
 	* Attempts to get a resource from the given handle, returns it if possible, otherwise returns nullptr
 	*/
-	ResourceType& Get( const Handle& hndl ) { return AXUtils::AssertPtrReturnRef( Get( hndl ) ); }
+	ResourceType* TryGet( const Handle& hndl )
+	{
+		if( Page* page = FindPage( hndl ) )
+		{
+			ResourceItemMeta& meta( page->mMetas[hndl.Id( ) % TPageSize] );
+
+			if( meta.mInUse && Generation( hndl ) == hndl.Generation( ) )
+			{
+				return &page->Item( hndl.Id( ) % TPageSize );
+			}
+		}
+
+		return nullptr;
+	}
 
 	/**
-	 * Returns a reference to the begin element of the internal storage items so they can all be iterated over
-	 */
-	auto begin( ) { return mStorage.begin( ); }
+	* Frees any committed pages that contain no live objects, returns the number of pages released. Must not be called
+	* while other threads are allocating from or accessing the pool
+	*/
+	uint32_t ReleaseEmptyPages( )
+	{
+		uint32_t numReleased( 0 );
+
+		for( size_t pageIdx( 0 ); pageIdx < mNumPageSlotsUsed; ++pageIdx )
+		{
+			Page* page( mPages[pageIdx].load( ) );
+
+			if( page && page->mNumInUse == 0 )
+			{
+				mPages[pageIdx] = nullptr;
+				delete page;
+
+				--mNumPagesCommitted;
+				++numReleased;
+			}
+		}
+
+		return numReleased;
+	}
 
 	/**
-	* Returns a reference to the begin element of the internal storage of items so they can all be iterated over
+	* Returns the currently committed capacity of this resource pool, this will grow as pages are added
 	*/
-	auto end( ) { return mStorage.end( ); }
+	SizeType Capacity( ) const 
+	{ 
+		return static_cast< SizeType >( mNumPagesCommitted * TPageSize );
+	}
 
 	/**
-	 * Returns the maximum capacity of this resource pool
-	 */
-	SizeType Capacity( ) const { return mStorage.Capacity( ); }
+	* Returns the maximum capacity this resource pool can grow to
+	*/
+	SizeType MaxCapacity( ) const
+	{
+		return static_cast< SizeType >( mPages.size( ) * TPageSize );
+	}
 
 	/**
 	* Returns the currently used capacity of this resource pool
 	*/
-	SizeType Count( ) const { return mStorage.Count( ); }
+	SizeType Count( ) const 
+	{ 
+		return mNumInUse;
+	}
+
+	/**
+	* Returns an iterator to the first live object in the pool
+	*/
+	Iterator begin( ) { return Iterator( *this, 0 ); }
+
+	/**
+	* Returns an iterator to the end of the live objects in the pool
+	*/
+	Iterator end( ) { return Iterator( *this, mNumPageSlotsUsed * TPageSize ); }
 
 private:
-	ResourcePoolStorageType mStorage;
+	/**
+	* Returns the page the handle points into, if that page is committed
+	*/
+	Page* FindPage( const Handle& hndl ) const
+	{
+		const size_t pageIdx( hndl.Id( ) / TPageSize );
+
+		if( pageIdx < mPages.size( ) )
+		{
+			return mPages[pageIdx].load( );
+		}
+
+		return nullptr;
+	}
+
+	/**
+	* Returns the generation of the slot the handle points at, the handle must point into a page slot
+	*/
+	typename THandleType::GenerationType& Generation( const Handle& hndl )
+	{
+		return mGenerations[hndl.Id( ) / TPageSize].mGenerations[hndl.Id( ) % TPageSize];
+	}
+
+	/**
+	* Commits a new page into the first free page slot, returns false if the pool has reached its maximum size.
+	* numPagesSeen is the number of committed pages the caller scanned, if another thread has committed a page since
+	* then nothing is committed and the caller should retry the allocation
+	*/
+	bool CommitPage( uint32_t numPagesSeen )
+	{
+		bool expectedLockedFlag = false;
+		do { expectedLockedFlag = false; } while( !mCommitLocked.compare_exchange_weak( expectedLockedFlag, true ) );
+
+		bool committed( mNumPagesCommitted != numPagesSeen );
+
+		for( size_t pageIdx( 0 ); !committed && pageIdx < mPages.size( ); ++pageIdx )
+		{
+			if( !mPages[pageIdx].load( ) )
+			{
+				mPages[pageIdx] = new Page( );
+				++mNumPagesCommitted;
+
+				if( pageIdx >= mNumPageSlotsUsed )
+				{
+					mNumPageSlotsUsed = pageIdx + 1;
+				}
+
+				committed = true;
+			}
+		}
+
+		mCommitLocked = false;
+
+		return committed;
+	}
+
+private:
+	AXVector< AXAtomic< Page* > > mPages;
+	AXVector< PageGenerations > mGenerations;
+	AXAtomic< size_t > mNumPageSlotsUsed = 0;
+	AXAtomic< uint32_t > mNumPagesCommitted = 0;
+	AXAtomic< SizeType > mNumInUse = 0;
+	AXAtomic< bool > mCommitLocked = false;
 };
 
-////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/**
+ * An allocator with a fixed maximum size that puts a small per thread cache of free slots, a magazine, in front of a shared
+ * depot. Threads allocate from and release into their own magazine and only take the depot lock to refill or flush half a
+ * magazine at a time, so workers allocating from the same pool rarely touch a shared cache line. Slots released on another
+ * thread than the one that allocated them are cached by the releasing thread. Threads without an AXThreadIndex go straight
+ * to the depot. When the depot runs dry an allocation steals a slot from another thread's magazine, so the pool only reports
+ * it is full once every slot is in use. Threads that stop using the pool should still call FlushThreadCache( ) so their
+ * cached slots can be reused without stealing
+ */
+template< class TResourceType, class THandleType, uint32_t TMagazineSize >
+class AXResourcePool_StorageType_ThreadCached
+{
+public:
+	using ResourceType = TResourceType;
+	using Handle = THandleType;
+	typedef typename Handle::IdType SizeType;
 
-template< class TResourceType, uint64_t TSize, class THandleType = AXResourcePoolHandle >
-using AXStaticFixedSizeResourcePool = AXResourcePool< TResourceType, THandleType, AXResourcePool_StorageType_StaticFixedSize< TResourceType, THandleType, TSize > >;
+	static const uint32_t MagazineSize = TMagazineSize;
 
-template< class TResourceType, class THandleType = AXResourcePoolHandle >
-using AXFixedSizeResourcePool = AXResourcePool< TResourceType, THandleType, AXResourcePool_StorageType_FixedSize< TResourceType, THandleType > >;
\ No newline at end of file
+	static_assert( TMagazineSize >= 2, "Magazine size must be at least 2 so refills and flushes can move half a magazine" );
+
+private:
+	struct ResourceItemMeta
+	{
+		// Atomic as handles are validated from any thread while another thread may be releasing the slot
+		AXAtomic< typename THandleType::GenerationType > mGeneration = THandleType::FirstGeneration;
+		std::atomic< bool > mInUse = false;
+	};
+
+	struct alignas( AXCACHE_LINE_SIZE ) Magazine
+	{
+		SizeType mSlots[TMagazineSize];
+		uint32_t mNumSlots = 0;
+
+		/**
+		* Held by the owning thread while it uses the slots, and by other threads stealing from them. Nearly always uncontended
+		*/
+		AXAtomic< bool > mLocked = false;
+
+		/**
+		* Allocations minus releases made by the owning thread, only ever written by that thread
+		*/
+		AXAtomic< int64_t > mNumAllocated = 0;
+	};
+
+	using ItemStorage = typename std::aligned_storage< sizeof( TResourceType ), alignof( TResourceType ) >::type;
+
+public:
+	/**
+	 * Iterates over the live objects within the pool, skipping free slots
+	 */
+	class Iterator
+	{
+	public:
+		Iterator( AXResourcePool_StorageType_ThreadCached& storage, size_t idx ) : mStorage( storage ), mIdx( idx ) { SkipFreeSlots( ); }
+
+		ResourceType& operator * ( ) const { return mStorage.Item( mIdx ); }
+		ResourceType* operator -> ( ) const { return &( **this ); }
+
+		Iterator& operator ++ ( ) { ++mIdx; SkipFreeSlots( ); return *this; }
+
+		bool operator == ( const Iterator& rhs ) const { return mIdx == rhs.mIdx; }
+		bool operator != ( const Iterator& rhs ) const { return mIdx != rhs.mIdx; }
+
+	private:
+		void SkipFreeSlots( )
+		{
+			while( mIdx < mStorage.mMetas.size( ) && !mStorage.mMetas[mIdx].mInUse )
+			{
+				++mIdx;
+			}
+		}
+
+	private:
+		AXResourcePool_StorageType_ThreadCached& mStorage;
+		size_t mIdx;
+	};
+
+	friend class Iterator;
+
+public:
+	AXResourcePool_StorageType_ThreadCached( const SizeType& size )
+		: mItems( size )
+		, mMetas( size )
+		, mDepot( size )
+	{
+		AXASSERT( size < THandleType::MaxId, "Handle type does not provide support for %d number of items", size );
+
+		// Fill the depot so the lowest ids are handed out first
+		for( SizeType i( 0 ); i < size; ++i )
+		{
+			mDepot[i] = static_cast< SizeType >( size - 1 - i );
+		}
+
+		mNumInDepot = size;
+	}
+
+	~AXResourcePool_StorageType_ThreadCached( )
+	{
+		for( size_t i( 0 ); i < mMetas.size( ); ++i )
+		{
+			if( mMetas[i].mInUse )
+			{
+				Item( i ).~ResourceType( );
+			}
+		}
+	}
+
+	/**
+	* Allocates an object within the pool if possible, returns a handle to the allocated object if one was allocated.
+	* If allocatedObject is not nullptr will fill it in pointing to the object allocated
+	*/
+	Handle Allocate( ResourceType** allocatedObject = nullptr )
+	{
+		const uint32_t threadIdx( AXThreadIndex::Current( ) );
+		SizeType slotIdx( 0 );
+
+		bool gotSlot( false );
+
+		if( threadIdx != AXThreadIndex::InvalidIndex )
+		{
+			Magazine& magazine( mMagazines[threadIdx] );
+
+			Lock( magazine.mLocked );
+
+			if( magazine.mNumSlots == 0 )
+			{
+				Refill( magazine );
+			}
+
+			if( magazine.mNumSlots > 0 )
+			{
+				slotIdx = magazine.mSlots[--magazine.mNumSlots];
+				gotSlot = true;
+			}
+
+			Unlock( magazine.mLocked );
+		}
+		else
+		{
+			gotSlot = PopFromDepot( slotIdx );
+		}
+
+		if( !gotSlot )
+		{
+			gotSlot = Steal( slotIdx );
+		}
+
+		if( !gotSlot )
+		{
+			AXWARN( "Resource Pool", "Unable to allocate inside thread cached resource pool" );
+			return Handle::Invalid;
+		}
+
+		if( threadIdx != AXThreadIndex::InvalidIndex )
+		{
+			Magazine& magazine( mMagazines[threadIdx] );
+			magazine.mNumAllocated.store( magazine.mNumAllocated.load( std::memory_order_relaxed ) + 1, std::memory_order_relaxed );
+		}
+		else
+		{
+			++mNumAllocatedWithoutMagazine;
+		}
+
+		ResourceItemMeta& meta( mMetas[slotIdx] );
+		AXASSERT( !meta.mInUse, "Something has gone wrong inside a resource pool..." );
+
+		ResourceType* item( new( &mItems[slotIdx] ) ResourceType( ) );
+		meta.mInUse = true;
+
+		if( allocatedObject )
+		{
+			( *allocatedObject ) = item;
+		}
+
+		return Handle::Create( slotIdx, meta.mGeneration );
+	}
+
+	/**
+	* Released the object pointed to by the handle, if the handle is valid
+	*/
+	void Release( Handle& hndl )
+	{
+		if( hndl.Id( ) < mMetas.size( ) )
+		{
+			ResourceItemMeta& meta( mMetas[hndl.Id( )] );
+
+			bool expectedInUseFlag = true;
+			if( meta.mGeneration == hndl.Generation( ) && meta.mInUse.compare_exchange_strong( expectedInUseFlag, false ) )
+			{
+				meta.mGeneration = Handle::NextGeneration( meta.mGeneration );
+				Item( hndl.Id( ) ).~ResourceType( );
+
+				const uint32_t threadIdx( AXThreadIndex::Current( ) );
+
+				if( threadIdx != AXThreadIndex::InvalidIndex )
+				{
+					Magazine& magazine( mMagazines[threadIdx] );
+
+					Lock( magazine.mLocked );
+
+					if( magazine.mNumSlots == TMagazineSize )
+					{
+						Flush( magazine, TMagazineSize / 2 );
+					}
+
+					magazine.mSlots[magazine.mNumSlots++] = hndl.Id( );
+
+					Unlock( magazine.mLocked );
+
+					magazine.mNumAllocated.store( magazine.mNumAllocated.load( std::memory_order_relaxed ) - 1, std::memory_order_relaxed );
+				}
+				else
+				{
+					PushToDepot( hndl.Id( ) );
+				}
+			}
+		}
+
+		hndl = Handle::Invalid;
+	}
+
+	/**
+	* Attempts to get a resource from the given handle, returns it if possible, otherwise returns nullptr
+	*/
+	const ResourceType* TryGet( const Handle& hndl ) const
+	{
+		return const_cast< AXResourcePool_StorageType_ThreadCached* >( this )->TryGet( hndl );
+	}
+
+	/**
+	* Attempts to get a resource from the given handle, returns it if possible, otherwise returns nullptr
+	*/
+	ResourceType* TryGet( const Handle& hndl )
+	{
+		if( hndl.Id( ) < mMetas.size( ) )
+		{
+			ResourceItemMeta& meta( mMetas[hndl.Id( )] );
+
+			if( meta.mInUse && meta.mGeneration == hndl.Generation( ) )
+			{
+				return &Item( hndl.Id( ) );
+			}
+		}
+
+		return nullptr;
+	}
+
+	/**
+	* Returns every slot cached by the calling thread to the shared depot
+	*/
+	void FlushThreadCache( )
+	{
+		const uint32_t threadIdx( AXThreadIndex::Current( ) );
+
+		if( threadIdx != AXThreadIndex::InvalidIndex )
+		{
+			Magazine& magazine( mMagazines[threadIdx] );
+
+			Lock( magazine.mLocked );
+			Flush( magazine, magazine.mNumSlots );
+			Unlock( magazine.mLocked );
+		}
+	}
+
+	/**
+	* Returns the maximum capacity of this resource pool
+	*/
+	SizeType Capacity( ) const 
+	{ 
+		return static_cast< SizeType >( mItems.size( ) );
+	}
+
+	/**
+	* Returns the currently used capacity of this resource pool, summed over the per thread counts so only exact while no
+	* other thread is allocating or releasing
+	*/
+	SizeType Count( ) const 
+	{ 
+		int64_t numInUse( mNumAllocatedWithoutMagazine );
+
+		for( const Magazine& magazine : mMagazines )
+		{
+			numInUse += magazine.mNumAllocated.load( std::memory_order_relaxed );
+		}
+
+		return static_cast< SizeType >( numInUse );
+	}
+
+	/**
+	* Returns an iterator to the first live object in the pool
+	*/
+	Iterator begin( ) { return Iterator( *this, 0 ); }
+
+	/**
+	* Returns an iterator to the end of the live objects in the pool
+	*/
+	Iterator end( ) { return Iterator( *this, mMetas.size( ) ); }
+
+private:
+	ResourceType& Item( size_t idx ) { return *reinterpret_cast< ResourceType* >( &mItems[idx] ); }
+
+	static void Lock( AXAtomic< bool >& locked )
+	{
+		bool expectedLockedFlag = false;
+		do { expectedLockedFlag = false; } while( !locked.compare_exchange_weak( expectedLockedFlag, true ) );
+	}
+
+	static void Unlock( AXAtomic< bool >& locked )
+	{
+		locked = false;
+	}
+
+	void LockDepot( )
+	{
+		Lock( mDepotLocked );
+	}
+
+	void UnlockDepot( )
+	{
+		Unlock( mDepotLocked );
+	}
+
+	/**
+	* Takes a free slot out of another thread's magazine, returns false if every magazine is empty. Only one magazine is
+	* locked at a time, and the caller must not hold its own, so two threads stealing from each other can't deadlock
+	*/
+	bool Steal( SizeType& slotIdx )
+	{
+		const uint32_t numAssigned( AXThreadIndex::NumAssigned( ) );
+		const uint32_t numMagazines( numAssigned < AXThreadIndex::MaxThreads ? numAssigned : AXThreadIndex::MaxThreads );
+
+		for( uint32_t i( 0 ); i < numMagazines; ++i )
+		{
+			Magazine& magazine( mMagazines[i] );
+
+			Lock( magazine.mLocked );
+
+			const bool gotSlot( magazine.mNumSlots > 0 );
+
+			if( gotSlot )
+			{
+				slotIdx = magazine.mSlots[--magazine.mNumSlots];
+			}
+
+			Unlock( magazine.mLocked );
+
+			if( gotSlot )
+			{
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	/**
+	* Moves up to half a magazine of free slots out of the depot, the magazine must be locked
+	*/
+	void Refill( Magazine& magazine )
+	{
+		LockDepot( );
+
+		while( mNumInDepot > 0 && magazine.mNumSlots < TMagazineSize / 2 )
+		{
+			magazine.mSlots[magazine.mNumSlots++] = mDepot[--mNumInDepot];
+		}
+
+		UnlockDepot( );
+	}
+
+	/**
+	* Moves the given number of free slots from the top of the magazine back into the depot, the magazine must be locked
+	*/
+	void Flush( Magazine& magazine, uint32_t numSlots )
+	{
+		LockDepot( );
+
+		while( numSlots-- > 0 && magazine.mNumSlots > 0 )
+		{
+			mDepot[mNumInDepot++] = magazine.mSlots[--magazine.mNumSlots];
+		}
+
+		UnlockDepot( );
+	}
+
+	bool PopFromDepot( SizeType& slotIdx )
+	{
+		LockDepot( );
+
+		const bool gotSlot( mNumInDepot > 0 );
+
+		if( gotSlot )
+		{
+			slotIdx = mDepot[--mNumInDepot];
+		}
+
+		UnlockDepot( );
+
+		return gotSlot;
+	}
+
+	void PushToDepot( const SizeType& slotIdx )
+	{
+		LockDepot( );
+
+		mDepot[mNumInDepot++] = slotIdx;
+		--mNumAllocatedWithoutMagazine;
+
+		UnlockDepot( );
+	}
+
+private:
+	AXVector< ItemStorage > mItems;
+	AXVector< ResourceItemMeta > mMetas;
+	Magazine mMagazines[AXThreadIndex::MaxThreads];
+
+	AXVector< SizeType > mDepot;
+	size_t mNumInDepot = 0;
+	AXAtomic< int64_t > mNumAllocatedWithoutMagazine = 0;
+	AXAtomic< bool > mDepotLocked = false;
+};
+
+/**
+ * Maps handles onto a densely packed range of indices, the bookkeeping behind a sparse set. Each sparse slot stores its
+ * generation and the dense index of the object it owns, removal swaps the last dense entry into the hole so live entries
+ * always occupy [0, Count( )). Not thread safe, access must be externally synchronised
+ */
+template< class THandleType >
+class AXResourcePool_DenseIndex
+{
+public:
+	using Handle = THandleType;
+	typedef typename Handle::IdType SizeType;
+	typedef typename Handle::GenerationType GenerationType;
+
+	static const SizeType InvalidIndex = std::numeric_limits< SizeType >::max( );
+
+private:
+	struct SparseSlot
+	{
+		GenerationType mGeneration = THandleType::FirstGeneration;
+		SizeType mDenseIdx = InvalidIndex;
+	};
+
+public:
+	AXResourcePool_DenseIndex( const SizeType& maxSize )
+		: mMaxSize( maxSize )
+	{
+		AXASSERT( maxSize < THandleType::MaxId, "Handle type does not provide support for %d number of items", maxSize );
+
+		mSparse.reserve( maxSize );
+		mFreeSparseSlots.reserve( maxSize );
+		mDenseToSparse.reserve( maxSize );
+	}
+
+	/**
+	* Adds a new entry at the end of the dense range, returns its handle or Invalid if the index is full
+	*/
+	Handle Add( )
+	{
+		SizeType sparseIdx( InvalidIndex );
+
+		if( !mFreeSparseSlots.empty( ) )
+		{
+			sparseIdx = mFreeSparseSlots.back( );
+			mFreeSparseSlots.pop_back( );
+		}
+		else if( mSparse.size( ) < mMaxSize )
+		{
+			sparseIdx = static_cast< SizeType >( mSparse.size( ) );
+			mSparse.emplace_back( );
+		}
+		else
+		{
+			return Handle::Invalid;
+		}
+
+		SparseSlot& slot( mSparse[sparseIdx] );
+		slot.mDenseIdx = static_cast< SizeType >( mDenseToSparse.size( ) );
+		mDenseToSparse.push_back( sparseIdx );
+
+		return Handle::Create( sparseIdx, slot.mGeneration );
+	}
+
+	/**
+	* Removes the entry for the handle if it is valid, returns false otherwise. On success removedIdx is the dense index that was
+	* freed and movedFromIdx the dense index of the last entry, which now lives at removedIdx. The caller is expected to move
+	* its own data the same way and then drop the last element
+	*/
+	bool Remove( const Handle& hndl, SizeType& removedIdx, SizeType& movedFromIdx )
+	{
+		const SizeType denseIdx( Find( hndl ) );
+
+		if( denseIdx == InvalidIndex )
+		{
+			return false;
+		}
+
+		const SizeType lastIdx( static_cast< SizeType >( mDenseToSparse.size( ) - 1 ) );
+		const SizeType lastSparseIdx( mDenseToSparse[lastIdx] );
+
+		mDenseToSparse[denseIdx] = lastSparseIdx;
+		mSparse[lastSparseIdx].mDenseIdx = denseIdx;
+		mDenseToSparse.pop_back( );
+
+		SparseSlot& slot( mSparse[hndl.Id( )] );
+		slot.mDenseIdx = InvalidIndex;
+		slot.mGeneration = Handle::NextGeneration( slot.mGeneration );
+		mFreeSparseSlots.push_back( hndl.Id( ) );
+
+		removedIdx = denseIdx;
+		movedFromIdx = lastIdx;
+
+		return true;
+	}
+
+	/**
+	* Returns the dense index of the entry the handle refers to, or InvalidIndex if the handle is stale
+	*/
+	SizeType Find( const Handle& hndl ) const
+	{
+		if( hndl.Id( ) < mSparse.size( ) )
+		{
+			const SparseSlot& slot( mSparse[hndl.Id( )] );
+
+			if( slot.mDenseIdx != InvalidIndex && slot.mGeneration == hndl.Generation( ) )
+			{
+				return slot.mDenseIdx;
+			}
+		}
+
+		return InvalidIndex;
+	}
+
+	/**
+	* Returns the handle of the entry at the given dense index
+	*/
+	Handle HandleAt( const SizeType& denseIdx ) const
+	{
+		const SizeType sparseIdx( mDenseToSparse[denseIdx] );
+		return Handle::Create( sparseIdx, mSparse[sparseIdx].mGeneration );
+	}
+
+	/**
+	* Returns the maximum number of entries this index can hold
+	*/
+	SizeType MaxCapacity( ) const { return mMaxSize; }
+
+	/**
+	* Returns the number of live entries
+	*/
+	SizeType Count( ) const { return static_cast< SizeType >( mDenseToSparse.size( ) ); }
+
+private:
+	SizeType mMaxSize;
+	AXVector< SparseSlot > mSparse;
+	AXVector< SizeType > mFreeSparseSlots;
+	AXVector< SizeType > mDenseToSparse;
+};
+
+/**
+ * An allocator that keeps live objects packed contiguously so iteration only touches live items, up to a maximum size
+ * specified when the pool is created. Release moves the last object into the freed slot, so pointers to objects are only
+ * valid until the next Release. Not thread safe, access must be externally synchronised
+ */
+template< class TResourceType, class THandleType >
+class AXResourcePool_StorageType_Dense
+{
+public:
+	using ResourceType = TResourceType;
+	using Handle = THandleType;
+	using DenseIndex = AXResourcePool_DenseIndex< THandleType >;
+	typedef typename Handle::IdType SizeType;
+
+public:
+	AXResourcePool_StorageType_Dense( const SizeType& maxSize )
+		: mIndex( maxSize )
+	{
+		mItems.reserve( maxSize );
+	}
+
+	/**
+	* Allocates an object at the end of the live range if possible, returns a handle to the allocated object if one was allocated.
+	* If allocatedObject is not nullptr will fill it in pointing to the object allocated
+	*/
+	Handle Allocate( ResourceType** allocatedObject = nullptr )
+	{
+		Handle hndl( mIndex.Add( ) );
+
+		if( !hndl )
+		{
+			AXWARN( "Resource Pool", "Unable to allocate inside dense resource pool" );
+			return Handle::Invalid;
+		}
+
+		mItems.emplace_back( );
+
+		if( allocatedObject )
+		{
+			( *allocatedObject ) = &mItems.back( );
+		}
+
+		return hndl;
+	}
+
+	/**
+	* Released the object pointed to by the handle, if the handle is valid
+	*/
+	void Release( Handle& hndl )
+	{
+		SizeType removedIdx( 0 );
+		SizeType movedFromIdx( 0 );
+
+		if( mIndex.Remove( hndl, removedIdx, movedFromIdx ) )
+		{
+			if( removedIdx != movedFromIdx )
+			{
+				mItems[removedIdx] = std::move( mItems[movedFromIdx] );
+			}
+
+			mItems.pop_back( );
+		}
+
+		hndl = Handle::Invalid;
+	}
+
+	/**
+	* Attempts to get a resource from the given handle, returns it if possible, otherwise returns nullptr
+	*/
+	const ResourceType* TryGet( const Handle& hndl ) const
+	{
+		const SizeType denseIdx( mIndex.Find( hndl ) );
+		return denseIdx != DenseIndex::InvalidIndex ? &mItems[denseIdx] : nullptr;
+	}
+
+	/**
+	* Attempts to get a resource from the given handle, returns it if possible, otherwise returns nullptr
+	*/
+	ResourceType* TryGet( const Handle& hndl )
+	{
+		const SizeType denseIdx( mIndex.Find( hndl ) );
+		return denseIdx != DenseIndex::InvalidIndex ? &mItems[denseIdx] : nullptr;
+	}
+
+	/**
+	* Returns the handle of the object at the given position in the live range, useful when iterating
+	*/
+	Handle HandleAt( const SizeType& idx ) const { return mIndex.HandleAt( idx ); }
+
+	/**
+	* Returns the maximum capacity of this resource pool
+	*/
+	SizeType Capacity( ) const { return mIndex.MaxCapacity( ); }
+
+	/**
+	* Returns the currently used capacity of this resource pool
+	*/
+	SizeType Count( ) const { return mIndex.Count( ); }
+
+	/**
+	* Returns a pointer to the first live object, live objects are contiguous up to Count( )
+	*/
+	ResourceType* Data( ) { return mItems.data( ); }
+
+	/**
+	* Returns an iterator to the first live object in the pool
+	*/
+	auto begin( ) { return mItems.begin( ); }
+
+	/**
+	* Returns an iterator to the end of the live objects in the pool
+	*/
+	auto end( ) { return mItems.end( ); }
+
+private:
+	DenseIndex mIndex;
+	AXVector< TResourceType > mItems;
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+template< class TResourceType, class THandleType, class TResourcePoolStorageType >
+class AXResourcePool : public AXParent< AXBaseObject, AXResourcePool< TResourceType, THandleType, TResourcePoolStorageType > >
+{
+public:
+	using ResourceType = TResourceType;
+	using ResourcePoolStorageType = TResourcePoolStorageType;
+	using Handle = THandleType;
+
+	typedef typename TResourcePoolStorageType::SizeType SizeType;
+
+public:
+	template< typename ... Args >
+	AXResourcePool( Args... args ) : mStorage( args ... ) { }
+
+	/**
+	 * Allocates an object within the pool if possible, returns a handle to the allocated object if one was allocated.
+	 * If allocatedObject is not nullptr will fill it in pointing to the object allocated
+	 */
+	Handle Allocate( ResourceType** allocatedObject = nullptr ) { return mStorage.Allocate( allocatedObject ); }
+
+	/**
+	 * Released the object pointed to by the handle, if the handle is valid
+	 */
+	void Release( Handle& hndl ) { mStorage.Release( hndl ); }
+
+	/**
+	 * Attempts to get a resource from the given handle, returns it if possible, otherwise returns nullptr
+	 */
+	const ResourceType* TryGet( const Handle& hndl ) const { return mStorage.TryGet( hndl ); }
+
+	/**
+	* Attempts to get a resource from the given handle, returns it if possible, otherwise returns nullptr
+	*/
+	ResourceType* TryGet( const Handle& hndl ) { return mStorage.TryGet( hndl ); }
+
+	/**
+	* Attempts to get a resource from the given handle, returns it if possible, otherwise returns nullptr
+	*/
+	const ResourceType& Get( const Handle& hndl ) const { return AXUtils::AssertPtrReturnRef( TryGet( hndl ) ); }
+
+	/**
+	* Attempts to get a resource from the given handle, returns it if possible, otherwise returns nullptr
+	*/
+	ResourceType& Get( const Handle& hndl ) { return AXUtils::AssertPtrReturnRef( TryGet( hndl ) ); }
+
+	/**
+	 * Returns a reference to the begin element of the internal storage items so they can all be iterated over
+	 */
+	auto begin( ) { return mStorage.begin( ); }
+
+	/**
+	* Returns a reference to the begin element of the internal storage of items so they can all be iterated over
+	*/
+	auto end( ) { return mStorage.end( ); }
+
+	/**
+	 * Returns the maximum capacity of this resource pool
+	 */
+	SizeType Capacity( ) const { return mStorage.Capacity( ); }
+
+	/**
+	* Returns the currently used capacity of this resource pool
+	*/
+	SizeType Count( ) const { return mStorage.Count( ); }
+
+	/**
+	* Returns the underlying storage, for access to functionality specific to the storage type
+	*/
+	ResourcePoolStorageType& GetStorage( ) { return mStorage; }
+
+	/**
+	* Returns the underlying storage, for access to functionality specific to the storage type
+	*/
+	const ResourcePoolStorageType& GetStorage( ) const { return mStorage; }
+
+private:
+	ResourcePoolStorageType mStorage;
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+template< class TResourceType, uint64_t TSize, class THandleType = AXResourcePoolHandle >
+using AXStaticFixedSizeResourcePool = AXResourcePool< TResourceType, THandleType, AXResourcePool_StorageType_StaticFixedSize< TResourceType, THandleType, TSize > >;
+
+template< class TResourceType, class THandleType = AXResourcePoolHandle >
+using AXFixedSizeResourcePool = AXResourcePool< TResourceType, THandleType, AXResourcePool_StorageType_FixedSize< TResourceType, THandleType > >;
+
+template< class TResourceType, uint32_t TPageSize = 64, class THandleType = AXResourcePoolHandle >
+using AXPagedResourcePool = AXResourcePool< TResourceType, THandleType, AXResourcePool_StorageType_Paged< TResourceType, THandleType, TPageSize > >;
+
+template< class TResourceType, class THandleType = AXResourcePoolHandle >
+using AXDenseResourcePool = AXResourcePool< TResourceType, THandleType, AXResourcePool_StorageType_Dense< TResourceType, THandleType > >;
+
+template< class TResourceType, uint32_t TMagazineSize = 32, class THandleType = AXResourcePoolHandle >
+using AXThreadCachedResourcePool = AXResourcePool< TResourceType, THandleType, AXResourcePool_StorageType_ThreadCached< TResourceType, THandleType, TMagazineSize > >;
\ No newline at end of file
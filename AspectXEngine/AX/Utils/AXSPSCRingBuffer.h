@@ -0,0 +1,167 @@
+// Copyright 2016 Scott Bevin, All Rights Reserved
+
+#pragma once
+
+#include "AXThreadingPrimitives.h"
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+/**
+ * A single producer single consumer ring of variable sized records. Records never wrap, when one doesn't fit before the end
+ * of the buffer the remaining space is skipped with a padding record, so every record can be written and read in place.
+ * Records are 8 byte aligned. One thread may write and one other thread may read at the same time without locks
+ */
+class AXSPSCRingBuffer
+{
+public:
+	/**
+	* Constructor, capacity is rounded up to a power of two
+	*/
+	AXSPSCRingBuffer( size_t capacity )
+	{
+		size_t roundedCapacity( 64 );
+
+		while( roundedCapacity < capacity )
+		{
+			roundedCapacity <<= 1;
+		}
+
+		mBuffer = static_cast< uint8_t* >( malloc( roundedCapacity ) );
+		mMask = roundedCapacity - 1;
+	}
+
+	~AXSPSCRingBuffer( )
+	{
+		free( mBuffer );
+	}
+
+	AXSPSCRingBuffer( const AXSPSCRingBuffer& ) = delete;
+	AXSPSCRingBuffer& operator = ( const AXSPSCRingBuffer& ) = delete;
+
+	/**
+	* Producer only, reserves space for a record of size bytes and returns it, or nullptr if the ring is full. The record
+	* is invisible to the consumer until EndWrite
+	*/
+	uint8_t* BeginWrite( size_t size )
+	{
+		const size_t recordSize( AlignRecordSize( sizeof( RecordHeader ) + size ) );
+		const size_t capacity( mMask + 1 );
+
+		if( recordSize > capacity )
+		{
+			return nullptr;
+		}
+
+		const size_t writePos( mWritePos.load( std::memory_order_relaxed ) );
+		const size_t freeSpace( capacity - ( writePos - mReadPos.load( std::memory_order_acquire ) ) );
+		const size_t contiguous( capacity - ( writePos & mMask ) );
+
+		size_t padding( 0 );
+
+		if( recordSize > contiguous )
+		{
+			padding = contiguous;
+		}
+
+		if( padding + recordSize > freeSpace )
+		{
+			return nullptr;
+		}
+
+		if( padding > 0 )
+		{
+			RecordHeader* paddingHeader( reinterpret_cast< RecordHeader* >( mBuffer + ( writePos & mMask ) ) );
+			paddingHeader->mSize = ( uint32_t )padding;
+			paddingHeader->mPayloadSize = PaddingRecord;
+		}
+
+		RecordHeader* header( reinterpret_cast< RecordHeader* >( mBuffer + ( ( writePos + padding ) & mMask ) ) );
+		header->mSize = ( uint32_t )recordSize;
+		header->mPayloadSize = ( uint32_t )size;
+
+		mPendingWriteSize = padding + recordSize;
+
+		return reinterpret_cast< uint8_t* >( header + 1 );
+	}
+
+	/**
+	* Producer only, publishes the record reserved by the last BeginWrite
+	*/
+	void EndWrite( )
+	{
+		mWritePos.store( mWritePos.load( std::memory_order_relaxed ) + mPendingWriteSize, std::memory_order_release );
+		mPendingWriteSize = 0;
+	}
+
+	/**
+	* Consumer only, returns the oldest record and its size, or nullptr if there is none. The record stays valid until EndRead
+	*/
+	const uint8_t* BeginRead( size_t& outSize )
+	{
+		size_t readPos( mReadPos.load( std::memory_order_relaxed ) );
+		const size_t writePos( mWritePos.load( std::memory_order_acquire ) );
+
+		while( readPos != writePos )
+		{
+			const RecordHeader* header( reinterpret_cast< const RecordHeader* >( mBuffer + ( readPos & mMask ) ) );
+
+			if( header->mPayloadSize != PaddingRecord )
+			{
+				outSize = header->mPayloadSize;
+				mPendingReadSize = header->mSize;
+
+				return reinterpret_cast< const uint8_t* >( header + 1 );
+			}
+
+			readPos += header->mSize;
+			mReadPos.store( readPos, std::memory_order_release );
+		}
+
+		return nullptr;
+	}
+
+	/**
+	* Consumer only, releases the record returned by the last BeginRead
+	*/
+	void EndRead( )
+	{
+		mReadPos.store( mReadPos.load( std::memory_order_relaxed ) + mPendingReadSize, std::memory_order_release );
+		mPendingReadSize = 0;
+	}
+
+	/**
+	* Returns true if there is nothing to read, only a hint while the producer is active
+	*/
+	bool IsEmpty( ) const
+	{
+		return mReadPos.load( std::memory_order_acquire ) == mWritePos.load( std::memory_order_acquire );
+	}
+
+	/**
+	* Returns the size of the ring in bytes
+	*/
+	size_t Capacity( ) const { return mMask + 1; }
+
+private:
+	struct RecordHeader
+	{
+		uint32_t mSize;
+		uint32_t mPayloadSize;
+	};
+
+	static const uint32_t PaddingRecord = 0xffffffff;
+
+	static size_t AlignRecordSize( size_t size ) { return ( size + 7 ) & ~( size_t )7; }
+
+private:
+	uint8_t* mBuffer = nullptr;
+	size_t mMask = 0;
+
+	alignas( AXCACHE_LINE_SIZE ) AXAtomic< size_t > mWritePos = 0;
+	size_t mPendingWriteSize = 0;
+
+	alignas( AXCACHE_LINE_SIZE ) AXAtomic< size_t > mReadPos = 0;
+	size_t mPendingReadSize = 0;
+};
\ No newline at end of file
@@ -0,0 +1,244 @@
+// Copyright 2016 Scott Bevin, All Rights Reserved
+
+#pragma once
+
+#include "AXResourcePool.h"
+
+#include <tuple>
+#include <utility>
+#include <stdlib.h>
+
+/**
+ * Alignment of every column in a struct of arrays pool, wide enough for any SIMD load and one cache line
+ */
+#define AXSOA_COLUMN_ALIGNMENT 64
+
+/**
+ * A struct of arrays pool, each field is stored in its own aligned array and the live entries of every column are packed
+ * into [0, Count( )) so kernels can walk a single column linearly. Entries are addressed with the same handles as
+ * AXResourcePool and handle validation, free slot reuse and swap-and-pop removal come from AXResourcePool_DenseIndex,
+ * so column pointers are only stable until the next Release. Not thread safe, access must be externally synchronised
+ */
+template< class THandleType, class... TFields >
+class AXSoAPoolBase
+{
+public:
+	using Handle = THandleType;
+	using DenseIndex = AXResourcePool_DenseIndex< THandleType >;
+	typedef typename Handle::IdType SizeType;
+
+	static const size_t NumFields = sizeof...( TFields );
+
+	template< size_t TField >
+	using FieldType = typename std::tuple_element< TField, std::tuple< TFields... > >::type;
+
+	static_assert( NumFields > 0, "A struct of arrays pool needs at least one field" );
+
+public:
+	AXSoAPoolBase( const SizeType& maxSize )
+		: mIndex( maxSize )
+	{
+		AllocateColumns( std::index_sequence_for< TFields... >( ) );
+	}
+
+	~AXSoAPoolBase( )
+	{
+		for( SizeType i( 0 ); i < Count( ); ++i )
+		{
+			DestroyFields( i, std::index_sequence_for< TFields... >( ) );
+		}
+
+		for( void* columnAlloc : mColumnAllocs )
+		{
+			free( columnAlloc );
+		}
+	}
+
+	AXSoAPoolBase( const AXSoAPoolBase& ) = delete;
+	AXSoAPoolBase& operator = ( const AXSoAPoolBase& ) = delete;
+
+	/**
+	* Allocates an entry at the end of every column, default constructing each field. Returns a handle to the entry if one was allocated
+	*/
+	Handle Allocate( )
+	{
+		Handle hndl( mIndex.Add( ) );
+
+		if( !hndl )
+		{
+			AXWARN( "Resource Pool", "Unable to allocate inside struct of arrays pool" );
+			return Handle::Invalid;
+		}
+
+		ConstructFields( Count( ) - 1, std::index_sequence_for< TFields... >( ) );
+
+		return hndl;
+	}
+
+	/**
+	* Released the entry pointed to by the handle, if the handle is valid
+	*/
+	void Release( Handle& hndl )
+	{
+		SizeType removedIdx( 0 );
+		SizeType movedFromIdx( 0 );
+
+		if( mIndex.Remove( hndl, removedIdx, movedFromIdx ) )
+		{
+			RemoveFields( removedIdx, movedFromIdx, std::index_sequence_for< TFields... >( ) );
+		}
+
+		hndl = Handle::Invalid;
+	}
+
+	/**
+	* Returns true if the handle refers to a live entry
+	*/
+	bool IsValid( const Handle& hndl ) const { return mIndex.Find( hndl ) != DenseIndex::InvalidIndex; }
+
+	/**
+	* Attempts to get a field of the entry from the given handle, returns it if possible, otherwise returns nullptr
+	*/
+	template< size_t TField >
+	const FieldType< TField >* TryGet( const Handle& hndl ) const
+	{
+		const SizeType denseIdx( mIndex.Find( hndl ) );
+		return denseIdx != DenseIndex::InvalidIndex ? &Column< TField >( )[denseIdx] : nullptr;
+	}
+
+	/**
+	* Attempts to get a field of the entry from the given handle, returns it if possible, otherwise returns nullptr
+	*/
+	template< size_t TField >
+	FieldType< TField >* TryGet( const Handle& hndl )
+	{
+		const SizeType denseIdx( mIndex.Find( hndl ) );
+		return denseIdx != DenseIndex::InvalidIndex ? &Column< TField >( )[denseIdx] : nullptr;
+	}
+
+	/**
+	* Gets a field of the entry from the given handle, asserts if the handle is not valid
+	*/
+	template< size_t TField >
+	const FieldType< TField >& Get( const Handle& hndl ) const { return AXUtils::AssertPtrReturnRef( TryGet< TField >( hndl ) ); }
+
+	/**
+	* Gets a field of the entry from the given handle, asserts if the handle is not valid
+	*/
+	template< size_t TField >
+	FieldType< TField >& Get( const Handle& hndl ) { return AXUtils::AssertPtrReturnRef( TryGet< TField >( hndl ) ); }
+
+	/**
+	* Returns the aligned array backing a field, the live entries are [0, Count( ))
+	*/
+	template< size_t TField >
+	const FieldType< TField >* Column( ) const { return std::get< TField >( mColumns ); }
+
+	/**
+	* Returns the aligned array backing a field, the live entries are [0, Count( ))
+	*/
+	template< size_t TField >
+	FieldType< TField >* Column( ) { return std::get< TField >( mColumns ); }
+
+	/**
+	* Returns a pointer to the first live entry of a field so a column can be iterated over
+	*/
+	template< size_t TField >
+	FieldType< TField >* begin( ) { return Column< TField >( ); }
+
+	/**
+	* Returns a pointer one past the last live entry of a field so a column can be iterated over
+	*/
+	template< size_t TField >
+	FieldType< TField >* end( ) { return Column< TField >( ) + Count( ); }
+
+	/**
+	* Returns the handle of the entry at the given position in the columns, useful when iterating
+	*/
+	Handle HandleAt( const SizeType& idx ) const { return mIndex.HandleAt( idx ); }
+
+	/**
+	* Returns the maximum capacity of this pool
+	*/
+	SizeType Capacity( ) const { return mIndex.MaxCapacity( ); }
+
+	/**
+	* Returns the currently used capacity of this pool
+	*/
+	SizeType Count( ) const { return mIndex.Count( ); }
+
+private:
+	template< size_t... TIndices >
+	void AllocateColumns( std::index_sequence< TIndices... > )
+	{
+		using Expand = int[];
+		( void )Expand{ 0, ( AllocateColumn< TIndices >( ), 0 )... };
+	}
+
+	template< size_t TField >
+	void AllocateColumn( )
+	{
+		static_assert( alignof( FieldType< TField > ) <= AXSOA_COLUMN_ALIGNMENT, "Field is aligned beyond the column alignment" );
+
+		const size_t numBytes( sizeof( FieldType< TField > ) * Capacity( ) + AXSOA_COLUMN_ALIGNMENT );
+		void* columnAlloc( malloc( numBytes ) );
+		AXASSERT( columnAlloc, "Failed to allocate struct of arrays column" );
+
+		const uintptr_t alignedAddr( ( reinterpret_cast< uintptr_t >( columnAlloc ) + AXSOA_COLUMN_ALIGNMENT - 1 ) & ~( uintptr_t )( AXSOA_COLUMN_ALIGNMENT - 1 ) );
+
+		mColumnAllocs[TField] = columnAlloc;
+		std::get< TField >( mColumns ) = reinterpret_cast< FieldType< TField >* >( alignedAddr );
+	}
+
+	template< size_t... TIndices >
+	void ConstructFields( const SizeType& idx, std::index_sequence< TIndices... > )
+	{
+		using Expand = int[];
+		( void )Expand{ 0, ( new( &Column< TIndices >( )[idx] ) FieldType< TIndices >( ), 0 )... };
+	}
+
+	template< size_t... TIndices >
+	void DestroyFields( const SizeType& idx, std::index_sequence< TIndices... > )
+	{
+		using Expand = int[];
+		( void )Expand{ 0, ( DestroyField< TIndices >( idx ), 0 )... };
+	}
+
+	template< size_t TField >
+	void DestroyField( const SizeType& idx )
+	{
+		using T = FieldType< TField >;
+		Column< TField >( )[idx].~T( );
+	}
+
+	template< size_t... TIndices >
+	void RemoveFields( const SizeType& removedIdx, const SizeType& movedFromIdx, std::index_sequence< TIndices... > )
+	{
+		using Expand = int[];
+		( void )Expand{ 0, ( RemoveField< TIndices >( removedIdx, movedFromIdx ), 0 )... };
+	}
+
+	template< size_t TField >
+	void RemoveField( const SizeType& removedIdx, const SizeType& movedFromIdx )
+	{
+		FieldType< TField >* column( Column< TField >( ) );
+
+		if( removedIdx != movedFromIdx )
+		{
+			column[removedIdx] = std::move( column[movedFromIdx] );
+		}
+
+		DestroyField< TField >( movedFromIdx );
+	}
+
+private:
+	DenseIndex mIndex;
+	std::tuple< TFields*... > mColumns;
+	void* mColumnAllocs[NumFields] = { };
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+template< class... TFields >
+using AXSoAPool = AXSoAPoolBase< AXResourcePoolHandle, TFields... >;
\ No newline at end of file
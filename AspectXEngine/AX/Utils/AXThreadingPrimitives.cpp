@@ -2,6 +2,35 @@
 
 #include "AXThreadingPrimitives.h"
 
+AXAtomic< uint32_t > AXThreadIndex::sNextIndex = 0;
+
+/**
+* Returns the index of the calling thread, assigning one on first use
+*/
+uint32_t AXThreadIndex::Current( )
+{
+	static thread_local uint32_t threadIndex = InvalidIndex;
+	static thread_local bool threadIndexAssigned = false;
+
+	if( !threadIndexAssigned )
+	{
+		const uint32_t idx( sNextIndex++ );
+		threadIndex = idx < MaxThreads ? idx : InvalidIndex;
+		threadIndexAssigned = true;
+	}
+
+	return threadIndex;
+}
+
+/**
+* Returns the number of indices that have been handed out so far
+*/
+uint32_t AXThreadIndex::NumAssigned( )
+{
+	const uint32_t numAssigned( sNextIndex );
+	return numAssigned < MaxThreads ? numAssigned : MaxThreads;
+}
+
 /**
 * Attempts to get a write lock on the object, returning a success flag, will not block thread executionit is possible
 	* for this function to exist in a case where obtaining a write lock is valid
@@ -8,6 +8,7 @@
 #include <thread>
 #include <atomic>
 #include <list>
+#include <stdint.h>
 
 #if defined( AX32BIT )
 #define AXMULTIREADLOCKPTRINT uint32_t
@@ -20,6 +21,38 @@ using AXAtomic = std::atomic< T >;
 
 using AXThread = std::thread;
 
+/**
+ * Size of a cache line, used to pad per thread data so neighbouring threads do not share lines
+ */
+#define AXCACHE_LINE_SIZE 64
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Hands out a small dense index to every thread that asks for one, for indexing into per thread data. Indices are never
+ * recycled, threads beyond MaxThreads get InvalidIndex and should fall back to a shared path
+ */
+class AXThreadIndex
+{
+public:
+	static const uint32_t MaxThreads = 64;
+	static const uint32_t InvalidIndex = 0xffffffff;
+
+	/**
+	* Returns the index of the calling thread, assigning one on first use
+	*/
+	static uint32_t Current( );
+
+	/**
+	* Returns the number of indices that have been handed out so far
+	*/
+	static uint32_t NumAssigned( );
+
+private:
+	static AXAtomic< uint32_t > sNextIndex;
+};
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
@@ -179,7 +212,7 @@ public:
 	*/
 	T& GetWrite( const void* object )
 	{
-		WriteLock( object );
+		this->WriteLock( object );
 		return mObj;
 	}
 
@@ -188,7 +221,7 @@ public:
 	*/
 	T* TryGetWrite( const void* object )
 	{
-		if( TryWriteLock( object ) )
+		if( this->TryWriteLock( object ) )
 		{
 			return &mObj;
 		}
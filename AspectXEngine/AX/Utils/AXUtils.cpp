@@ -3,12 +3,22 @@
 #include "AXUtils.h"
 #include "AX/Core/AXLogging.h"
 
+namespace
+{
+	const AXName& AssertLogTag( )
+	{
+		static const AXName tag( "Assert" );
+		return tag;
+	}
+}
+
 /**
 * Asserts condition, errors if the value is false
 */
 void AXUtils::AssertFailed2( const char* path, int line, const AXString& message )
 {
-	AXLogging::Log_Internal( AXLogging::LogLevel::Error, "Assert", path, line, message.c_str( ) );
+	AXLogging::Log_Internal( AXLogging::LogLevel::Error, AssertLogTag( ), path, line, "%s", message.c_str( ) );
+	AXLogging::Flush( );
 	assert( false ); // Because crash on error may be off
 }
 
@@ -17,7 +27,20 @@ void AXUtils::AssertFailed2( const char* path, int line, const AXString& message
 */
 void AXUtils::AssertWarning2( const char* path, int line, const AXString& message )
 {
-	AXLogging::Log_Internal( AXLogging::LogLevel::Warning, "Assert", path, line, message.c_str( ) );
+	AXLogging::Log_Internal( AXLogging::LogLevel::Warning, AssertLogTag( ), path, line, "%s", message.c_str( ) );
+}
+
+/**
+* Opens a file with fopen semantics, returns nullptr on failure
+*/
+FILE* AXUtils::OpenFile( const char* path, const char* mode )
+{
+#if defined( AXPLATFORM_WINDOWS )
+	FILE* file( nullptr );
+	return fopen_s( &file, path, mode ) == 0 ? file : nullptr;
+#else
+	return fopen( path, mode );
+#endif
 }
 
 /**
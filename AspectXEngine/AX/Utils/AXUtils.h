@@ -3,15 +3,17 @@
 #pragma once
 
 #include "AX/Utils/AXString.h"
+#include "AX/Utils/AXFrameAllocator.h"
 #include <memory>
 #include <vector>
+#include <stdio.h>
 
 #include "Libs/cJSON/cJSON.h"
 
-#define AXASSERT( COND, MSG, ... ) do{ if( !(COND) ) { AXUtils::AssertFailed( __FILE__, __LINE__, MSG, __VA_ARGS__ ); }  } while( false )
+#define AXASSERT( COND, MSG, ... ) do{ if( !(COND) ) { AXUtils::AssertFailed( __FILE__, __LINE__, MSG, ##__VA_ARGS__ ); }  } while( false )
 #define AXASSERT0( COND ) do{ if( !(COND) ) { AXUtils::AssertFailed( __FILE__, __LINE__, "Assert" ); }  } while( false )
 
-#define AXASSERT_WARN( COND, MSG, ... ) do{ if( !(COND) ) { AXUtils::AssertWarning( __FILE__, __LINE__, MSG, __VA_ARGS__ ); }  } while( false )
+#define AXASSERT_WARN( COND, MSG, ... ) do{ if( !(COND) ) { AXUtils::AssertWarning( __FILE__, __LINE__, MSG, ##__VA_ARGS__ ); }  } while( false )
 #define AXASSERT0_WARN( COND ) do{ if( !(COND) ) { AXUtils::AssertWarning( __FILE__, __LINE__, "Assert" ); }  } while( false )
 
 #define AXJOIN2( X, Y ) X ## Y
@@ -44,9 +46,21 @@ public:
 	static AXString FormatString( const AXString& format, Args ... args )
 	{
 		size_t size = snprintf( nullptr, 0, format.c_str( ), args ... ) + 1; // Extra space for '\0'
-		std::unique_ptr<char[]> buf( new char[size] );
-		snprintf( buf.get( ), size, format.c_str( ), args ... );
-		return AXString( buf.get( ), buf.get( ) + size - 1 ); // We don't want the '\0' inside
+		AXString str( size - 1, '\0' ); // Formatted straight into the result, which already holds space for the '\0'
+		snprintf( &str[0], size, format.c_str( ), args ... );
+		return str;
+	}
+
+	/**
+	 * As FormatString but the result lives in frame scratch memory, for temporaries such as im gui labels
+	 */
+	template< typename ... Args >
+	static AXFrameString FormatFrameString( const char* format, Args ... args )
+	{
+		size_t size = snprintf( nullptr, 0, format, args ... ) + 1; // Extra space for '\0'
+		AXFrameString str( size - 1, '\0' );
+		snprintf( &str[0], size, format, args ... );
+		return str;
 	}
 
 	/**
@@ -77,6 +91,11 @@ public:
 		AssertWarning2( path, line, FormatString( message, args ... ) );
 	}
 
+	/**
+	 * Opens a file with fopen semantics, returns nullptr on failure
+	 */
+	static FILE* OpenFile( const char* path, const char* mode );
+
 	/**
 	 * Splits str into segments seperater by seperator into outResults
 	 */
@@ -0,0 +1,280 @@
+// Copyright 2016 Scott Bevin, All Rights Reserved
+
+#include "AXBenchmark.h"
+#include "Libs/cJSON/cJSON.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <ctime>
+#include <mutex>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <thread>
+
+namespace
+{
+	/**
+	* Threads kept for the whole run and handed a job by RunOnThreads
+	*/
+	class WorkerThreads
+	{
+	public:
+		~WorkerThreads( )
+		{
+			{
+				std::lock_guard< std::mutex > lock( mMutex );
+				mQuit = true;
+			}
+
+			mJobReady.notify_all( );
+
+			for( std::thread& thread : mThreads )
+			{
+				thread.join( );
+			}
+		}
+
+		void Run( uint32_t numThreads, const std::function< void( uint32_t ) >& func )
+		{
+			std::unique_lock< std::mutex > lock( mMutex );
+
+			while( mThreads.size( ) < numThreads )
+			{
+				const uint32_t threadIdx( ( uint32_t )mThreads.size( ) );
+				mThreads.emplace_back( [ this, threadIdx ]( ) { WorkerFunc( threadIdx ); } );
+			}
+
+			mJob = &func;
+			mNumJobThreads = numThreads;
+			mNumRunning = numThreads;
+			++mJobGeneration;
+
+			mJobReady.notify_all( );
+			mJobDone.wait( lock, [ this ]( ) { return mNumRunning == 0; } );
+
+			mJob = nullptr;
+		}
+
+	private:
+		void WorkerFunc( uint32_t threadIdx )
+		{
+			uint64_t lastGeneration( 0 );
+
+			std::unique_lock< std::mutex > lock( mMutex );
+
+			while( true )
+			{
+				mJobReady.wait( lock, [ this, lastGeneration ]( ) { return mQuit || mJobGeneration != lastGeneration; } );
+
+				if( mQuit )
+				{
+					return;
+				}
+
+				lastGeneration = mJobGeneration;
+
+				if( threadIdx < mNumJobThreads )
+				{
+					const std::function< void( uint32_t ) >& job( *mJob );
+
+					lock.unlock( );
+					job( threadIdx );
+					lock.lock( );
+
+					if( --mNumRunning == 0 )
+					{
+						mJobDone.notify_one( );
+					}
+				}
+			}
+		}
+
+	private:
+		std::vector< std::thread > mThreads;
+		std::mutex mMutex;
+		std::condition_variable mJobReady;
+		std::condition_variable mJobDone;
+		const std::function< void( uint32_t ) >* mJob = nullptr;
+		uint64_t mJobGeneration = 0;
+		uint32_t mNumJobThreads = 0;
+		uint32_t mNumRunning = 0;
+		bool mQuit = false;
+	};
+}
+
+/**
+* Registers a benchmark, prefer the AXBENCHMARK macro
+*/
+bool AXBenchmarks::Register( const char* name, Function function )
+{
+	GetEntries( ).push_back( { name, function } );
+	return true;
+}
+
+/**
+* Runs every benchmark whose name contains filter, each one is scaled until a run lasts at least minSeconds
+*/
+std::vector< AXBenchmarks::Result > AXBenchmarks::Run( const char* filter, double minSeconds )
+{
+	std::vector< Result > results;
+
+	for( const Entry& entry : GetEntries( ) )
+	{
+		if( filter && !strstr( entry.mName, filter ) )
+		{
+			continue;
+		}
+
+		uint64_t numIterations( 1 );
+
+		while( true )
+		{
+			AXBenchmarkState state( numIterations );
+
+			const auto start( std::chrono::high_resolution_clock::now( ) );
+			entry.mFunction( state );
+			const double seconds( std::chrono::duration< double >( std::chrono::high_resolution_clock::now( ) - start ).count( ) );
+
+			if( seconds >= minSeconds || numIterations >= ( 1ull << 40 ) )
+			{
+				Result result;
+				result.mName = entry.mName;
+				result.mIterations = numIterations;
+				result.mNanosecondsPerIteration = ( seconds * 1e9 ) / ( double )numIterations;
+				result.mItemsPerSecond = ( double )state.ItemsProcessed( ) / seconds;
+				result.mBytesPerSecond = ( double )state.BytesProcessed( ) / seconds;
+				results.push_back( result );
+
+				printf( "%-48s %12llu iterations %14.1f ns/iteration\n", entry.mName, ( unsigned long long )numIterations, result.mNanosecondsPerIteration );
+				break;
+			}
+
+			// Aim a little past the minimum time so the next run is very likely the last
+			const double scale( seconds > 0.0 ? ( minSeconds * 1.4 ) / seconds : 100.0 );
+			const double clampedScale( AXUtils::Min( AXUtils::Max( scale, 2.0 ), 100.0 ) );
+			numIterations = ( uint64_t )( ( double )numIterations * clampedScale );
+		}
+	}
+
+	return results;
+}
+
+/**
+* Writes results to path as JSON so runs can be compared between engine drops, returns false on failure
+*/
+bool AXBenchmarks::WriteJSON( const std::vector< Result >& results, const char* path )
+{
+	FILE* file( AXUtils::OpenFile( path, "wb" ) );
+
+	if( !file )
+	{
+		printf( "Failed to open %s for writing\n", path );
+		return false;
+	}
+
+	cJSON* root( cJSON_CreateObject( ) );
+
+	// Enough about the run to tell apart results that are not comparable
+	cJSON* context( cJSON_CreateObject( ) );
+	cJSON_AddItemToObject( root, "context", context );
+
+	const time_t now( time( nullptr ) );
+	struct tm utc;
+#if defined( AXPLATFORM_WINDOWS )
+	gmtime_s( &utc, &now );
+#else
+	gmtime_r( &now, &utc );
+#endif
+
+	char date[32] = { };
+	strftime( date, sizeof( date ), "%Y-%m-%dT%H:%M:%SZ", &utc );
+
+	cJSON_AddStringToObject( context, "date", date );
+#if defined( AXPLATFORM_WINDOWS )
+	cJSON_AddStringToObject( context, "platform", "Windows" );
+#else
+	cJSON_AddStringToObject( context, "platform", "Linux" );
+#endif
+#if defined( AXDEBUG )
+	cJSON_AddStringToObject( context, "build", "Debug" );
+#else
+	cJSON_AddStringToObject( context, "build", "Release" );
+#endif
+	cJSON_AddNumberToObject( context, "hardware_threads", std::thread::hardware_concurrency( ) );
+
+	cJSON* benchmarks( cJSON_CreateArray( ) );
+	cJSON_AddItemToObject( root, "benchmarks", benchmarks );
+
+	for( const Result& result : results )
+	{
+		cJSON* benchmark( cJSON_CreateObject( ) );
+		cJSON_AddStringToObject( benchmark, "name", result.mName.c_str( ) );
+		cJSON_AddNumberToObject( benchmark, "iterations", ( double )result.mIterations );
+		cJSON_AddNumberToObject( benchmark, "ns_per_iteration", result.mNanosecondsPerIteration );
+		cJSON_AddNumberToObject( benchmark, "items_per_second", result.mItemsPerSecond );
+		cJSON_AddNumberToObject( benchmark, "bytes_per_second", result.mBytesPerSecond );
+		cJSON_AddItemToArray( benchmarks, benchmark );
+	}
+
+	char* text( cJSON_Print( root ) );
+	const size_t length( strlen( text ) );
+	const bool written( fwrite( text, 1, length, file ) == length );
+
+	free( text );
+	cJSON_Delete( root );
+	fclose( file );
+
+	return written;
+}
+
+/**
+* Calls func( threadIdx ) on numThreads threads at once and waits for them all to finish, for benchmarks measuring
+* contention. The threads are created once and reused so runs do not use up thread indices
+*/
+void AXBenchmarks::RunOnThreads( uint32_t numThreads, const std::function< void( uint32_t threadIdx ) >& func )
+{
+	static WorkerThreads workers;
+	workers.Run( numThreads, func );
+}
+
+std::vector< AXBenchmarks::Entry >& AXBenchmarks::GetEntries( )
+{
+	static std::vector< Entry > entries;
+	return entries;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+int main( int argc, char** argv )
+{
+	const char* filter( nullptr );
+	const char* jsonPath( nullptr );
+	double minSeconds( 0.5 );
+
+	for( int i( 1 ); i < argc; ++i )
+	{
+		if( strcmp( argv[i], "--filter" ) == 0 && i + 1 < argc )
+		{
+			filter = argv[++i];
+		}
+		else if( strcmp( argv[i], "--min-time" ) == 0 && i + 1 < argc )
+		{
+			minSeconds = atof( argv[++i] );
+		}
+		else if( strcmp( argv[i], "--json" ) == 0 && i + 1 < argc )
+		{
+			jsonPath = argv[++i];
+		}
+	}
+
+	const std::vector< AXBenchmarks::Result > results( AXBenchmarks::Run( filter, minSeconds ) );
+
+	if( jsonPath && !AXBenchmarks::WriteJSON( results, jsonPath ) )
+	{
+		return 1;
+	}
+
+	return 0;
+}
\ No newline at end of file
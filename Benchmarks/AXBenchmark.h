@@ -0,0 +1,128 @@
+// Copyright 2016 Scott Bevin, All Rights Reserved
+
+#pragma once
+
+#include "AX/Utils/AXString.h"
+#include "AX/Utils/AXUtils.h"
+
+#include <functional>
+#include <stdint.h>
+#include <vector>
+
+/**
+ * Passed to every benchmark, the timed section is the body of a while( state.KeepRunning( ) ) loop
+ */
+class AXBenchmarkState
+{
+public:
+	AXBenchmarkState( uint64_t numIterations ) : mNumIterations( numIterations ) { }
+
+	/**
+	* Returns true while the benchmark should run another iteration
+	*/
+	bool KeepRunning( )
+	{
+		if( mIteration < mNumIterations )
+		{
+			++mIteration;
+			return true;
+		}
+
+		return false;
+	}
+
+	/**
+	* Returns the number of iterations this run will perform
+	*/
+	uint64_t NumIterations( ) const { return mNumIterations; }
+
+	/**
+	* Sets the number of items processed over the whole run, reported as items per second
+	*/
+	void SetItemsProcessed( uint64_t items ) { mItemsProcessed = items; }
+
+	/**
+	* Sets the number of bytes processed over the whole run, reported as bytes per second
+	*/
+	void SetBytesProcessed( uint64_t bytes ) { mBytesProcessed = bytes; }
+
+	uint64_t ItemsProcessed( ) const { return mItemsProcessed; }
+	uint64_t BytesProcessed( ) const { return mBytesProcessed; }
+
+private:
+	uint64_t mNumIterations;
+	uint64_t mIteration = 0;
+	uint64_t mItemsProcessed = 0;
+	uint64_t mBytesProcessed = 0;
+};
+
+/**
+ * Holds every registered benchmark and runs them
+ */
+class AXBenchmarks
+{
+public:
+	using Function = void( * )( AXBenchmarkState& state );
+
+	struct Result
+	{
+		AXString mName;
+		uint64_t mIterations = 0;
+		double mNanosecondsPerIteration = 0.0;
+		double mItemsPerSecond = 0.0;
+		double mBytesPerSecond = 0.0;
+	};
+
+public:
+	/**
+	* Registers a benchmark, prefer the AXBENCHMARK macro
+	*/
+	static bool Register( const char* name, Function function );
+
+	/**
+	* Runs every benchmark whose name contains filter, each one is scaled until a run lasts at least minSeconds
+	*/
+	static std::vector< Result > Run( const char* filter, double minSeconds );
+
+	/**
+	* Writes results to path as JSON so runs can be compared between engine drops, returns false on failure
+	*/
+	static bool WriteJSON( const std::vector< Result >& results, const char* path );
+
+	/**
+	* Calls func( threadIdx ) on numThreads threads at once and waits for them all to finish, for benchmarks measuring
+	* contention. The threads are created once and reused so runs do not use up thread indices
+	*/
+	static void RunOnThreads( uint32_t numThreads, const std::function< void( uint32_t threadIdx ) >& func );
+
+private:
+	struct Entry
+	{
+		const char* mName;
+		Function mFunction;
+	};
+
+	static std::vector< Entry >& GetEntries( );
+};
+
+/**
+ * Defines and registers a benchmark, the body receives an AXBenchmarkState& named state
+ */
+#define AXBENCHMARK( NAME ) \
+	static void NAME( AXBenchmarkState& state ); \
+	static const bool AXJOIN( NAME, Registered ) = AXBenchmarks::Register( #NAME, &NAME ); \
+	static void NAME( AXBenchmarkState& state )
+
+/**
+ * Stops the compiler from optimising away a value computed inside a benchmark
+ */
+template< class T >
+inline void AXBenchmarkDoNotOptimise( const T& val )
+{
+#if defined( _MSC_VER )
+	static volatile const void* sink;
+	sink = &val;
+#else
+	asm volatile( "" : : "g"( &val ) : "memory" );
+#endif
+}
\ No newline at end of file
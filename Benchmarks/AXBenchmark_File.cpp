@@ -0,0 +1,72 @@
+// Copyright 2016 Scott Bevin, All Rights Reserved
+
+#include "AXBenchmark.h"
+#include "AX/IO/AXPlatformFile.h"
+
+#include <stdio.h>
+
+namespace
+{
+	/**
+	* Writes a file of size bytes for the read benchmarks, it stays in the OS file cache so reads measure the engine's overhead
+	*/
+	AXString CreateTestFile( AXFile::FileSize size )
+	{
+		const AXString path( AXUtils::FormatString( "AXBenchmark_File_%llu.bin", ( unsigned long long )size ) );
+
+		AXPlatformFile file;
+
+		if( file.OpenFile( path, AXFile::FileOpenMode::Write, AXFile::DataMode::Binary ) )
+		{
+			AXFile::InternalFileBuffer& buffer( file.CreateInternalBuffer( size ) );
+
+			for( AXFile::FileSize i( 0 ); i < size; ++i )
+			{
+				buffer.Data( )[i] = ( uint8_t )( i * 31 );
+			}
+
+			file.WriteInternalBufferToFile( );
+			file.CloseFile( );
+		}
+
+		return path;
+	}
+
+	void ReadWholeFile( AXBenchmarkState& state, AXFile::FileSize size )
+	{
+		const AXString path( CreateTestFile( size ) );
+
+		AXPlatformFile file;
+		uint64_t numBytes( 0 );
+
+		while( state.KeepRunning( ) )
+		{
+			if( file.OpenFile( path, AXFile::FileOpenMode::Read, AXFile::DataMode::Binary ) )
+			{
+				numBytes += file.ReadFileToInternalBuffer( ).Size( );
+				file.CloseFile( );
+			}
+		}
+
+		file.DestroyInternalBuffer( );
+		remove( path.c_str( ) );
+
+		state.SetItemsProcessed( state.NumIterations( ) );
+		state.SetBytesProcessed( numBytes );
+	}
+}
+
+AXBENCHMARK( File_Read_4KB )
+{
+	ReadWholeFile( state, 4 * 1024 );
+}
+
+AXBENCHMARK( File_Read_64KB )
+{
+	ReadWholeFile( state, 64 * 1024 );
+}
+
+AXBENCHMARK( File_Read_1MB )
+{
+	ReadWholeFile( state, 1024 * 1024 );
+}
\ No newline at end of file
@@ -0,0 +1,209 @@
+// Copyright 2016 Scott Bevin, All Rights Reserved
+
+#include "AXBenchmark.h"
+#include "AX/Utils/AXJSON.h"
+#include "AX/Utils/AXJSONArena.h"
+#include "AX/Math/AXMathVector.h"
+#include "Libs/cJSON/cJSON.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+namespace
+{
+	/**
+	* A settings file shaped like the engine's, many systems each with a spread of property types
+	*/
+	const AXString& GetLargeSettingsText( )
+	{
+		static AXString text;
+
+		if( text.empty( ) )
+		{
+			text = "{ \"Meta\": { \"Version\": 0 }, \"Systems\": {";
+
+			for( int system( 0 ); system < 2000; ++system )
+			{
+				text += AXUtils::FormatString( "%s\"System %d\": {", system > 0 ? "," : "", system );
+
+				for( int prop( 0 ); prop < 16; ++prop )
+				{
+					switch( prop % 4 )
+					{
+					case 0: text += AXUtils::FormatString( "\"Int Property %d\": %d,", prop, system * prop ); break;
+					case 1: text += AXUtils::FormatString( "\"Float Property %d\": %f,", prop, system * 0.25f ); break;
+					case 2: text += AXUtils::FormatString( "\"Bool Property %d\": %s,", prop, ( system + prop ) % 2 ? "true" : "false" ); break;
+					case 3: text += AXUtils::FormatString( "\"String Property %d\": \"Content/Value_%d_%d\",", prop, system, prop ); break;
+					}
+				}
+
+				text += "\"Colour\": { \"X\": 0.5, \"Y\": 0.25, \"Z\": 1.0, \"W\": 1.0 } }";
+			}
+
+			text += "} }";
+		}
+
+		return text;
+	}
+
+	/**
+	* A content manifest, a long array of asset records with nested dependency lists
+	*/
+	const AXString& GetLargeManifestText( )
+	{
+		static AXString text;
+
+		if( text.empty( ) )
+		{
+			text = "{ \"Assets\": [";
+
+			for( int asset( 0 ); asset < 50000; ++asset )
+			{
+				text += AXUtils::FormatString(
+					"%s{ \"Path\": \"Textures/Environment/Asset_%05d.png\", \"Type\": \"Textures\", \"Size\": %d, \"Hash\": \"%08x%08x\", \"Dependencies\": [ %d, %d, %d ] }",
+					asset > 0 ? "," : "", asset, asset * 1024, asset * 2654435761u, asset ^ 0x5bd1e995, asset / 2, asset / 3, asset / 5 );
+			}
+
+			text += "] }";
+		}
+
+		return text;
+	}
+
+	/**
+	* A settings item's worth of values, written and read through AXJSON the way properties are
+	*/
+	struct SettingsValues
+	{
+		static const uint32_t NumValues = 16;
+
+		SettingsValues( )
+		{
+			for( uint32_t i( 0 ); i < NumValues; ++i )
+			{
+				mNames[i][0] = AXUtils::FormatString( "Count %u", i );
+				mNames[i][1] = AXUtils::FormatString( "Enabled %u", i );
+				mNames[i][2] = AXUtils::FormatString( "Path %u", i );
+				mNames[i][3] = AXUtils::FormatString( "Colour %u", i );
+
+				mCounts[i] = i * 100;
+				mEnabled[i] = ( i % 2 ) == 0;
+				mPaths[i] = AXUtils::FormatString( "Content/Textures/Value_%u.png", i );
+				mColours[i] = AXVector4f( 0.5f, 0.25f, ( float )i, 1.0f );
+			}
+		}
+
+		void Write( cJSON& root ) const
+		{
+			for( uint32_t i( 0 ); i < NumValues; ++i )
+			{
+				AXJSON::WriteValue( root, mCounts[i], mNames[i][0].c_str( ) );
+				AXJSON::WriteValue( root, mEnabled[i], mNames[i][1].c_str( ) );
+				AXJSON::WriteValue( root, mPaths[i], mNames[i][2].c_str( ) );
+				AXJSON::WriteValue( root, mColours[i], mNames[i][3].c_str( ) );
+			}
+		}
+
+		void Read( cJSON& root )
+		{
+			for( uint32_t i( 0 ); i < NumValues; ++i )
+			{
+				AXJSON::ReadValue( root, mCounts[i], mNames[i][0].c_str( ) );
+				AXJSON::ReadValue( root, mEnabled[i], mNames[i][1].c_str( ) );
+				AXJSON::ReadValue( root, mPaths[i], mNames[i][2].c_str( ) );
+				AXJSON::ReadValue( root, mColours[i], mNames[i][3].c_str( ) );
+			}
+		}
+
+		AXString mNames[NumValues][4];
+		uint32_t mCounts[NumValues];
+		bool mEnabled[NumValues];
+		AXString mPaths[NumValues];
+		AXVector4f mColours[NumValues];
+	};
+
+	void ParseAndDelete( AXBenchmarkState& state, const AXString& text )
+	{
+		while( state.KeepRunning( ) )
+		{
+			cJSON* root( cJSON_Parse( text.c_str( ) ) );
+			AXBenchmarkDoNotOptimise( root );
+			cJSON_Delete( root );
+		}
+
+		state.SetBytesProcessed( state.NumIterations( ) * text.size( ) );
+	}
+
+	void ParseAndDeleteInArena( AXBenchmarkState& state, const AXString& text )
+	{
+		while( state.KeepRunning( ) )
+		{
+			AXJSONArenaScope arena( AXJSONArenaScope::BlockSizeForText( text.size( ) ) );
+
+			cJSON* root( cJSON_Parse( text.c_str( ) ) );
+			AXBenchmarkDoNotOptimise( root );
+			cJSON_Delete( root );
+		}
+
+		state.SetBytesProcessed( state.NumIterations( ) * text.size( ) );
+	}
+}
+
+AXBENCHMARK( JSON_ParseSettings_Heap )
+{
+	ParseAndDelete( state, GetLargeSettingsText( ) );
+}
+
+AXBENCHMARK( JSON_ParseSettings_Arena )
+{
+	ParseAndDeleteInArena( state, GetLargeSettingsText( ) );
+}
+
+AXBENCHMARK( JSON_ParseManifest_Heap )
+{
+	ParseAndDelete( state, GetLargeManifestText( ) );
+}
+
+AXBENCHMARK( JSON_ParseManifest_Arena )
+{
+	ParseAndDeleteInArena( state, GetLargeManifestText( ) );
+}
+
+AXBENCHMARK( JSON_AXJSON_WriteSettings )
+{
+	const SettingsValues values;
+	uint64_t numBytes( 0 );
+
+	while( state.KeepRunning( ) )
+	{
+		cJSON* root( cJSON_CreateObject( ) );
+		values.Write( *root );
+
+		char* text( cJSON_Print( root ) );
+		numBytes += strlen( text );
+
+		free( text );
+		cJSON_Delete( root );
+	}
+
+	state.SetItemsProcessed( state.NumIterations( ) * SettingsValues::NumValues * 4 );
+	state.SetBytesProcessed( numBytes );
+}
+
+AXBENCHMARK( JSON_AXJSON_ReadSettings )
+{
+	SettingsValues values;
+
+	cJSON* root( cJSON_CreateObject( ) );
+	values.Write( *root );
+
+	while( state.KeepRunning( ) )
+	{
+		values.Read( *root );
+		AXBenchmarkDoNotOptimise( values );
+	}
+
+	cJSON_Delete( root );
+
+	state.SetItemsProcessed( state.NumIterations( ) * SettingsValues::NumValues * 4 );
+}
\ No newline at end of file
@@ -0,0 +1,98 @@
+// Copyright 2016 Scott Bevin, All Rights Reserved
+
+#include "AXBenchmark.h"
+#include "AX/Math/AXMathVector.h"
+
+namespace
+{
+	/**
+	* Enough vectors to stay in cache, so the operators are measured rather than memory
+	*/
+	const uint32_t sNumVectors = 1024;
+
+	struct Vectors
+	{
+		Vectors( )
+		{
+			for( uint32_t i( 0 ); i < sNumVectors; ++i )
+			{
+				mA[i] = AXVector4f( ( float )i, ( float )i * 0.5f, ( float )i * 0.25f, 1.0f );
+				mB[i] = AXVector4f( 1.0f, 2.0f, ( float )( i % 7 ), ( float )( i % 3 ) );
+			}
+		}
+
+		AXVector4f mA[sNumVectors];
+		AXVector4f mB[sNumVectors];
+		AXVector4f mOut[sNumVectors];
+	};
+}
+
+AXBENCHMARK( MathVector_Vector4f_AddAssign )
+{
+	Vectors vectors;
+
+	while( state.KeepRunning( ) )
+	{
+		for( uint32_t i( 0 ); i < sNumVectors; ++i )
+		{
+			vectors.mA[i] += vectors.mB[i];
+		}
+
+		AXBenchmarkDoNotOptimise( vectors.mA );
+	}
+
+	state.SetItemsProcessed( state.NumIterations( ) * sNumVectors );
+}
+
+AXBENCHMARK( MathVector_Vector4f_Add )
+{
+	Vectors vectors;
+
+	while( state.KeepRunning( ) )
+	{
+		for( uint32_t i( 0 ); i < sNumVectors; ++i )
+		{
+			vectors.mOut[i] = vectors.mA[i] + vectors.mB[i];
+		}
+
+		AXBenchmarkDoNotOptimise( vectors.mOut );
+	}
+
+	state.SetItemsProcessed( state.NumIterations( ) * sNumVectors );
+}
+
+AXBENCHMARK( MathVector_Vector4f_ScaleAssign )
+{
+	// Scaled by -1 so repeated runs never shrink the values into denormals
+	Vectors vectors;
+
+	while( state.KeepRunning( ) )
+	{
+		for( uint32_t i( 0 ); i < sNumVectors; ++i )
+		{
+			vectors.mA[i] *= -1.0f;
+		}
+
+		AXBenchmarkDoNotOptimise( vectors.mA );
+	}
+
+	state.SetItemsProcessed( state.NumIterations( ) * sNumVectors );
+}
+
+AXBENCHMARK( MathVector_Vector4f_Compare )
+{
+	Vectors vectors;
+	uint32_t numEqual( 0 );
+
+	while( state.KeepRunning( ) )
+	{
+		for( uint32_t i( 0 ); i < sNumVectors; ++i )
+		{
+			numEqual += ( vectors.mA[i] == vectors.mB[i] ) ? 1 : 0;
+		}
+
+		AXBenchmarkDoNotOptimise( numEqual );
+	}
+
+	state.SetItemsProcessed( state.NumIterations( ) * sNumVectors );
+}
\ No newline at end of file
@@ -0,0 +1,86 @@
+// Copyright 2016 Scott Bevin, All Rights Reserved
+
+#include "AXBenchmark.h"
+#include "AX/Utils/AXThreadingPrimitives.h"
+
+namespace
+{
+	const uint32_t sNumThreads = 4;
+
+	/**
+	* In the mixed benchmark one lock in this many is a write lock
+	*/
+	const uint32_t sWriteInterval = 16;
+
+	/**
+	* Each thread locks with its own object, read locks are tracked per object
+	*/
+	void ReadWriteContended( AXBenchmarkState& state, uint32_t writeInterval )
+	{
+		AXMultiReadLock lock;
+		uint64_t sharedValue( 0 );
+
+		const uint64_t iterationsPerThread( ( state.NumIterations( ) + sNumThreads - 1 ) / sNumThreads );
+
+		AXBenchmarks::RunOnThreads( sNumThreads, [ &lock, &sharedValue, iterationsPerThread, writeInterval ]( uint32_t threadIdx )
+		{
+			const int lockObject( 0 );
+
+			for( uint64_t i( 0 ); i < iterationsPerThread; ++i )
+			{
+				if( writeInterval > 0 && i % writeInterval == 0 )
+				{
+					lock.WriteLock( &lockObject );
+					++sharedValue;
+					lock.ReleaseWriteLock( &lockObject );
+				}
+				else
+				{
+					lock.ReadLock( &lockObject );
+					AXBenchmarkDoNotOptimise( sharedValue );
+					lock.ReleaseReadLock( &lockObject );
+				}
+			}
+		} );
+
+		state.SetItemsProcessed( iterationsPerThread * sNumThreads );
+	}
+}
+
+AXBENCHMARK( MultiReadLock_Read_Uncontended )
+{
+	AXMultiReadLock lock;
+	const int lockObject( 0 );
+
+	while( state.KeepRunning( ) )
+	{
+		lock.ReadLock( &lockObject );
+		lock.ReleaseReadLock( &lockObject );
+	}
+
+	state.SetItemsProcessed( state.NumIterations( ) );
+}
+
+AXBENCHMARK( MultiReadLock_Write_Uncontended )
+{
+	AXMultiReadLock lock;
+	const int lockObject( 0 );
+
+	while( state.KeepRunning( ) )
+	{
+		lock.WriteLock( &lockObject );
+		lock.ReleaseWriteLock( &lockObject );
+	}
+
+	state.SetItemsProcessed( state.NumIterations( ) );
+}
+
+AXBENCHMARK( MultiReadLock_Read_Contended )
+{
+	ReadWriteContended( state, 0 );
+}
+
+AXBENCHMARK( MultiReadLock_ReadWrite_Contended )
+{
+	ReadWriteContended( state, sWriteInterval );
+}
\ No newline at end of file
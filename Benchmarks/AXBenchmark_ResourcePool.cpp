@@ -0,0 +1,120 @@
+// Copyright 2016 Scott Bevin, All Rights Reserved
+
+#include "AXBenchmark.h"
+#include "AX/Utils/AXResourcePool.h"
+
+namespace
+{
+	/**
+	* Roughly the size of a small engine object
+	*/
+	struct PoolItem
+	{
+		uint64_t mData[8];
+	};
+
+	const uint32_t sPoolSize = 4096;
+
+	/**
+	* The number of handles each iteration allocates then releases, so pools are measured partly full rather than empty
+	*/
+	const uint32_t sBatchSize = 64;
+
+	const uint32_t sNumThreads = 4;
+
+	template< class TPool >
+	void FlushThreadCache( TPool& pool ) { }
+
+	template< class TResourceType, uint32_t TMagazineSize, class THandleType >
+	void FlushThreadCache( AXThreadCachedResourcePool< TResourceType, TMagazineSize, THandleType >& pool ) { pool.GetStorage( ).FlushThreadCache( ); }
+
+	template< class TPool >
+	void AllocateReleaseBatch( AXBenchmarkState& state, TPool& pool )
+	{
+		typename TPool::Handle handles[sBatchSize];
+
+		while( state.KeepRunning( ) )
+		{
+			for( uint32_t i( 0 ); i < sBatchSize; ++i )
+			{
+				handles[i] = pool.Allocate( );
+			}
+
+			AXBenchmarkDoNotOptimise( handles );
+
+			for( uint32_t i( 0 ); i < sBatchSize; ++i )
+			{
+				pool.Release( handles[i] );
+			}
+		}
+
+		state.SetItemsProcessed( state.NumIterations( ) * sBatchSize );
+	}
+
+	template< class TPool >
+	void AllocateReleaseBatchContended( AXBenchmarkState& state, TPool& pool )
+	{
+		const uint64_t iterationsPerThread( ( state.NumIterations( ) + sNumThreads - 1 ) / sNumThreads );
+
+		AXBenchmarks::RunOnThreads( sNumThreads, [ &pool, iterationsPerThread ]( uint32_t threadIdx )
+		{
+			typename TPool::Handle handles[sBatchSize];
+
+			for( uint64_t iteration( 0 ); iteration < iterationsPerThread; ++iteration )
+			{
+				for( uint32_t i( 0 ); i < sBatchSize; ++i )
+				{
+					handles[i] = pool.Allocate( );
+				}
+
+				AXBenchmarkDoNotOptimise( handles );
+
+				for( uint32_t i( 0 ); i < sBatchSize; ++i )
+				{
+					pool.Release( handles[i] );
+				}
+			}
+
+			FlushThreadCache( pool );
+		} );
+
+		state.SetItemsProcessed( iterationsPerThread * sNumThreads * sBatchSize );
+	}
+}
+
+AXBENCHMARK( ResourcePool_FixedSize_AllocateRelease )
+{
+	AXFixedSizeResourcePool< PoolItem > pool( sPoolSize );
+	AllocateReleaseBatch( state, pool );
+}
+
+AXBENCHMARK( ResourcePool_Paged_AllocateRelease )
+{
+	AXPagedResourcePool< PoolItem > pool( sPoolSize );
+	AllocateReleaseBatch( state, pool );
+}
+
+AXBENCHMARK( ResourcePool_Dense_AllocateRelease )
+{
+	AXDenseResourcePool< PoolItem > pool( sPoolSize );
+	AllocateReleaseBatch( state, pool );
+}
+
+AXBENCHMARK( ResourcePool_ThreadCached_AllocateRelease )
+{
+	AXThreadCachedResourcePool< PoolItem > pool( sPoolSize );
+	AllocateReleaseBatch( state, pool );
+	FlushThreadCache( pool );
+}
+
+AXBENCHMARK( ResourcePool_FixedSize_AllocateRelease_Contended )
+{
+	AXFixedSizeResourcePool< PoolItem > pool( sPoolSize );
+	AllocateReleaseBatchContended( state, pool );
+}
+
+AXBENCHMARK( ResourcePool_ThreadCached_AllocateRelease_Contended )
+{
+	AXThreadCachedResourcePool< PoolItem > pool( sPoolSize );
+	AllocateReleaseBatchContended( state, pool );
+}
\ No newline at end of file
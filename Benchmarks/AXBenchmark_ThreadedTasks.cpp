@@ -0,0 +1,76 @@
+// Copyright 2016 Scott Bevin, All Rights Reserved
+
+#include "AXBenchmark.h"
+#include "AX/Core/Threads/AXThreadedTasks.h"
+
+#include <thread>
+
+namespace
+{
+	const uint32_t sNumThreads = 4;
+
+	/**
+	* Most tasks the producer lets build up in the queue before it helps run them, picking a task walks the whole queue
+	*/
+	const uint64_t sMaxQueuedTasks = 256;
+}
+
+AXBENCHMARK( ThreadedTasks_SubmitAndRun )
+{
+	AXThreadedTasks tasks;
+	uint64_t numRun( 0 );
+
+	AXTask::Params params;
+	params.mCallback = [ &numRun ]( AXTask::TaskUserData* userData ) { ++numRun; return AXTask::TaskResult( ); };
+
+	while( state.KeepRunning( ) )
+	{
+		tasks.RequestTaskRun( params );
+		tasks.RunNextAvailableTask( );
+	}
+
+	AXBenchmarkDoNotOptimise( numRun );
+	state.SetItemsProcessed( state.NumIterations( ) );
+}
+
+AXBENCHMARK( ThreadedTasks_Throughput )
+{
+	AXThreadedTasks tasks;
+	AXAtomic< uint64_t > numRun( 0 );
+
+	AXTask::Params params;
+	params.mCallback = [ &numRun ]( AXTask::TaskUserData* userData ) { numRun.fetch_add( 1, std::memory_order_relaxed ); return AXTask::TaskResult( ); };
+
+	const uint64_t numTasks( state.NumIterations( ) );
+
+	// Thread 0 submits every task, the rest run them until all have finished
+	AXBenchmarks::RunOnThreads( sNumThreads, [ &tasks, &numRun, &params, numTasks ]( uint32_t threadIdx )
+	{
+		if( threadIdx == 0 )
+		{
+			for( uint64_t numSubmitted( 0 ); numSubmitted < numTasks; )
+			{
+				if( numSubmitted - numRun.load( std::memory_order_relaxed ) < sMaxQueuedTasks )
+				{
+					tasks.RequestTaskRun( params );
+					++numSubmitted;
+				}
+				else
+				{
+					tasks.RunNextAvailableTask( );
+				}
+			}
+		}
+
+		// Yield when there is nothing to run, readers spinning on the queue's lock starve the producer's write lock
+		while( numRun.load( std::memory_order_relaxed ) < numTasks )
+		{
+			if( !tasks.RunNextAvailableTask( ) )
+			{
+				std::this_thread::yield( );
+			}
+		}
+	} );
+
+	state.SetItemsProcessed( numTasks );
+}
\ No newline at end of file
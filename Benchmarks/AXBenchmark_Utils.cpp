@@ -0,0 +1,75 @@
+// Copyright 2016 Scott Bevin, All Rights Reserved
+
+#include "AXBenchmark.h"
+#include "AX/Utils/AXFrameAllocator.h"
+
+namespace
+{
+	/**
+	* FormatFrameString allocates from the frame allocator, which is only rewound at the end of a frame. Strings are
+	* destroyed before the frame ends
+	*/
+	const uint64_t sIterationsPerFrame = 1024;
+
+	void EndFrameEvery( uint64_t& iteration )
+	{
+		if( ++iteration % sIterationsPerFrame == 0 )
+		{
+			AXFrameAllocator::EndFrame( );
+		}
+	}
+}
+
+AXBENCHMARK( Utils_FormatString_Short )
+{
+	while( state.KeepRunning( ) )
+	{
+		AXString str( AXUtils::FormatString( "Initialized system: %s", "Frame Timings" ) );
+		AXBenchmarkDoNotOptimise( str );
+	}
+
+	state.SetItemsProcessed( state.NumIterations( ) );
+}
+
+AXBENCHMARK( Utils_FormatString_Numbers )
+{
+	uint64_t iteration( 0 );
+
+	while( state.KeepRunning( ) )
+	{
+		AXString str( AXUtils::FormatString( "Frame %llu took %.3f ms, %d draws", ( unsigned long long )iteration++, 16.6667f, 1024 ) );
+		AXBenchmarkDoNotOptimise( str );
+	}
+
+	state.SetItemsProcessed( state.NumIterations( ) );
+}
+
+AXBENCHMARK( Utils_FormatString_Long )
+{
+	const AXString path( "Content/Textures/Environment/Forest/Trees/Oak_Bark_Diffuse_2048x2048.png" );
+
+	while( state.KeepRunning( ) )
+	{
+		AXString str( AXUtils::FormatString( "Failed to import asset %s with importer %s, the file was %d bytes but the header said %d", path.c_str( ), "PNG", 4194304, 4194432 ) );
+		AXBenchmarkDoNotOptimise( str );
+	}
+
+	state.SetItemsProcessed( state.NumIterations( ) );
+}
+
+AXBENCHMARK( Utils_FormatFrameString_Numbers )
+{
+	uint64_t iteration( 0 );
+
+	while( state.KeepRunning( ) )
+	{
+		{
+			AXFrameString str( AXUtils::FormatFrameString( "Frame %llu took %.3f ms, %d draws", ( unsigned long long )iteration, 16.6667f, 1024 ) );
+			AXBenchmarkDoNotOptimise( str );
+		}
+
+		EndFrameEvery( iteration );
+	}
+
+	state.SetItemsProcessed( state.NumIterations( ) );
+}
\ No newline at end of file
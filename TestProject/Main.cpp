@@ -1,5 +1,7 @@
 // Copyright 2016 Scott Bevin, All Rights Reserved
 
+#if defined( AXPLATFORM_WINDOWS )
+
 #define WIN32_LEAN_AND_MEAN
 
 #include <windows.h>
@@ -14,4 +16,26 @@ int WINAPI WinMain( HINSTANCE hInstance, HINSTANCE hPrevInstance, PSTR pScmdline
 	AXApplication::Use< TestProjectApplication >( ).RunEngine( prams );
 
 	return 0;
-}
\ No newline at end of file
+}
+
+#else
+
+#include "TestProjectApplication.h"
+
+int main( int argc, char** argv )
+{
+	AXApplication::SetupParams prams;
+
+	// Rebuilt into a single line to match what WinMain is given
+	for( int i( 1 ); i < argc; ++i )
+	{
+		prams.mCommandLine += ( i > 1 ? " " : "" );
+		prams.mCommandLine += argv[i];
+	}
+
+	AXApplication::Use< TestProjectApplication >( ).RunEngine( prams );
+
+	return 0;
+}
+
+#endif // #if defined( AXPLATFORM_WINDOWS )
\ No newline at end of file
@@ -1,6 +1,8 @@
 // Copyright 2016 Scott Bevin, All Rights Reserved
 
 #include "TestProjectApplication.h"
+#include "TestProjectScenario.h"
+#include "TestProjectSimulation.h"
 
 #include "AX/Core/AXLogging.h"
 
@@ -31,4 +33,7 @@ void TestProjectApplication::CreateDefaultSystems( )
 	}
 
 	AXApplication::CreateDefaultSystems( );
+
+	CreateSystem< TestProjectScenario >( );
+	CreateSystem< TestProjectSimulation >( );
 }
\ No newline at end of file
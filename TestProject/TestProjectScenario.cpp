@@ -0,0 +1,230 @@
+// Copyright 2016 Scott Bevin, All Rights Reserved
+
+#include "TestProjectScenario.h"
+
+#include "AX/Core/AXApplication.h"
+#include "AX/Core/AXLogging.h"
+#include "AX/Core/AXPerfCounters.h"
+#include "AX/Core/AXProfiler.h"
+#include "AX/Core/Threads/AXThreadedTasks.h"
+#include "AX/Content/AXContent.h"
+#include "AX/IO/AXDirectory.h"
+#include "AX/IO/AXPlatformFile.h"
+
+#include <math.h>
+
+template<> AXName AXSystem< TestProjectScenario >::sSystemName = "Test Scenario";
+
+/**
+* Moves along a little every update, standing in for game objects
+*/
+void TestProjectScenario::Mover::Update( float dt )
+{
+	mVelocity -= mPosition * dt;
+	mPosition += mVelocity * dt;
+
+	AXPERF_COUNT( "Scenario/Updateables Updated", 1 );
+}
+
+/**
+* Override to handle command line arguments, gets called after create settings
+*/
+void TestProjectScenario::HandleCommandLine( const std::vector< AXString >& args )
+{
+	for( const AXString& arg : args )
+	{
+		if( arg == "-scenario" )
+		{
+			mEnabled = true;
+		}
+	}
+}
+
+/**
+* Initialise the system, called after settings are loaded
+*/
+TestProjectScenario::InitResult TestProjectScenario::OnInitialize( )
+{
+	if( !mEnabled )
+	{
+		return TestProjectScenario::InitResult::Initialized;
+	}
+
+	const AXThreadedTasks* tasks( AXThreadedTasks::GetFrom( AXApplication::Get( ) ) );
+	const AXContent* content( AXContent::GetFrom( AXApplication::Get( ) ) );
+
+	if( !tasks || !content )
+	{
+		AXERROR( "Scenario", "The scenario needs the threaded tasks and content systems" );
+		return TestProjectScenario::InitResult::Failed;
+	}
+
+	if( tasks->GetState( ) != AXSystemBase::State::Initialized || content->GetState( ) != AXSystemBase::State::Initialized )
+	{
+		return TestProjectScenario::InitResult::Retry;
+	}
+
+	for( uint32_t i( 0 ); i < mSettings->mNumUpdateables; ++i )
+	{
+		mMovers.emplace_back( new Mover( ) );
+	}
+
+	AXLOG( "Scenario", "Running test scenario" );
+
+	return TestProjectScenario::InitResult::Initialized;
+}
+
+/**
+* Called once a frame to allow systems to update
+*/
+void TestProjectScenario::Update( float dt )
+{
+	if( !mEnabled )
+	{
+		return;
+	}
+
+	AXThreadedTasks* tasks( AXThreadedTasks::GetFrom( AXApplication::Get( ) ) );
+
+	if( !mStarted )
+	{
+		mStarted = true;
+
+		SubmitContentLoads( AXContent::GetFrom( AXApplication::Get( ) )->GetSettings( ).mContentRootDirectory.Val( ) );
+		SubmitComputeTasks( );
+
+		AXLOG( "Scenario", "Submitted %u tasks", mNumTasksSubmitted );
+	}
+
+	// The main thread helps out so the scenario finishes even without dedicated task threads
+	tasks->RunNextAvailableTask( );
+
+	if( mNumTasksCompleted >= mNumTasksSubmitted && AXApplication::Get( ).GetFrameCount( ) + 1 >= mSettings->mMinFrames.Val( ) )
+	{
+		AXLOG( "Scenario", "Test scenario complete, %u tasks run", mNumTasksCompleted.load( ) );
+
+		mEnabled = false;
+		AXApplication::Get( ).Quit( );
+	}
+}
+
+/**
+* Shutdown the system
+*/
+void TestProjectScenario::OnShutdown( )
+{
+	// Queued tasks point back at this system, wait for any still running
+	if( AXThreadedTasks* tasks = AXThreadedTasks::GetFrom( AXApplication::Get( ) ) )
+	{
+		while( mNumTasksCompleted < mNumTasksSubmitted )
+		{
+			tasks->RunNextAvailableTask( );
+		}
+	}
+
+	mMovers.clear( );
+}
+
+/**
+* Override to register a settings object for this system
+*/
+void TestProjectScenario::CreateEngineSettings( class AXSettingsFile& settings )
+{
+	mSettings = settings.RegisterNewItem< TestProjectScenario::Settings >( TestProjectScenario::StaticName( ).GetString( ) );
+}
+
+/**
+* Submits a task reading every file under path, recursing into directories
+*/
+void TestProjectScenario::SubmitContentLoads( const AXString& path )
+{
+	AXDirectory directory;
+
+	if( !directory.Open( path ) )
+	{
+		AXWARN( "Scenario", "Failed to open content directory %s", path.c_str( ) );
+		return;
+	}
+
+	AXThreadedTasks* tasks( AXThreadedTasks::GetFrom( AXApplication::Get( ) ) );
+	const AXContent* content( AXContent::GetFrom( AXApplication::Get( ) ) );
+
+	for( const AXDirectory::Item& item : directory.GetContents( ) )
+	{
+		const AXString itemPath( path + "/" + item.mName );
+
+		if( item.mType == AXDirectory::Item::Type::Directory )
+		{
+			SubmitContentLoads( itemPath );
+			continue;
+		}
+
+		const bool hasManager( content->FindContentManagerByExtension( AXFile::GetExtention( itemPath ) ) != nullptr );
+
+		AXTask::Params params;
+		params.mCallback = [ this, itemPath, hasManager ]( AXTask::TaskUserData* userData )
+		{
+			AXPROFILE_SCOPE( "Scenario Content Load" );
+
+			AXPlatformFile file;
+
+			if( file.OpenFile( itemPath, AXFile::FileOpenMode::Read, AXFile::DataMode::Binary ) && file.ReadFileToInternalBuffer( ) )
+			{
+				if( hasManager )
+				{
+					AXPERF_COUNT( "Scenario/Assets Loaded", 1 );
+				}
+				else
+				{
+					AXPERF_COUNT( "Scenario/Files Loaded", 1 );
+				}
+			}
+			else
+			{
+				AXWARN( "Scenario", "Failed to load %s", itemPath.c_str( ) );
+			}
+
+			mNumTasksCompleted.fetch_add( 1 );
+			return AXTask::TaskResult( );
+		};
+
+		tasks->RequestTaskRun( params );
+		++mNumTasksSubmitted;
+	}
+}
+
+/**
+* Submits the compute tasks
+*/
+void TestProjectScenario::SubmitComputeTasks( )
+{
+	AXThreadedTasks* tasks( AXThreadedTasks::GetFrom( AXApplication::Get( ) ) );
+
+	mComputeResults.assign( mSettings->mNumComputeTasks, 0.0f );
+
+	for( uint32_t i( 0 ); i < mSettings->mNumComputeTasks; ++i )
+	{
+		AXTask::Params params;
+		params.mCallback = [ this, i ]( AXTask::TaskUserData* userData )
+		{
+			AXPROFILE_SCOPE_COUNTERS( "Scenario Compute" );
+
+			float sum( 0.0f );
+
+			for( uint32_t step( 0 ); step < 10000; ++step )
+			{
+				sum += sinf( ( float )( i + step ) * 0.001f );
+			}
+
+			mComputeResults[i] = sum;
+
+			AXPERF_COUNT( "Scenario/Compute Tasks", 1 );
+
+			mNumTasksCompleted.fetch_add( 1 );
+			return AXTask::TaskResult( );
+		};
+
+		tasks->RequestTaskRun( params );
+		++mNumTasksSubmitted;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,128 @@
+// Copyright 2016 Scott Bevin, All Rights Reserved
+
+#pragma once
+
+#include "AX/Core/AXSystem.h"
+#include "AX/Core/AXSettings.h"
+#include "AX/Core/AXUpdateables.h"
+#include "AX/Utils/AXParent.h"
+#include "AX/Utils/AXString.h"
+#include "AX/Utils/AXThreadingPrimitives.h"
+
+#include <memory>
+#include <vector>
+
+/**
+ * A scripted run for headless performance tests, enabled with -scenario. Reads everything under the content root on task
+ * threads, runs a batch of compute tasks and keeps a set of updateables ticking, then quits once every task has finished
+ */
+class TestProjectScenario : public AXParent< AXSystem< TestProjectScenario >, TestProjectScenario >
+{
+public:
+	class Settings : public AXSettingsFile::SettingsItem
+	{
+	public:
+		/**
+		* Constructor
+		*/
+		Settings( )
+		{
+			RegisterProperty( mNumComputeTasks, "Compute Tasks" );
+			RegisterProperty( mNumUpdateables, "Updateables" );
+			RegisterProperty( mMinFrames, "Min Frames" );
+		}
+
+	public:
+		/**
+		 * The number of compute tasks submitted on the first frame
+		 */
+		AXProperty< uint32_t > mNumComputeTasks = 256;
+
+		/**
+		 * The number of updateables ticked every frame
+		 */
+		AXProperty< uint32_t > mNumUpdateables = 64;
+
+		/**
+		 * The scenario runs for at least this many frames, even if the tasks finish sooner
+		 */
+		AXProperty< uint32_t > mMinFrames = 60;
+	};
+
+public:
+	/**
+	 * Override to handle command line arguments, gets called after create settings
+	 */
+	virtual void HandleCommandLine( const std::vector< AXString >& args ) override;
+
+	/**
+	* Initialise the system, called after settings are loaded
+	*/
+	virtual InitResult OnInitialize( ) override;
+
+	/**
+	* Called once a frame to allow systems to update
+	*/
+	virtual void Update( float dt ) override;
+
+	/**
+	* Shutdown the system
+	*/
+	virtual void OnShutdown( ) override;
+
+protected:
+	/**
+	* Override to register a settings object for this system
+	*/
+	virtual void CreateEngineSettings( class AXSettingsFile& settings ) override;
+
+private:
+	/**
+	 * Moves along a little every update, standing in for game objects
+	 */
+	class Mover : public AXIUpdateable
+	{
+	public:
+		virtual void Update( float dt ) override;
+
+	private:
+		float mPosition = 0.0f;
+		float mVelocity = 1.0f;
+	};
+
+	/**
+	 * Submits a task reading every file under path, recursing into directories
+	 */
+	void SubmitContentLoads( const AXString& path );
+
+	/**
+	 * Submits the compute tasks
+	 */
+	void SubmitComputeTasks( );
+
+private:
+	/**
+	* Pointer to the created settings object
+	*/
+	Settings* mSettings = nullptr;
+
+	/**
+	 * True if -scenario was passed
+	 */
+	bool mEnabled = false;
+
+	/**
+	 * True once the first frame has submitted the tasks
+	 */
+	bool mStarted = false;
+
+	uint32_t mNumTasksSubmitted = 0;
+	AXAtomic< uint32_t > mNumTasksCompleted = 0;
+
+	/**
+	 * Where each compute task writes its result
+	 */
+	std::vector< float > mComputeResults;
+
+	std::vector< std::unique_ptr< Mover > > mMovers;
+};
\ No newline at end of file
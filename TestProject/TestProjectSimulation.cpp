@@ -0,0 +1,99 @@
+// Copyright 2016 Scott Bevin, All Rights Reserved
+
+#include "TestProjectSimulation.h"
+
+#include "AX/Core/AXLogging.h"
+#include "AX/Core/AXPerfCounters.h"
+
+#include <math.h>
+
+template<> AXName AXSystem< TestProjectSimulation >::sSystemName = "Scenario Simulation";
+
+/**
+* Constructor
+*/
+TestProjectSimulation::TestProjectSimulation( )
+{
+	DeclareThreadSafe( );
+}
+
+/**
+* Override to handle command line arguments, gets called after create settings
+*/
+void TestProjectSimulation::HandleCommandLine( const std::vector< AXString >& args )
+{
+	for( const AXString& arg : args )
+	{
+		if( arg == "-scenario" )
+		{
+			mEnabled = true;
+		}
+	}
+}
+
+/**
+* Initialise the system, called after settings are loaded
+*/
+TestProjectSimulation::InitResult TestProjectSimulation::OnInitialize( )
+{
+	if( !mEnabled )
+	{
+		return TestProjectSimulation::InitResult::Initialized;
+	}
+
+	mParticles.resize( mSettings->mNumParticles );
+
+	for( uint32_t i( 0 ); i < mParticles.size( ); ++i )
+	{
+		Particle& particle( mParticles[i] );
+
+		particle.mPosition[0] = sinf( ( float )i );
+		particle.mPosition[1] = cosf( ( float )i );
+		particle.mPosition[2] = 0.0f;
+		particle.mVelocity[0] = 0.0f;
+		particle.mVelocity[1] = 0.0f;
+		particle.mVelocity[2] = 1.0f;
+	}
+
+	AXLOG( "Scenario", "Simulating %u particles", ( uint32_t )mParticles.size( ) );
+
+	return TestProjectSimulation::InitResult::Initialized;
+}
+
+/**
+* Called once a frame to allow systems to update
+*/
+void TestProjectSimulation::Update( float dt )
+{
+	if( !mEnabled )
+	{
+		return;
+	}
+
+	for( Particle& particle : mParticles )
+	{
+		for( uint32_t axis( 0 ); axis < 3; ++axis )
+		{
+			particle.mVelocity[axis] -= particle.mPosition[axis] * dt;
+			particle.mPosition[axis] += particle.mVelocity[axis] * dt;
+		}
+	}
+
+	AXPERF_COUNT( "Scenario/Particles Integrated", mParticles.size( ) );
+}
+
+/**
+* Shutdown the system
+*/
+void TestProjectSimulation::OnShutdown( )
+{
+	mParticles.clear( );
+}
+
+/**
+* Override to register a settings object for this system
+*/
+void TestProjectSimulation::CreateEngineSettings( class AXSettingsFile& settings )
+{
+	mSettings = settings.RegisterNewItem< TestProjectSimulation::Settings >( TestProjectSimulation::StaticName( ).GetString( ) );
+}
\ No newline at end of file
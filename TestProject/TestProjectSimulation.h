@@ -0,0 +1,88 @@
+// Copyright 2016 Scott Bevin, All Rights Reserved
+
+#pragma once
+
+#include "AX/Core/AXSystem.h"
+#include "AX/Core/AXSettings.h"
+#include "AX/Utils/AXParent.h"
+#include "AX/Utils/AXString.h"
+
+#include <vector>
+
+/**
+ * Integrates a block of particles every update during the scenario, enabled with -scenario. Only touches its own data so it
+ * declares itself thread safe and runs on a task thread alongside the main thread systems
+ */
+class TestProjectSimulation : public AXParent< AXSystem< TestProjectSimulation >, TestProjectSimulation >
+{
+public:
+	class Settings : public AXSettingsFile::SettingsItem
+	{
+	public:
+		/**
+		* Constructor
+		*/
+		Settings( )
+		{
+			RegisterProperty( mNumParticles, "Particles" );
+		}
+
+	public:
+		/**
+		 * The number of particles integrated every update
+		 */
+		AXProperty< uint32_t > mNumParticles = 65536;
+	};
+
+public:
+	/**
+	* Constructor
+	*/
+	TestProjectSimulation( );
+
+	/**
+	 * Override to handle command line arguments, gets called after create settings
+	 */
+	virtual void HandleCommandLine( const std::vector< AXString >& args ) override;
+
+	/**
+	* Initialise the system, called after settings are loaded
+	*/
+	virtual InitResult OnInitialize( ) override;
+
+	/**
+	* Called once a frame to allow systems to update
+	*/
+	virtual void Update( float dt ) override;
+
+	/**
+	* Shutdown the system
+	*/
+	virtual void OnShutdown( ) override;
+
+protected:
+	/**
+	* Override to register a settings object for this system
+	*/
+	virtual void CreateEngineSettings( class AXSettingsFile& settings ) override;
+
+private:
+	struct Particle
+	{
+		float mPosition[3];
+		float mVelocity[3];
+	};
+
+private:
+	/**
+	* Pointer to the created settings object
+	*/
+	Settings* mSettings = nullptr;
+
+	/**
+	 * True if -scenario was passed
+	 */
+	bool mEnabled = false;
+
+	std::vector< Particle > mParticles;
+};
\ No newline at end of file
@@ -0,0 +1,174 @@
+// Copyright 2016 Scott Bevin, All Rights Reserved
+
+#include "AX/Core/AXBinaryLog.h"
+
+#include <stdio.h>
+#include <stdint.h>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * Decodes a binary log written by AXLogListener_BinaryFile to text in the same layout as the console listener
+ *
+ * Usage: AXLogDecoder <log file> [output file]
+ */
+
+namespace
+{
+	const char* sLogLevelNames[] = { "Info", "Warning", "Error" };
+
+	class Reader
+	{
+	public:
+		Reader( FILE* file ) : mFile( file ) { }
+
+		template< class T >
+		bool Read( T& outVal ) { return fread( &outVal, sizeof( T ), 1, mFile ) == 1; }
+
+		bool ReadBytes( std::vector< uint8_t >& outBytes, uint32_t size )
+		{
+			outBytes.resize( size );
+			return size == 0 || fread( outBytes.data( ), 1, size, mFile ) == size;
+		}
+
+		bool ReadString( AXString& outStr, uint32_t size )
+		{
+			outStr.resize( size );
+			return size == 0 || fread( &outStr[0], 1, size, mFile ) == size;
+		}
+
+	private:
+		FILE* mFile;
+	};
+
+	const char* LevelName( uint8_t level )
+	{
+		return level < sizeof( sLogLevelNames ) / sizeof( sLogLevelNames[0] ) ? sLogLevelNames[level] : "Unknown";
+	}
+}
+
+int main( int argc, char** argv )
+{
+	if( argc < 2 )
+	{
+		fprintf( stderr, "Usage: %s <log file> [output file]\n", argv[0] );
+		return 1;
+	}
+
+	FILE* in( fopen( argv[1], "rb" ) );
+
+	if( !in )
+	{
+		fprintf( stderr, "Unable to open %s\n", argv[1] );
+		return 1;
+	}
+
+	FILE* out( argc > 2 ? fopen( argv[2], "w" ) : stdout );
+
+	if( !out )
+	{
+		fprintf( stderr, "Unable to open %s\n", argv[2] );
+		fclose( in );
+		return 1;
+	}
+
+	Reader reader( in );
+
+	uint32_t magic( 0 );
+	uint32_t version( 0 );
+
+	if( !reader.Read( magic ) || !reader.Read( version ) || magic != AXBINARYLOG_FILE_MAGIC )
+	{
+		fprintf( stderr, "%s is not a binary log\n", argv[1] );
+		fclose( in );
+		return 1;
+	}
+
+	if( version != AXBINARYLOG_FILE_VERSION )
+	{
+		fprintf( stderr, "%s is version %u, expected version %u\n", argv[1], version, AXBINARYLOG_FILE_VERSION );
+		fclose( in );
+		return 1;
+	}
+
+	std::unordered_map< uint64_t, AXString > strings;
+	std::vector< uint8_t > args;
+	AXString message;
+
+	auto lookup = [ &strings ]( uint64_t id ) -> const char*
+	{
+		auto it( strings.find( id ) );
+		return it != strings.end( ) ? it->second.c_str( ) : "?";
+	};
+
+	uint32_t numRecords( 0 );
+	bool truncated( false );
+	AXBinaryLog::RecordType type;
+
+	while( reader.Read( type ) )
+	{
+		uint8_t level( 0 );
+		uint64_t tagId( 0 );
+		uint64_t fileId( 0 );
+		int32_t line( 0 );
+		uint32_t size( 0 );
+
+		if( type == AXBinaryLog::RecordType::String )
+		{
+			uint64_t id( 0 );
+
+			if( !reader.Read( id ) || !reader.Read( size ) || !reader.ReadString( strings[id], size ) )
+			{
+				truncated = true;
+				break;
+			}
+
+			continue;
+		}
+		else if( type == AXBinaryLog::RecordType::Deferred )
+		{
+			uint64_t formatId( 0 );
+
+			if( !reader.Read( level ) || !reader.Read( tagId ) || !reader.Read( formatId ) || !reader.Read( fileId ) ||
+				!reader.Read( line ) || !reader.Read( size ) || !reader.ReadBytes( args, size ) )
+			{
+				truncated = true;
+				break;
+			}
+
+			AXBinaryLog::FormatMessage( lookup( formatId ), args.data( ), args.size( ), message );
+		}
+		else if( type == AXBinaryLog::RecordType::Formatted )
+		{
+			if( !reader.Read( level ) || !reader.Read( tagId ) || !reader.Read( fileId ) ||
+				!reader.Read( line ) || !reader.Read( size ) || !reader.ReadString( message, size ) )
+			{
+				truncated = true;
+				break;
+			}
+		}
+		else
+		{
+			fprintf( stderr, "Unknown record type %u after %u records\n", ( uint32_t )type, numRecords );
+			truncated = true;
+			break;
+		}
+
+		fprintf( out, "[%-8s] [%-16s] %s (%s : %d) \n", LevelName( level ), lookup( tagId ), message.c_str( ), lookup( fileId ), line );
+		++numRecords;
+	}
+
+	if( truncated )
+	{
+		fprintf( stderr, "Log is truncated after %u records\n", numRecords );
+	}
+
+	if( out != stdout )
+	{
+		fclose( out );
+	}
+
+	fclose( in );
+
+	return 0;
+}
\ No newline at end of file